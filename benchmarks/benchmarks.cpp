@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "benchmarks.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+
+double
+BenchmarkResult::min() const
+{
+    return *std::min_element(seconds.begin(), seconds.end());
+}
+
+double
+BenchmarkResult::median() const
+{
+    std::vector<double> sorted = seconds;
+    std::sort(sorted.begin(), sorted.end());
+    size_t const middle = sorted.size() / 2;
+    return sorted.size() % 2 ? sorted[middle]
+                             : (sorted[middle - 1] + sorted[middle]) / 2;
+}
+
+double
+BenchmarkResult::mean() const
+{
+    return std::accumulate(seconds.begin(), seconds.end(), 0.0)
+           / seconds.size();
+}
+
+double
+BenchmarkResult::max() const
+{
+    return *std::max_element(seconds.begin(), seconds.end());
+}
+
+void
+Benchmarks::add_benchmark(
+    std::string const&           name,
+    std::function<void()> const& run,
+    std::function<void()> const& setup)
+{
+    _benchmarks.push_back({ name, run, setup });
+}
+
+std::vector<std::string>
+Benchmarks::names() const
+{
+    std::vector<std::string> result;
+    for (auto const& benchmark: _benchmarks)
+    {
+        result.push_back(benchmark.name);
+    }
+    return result;
+}
+
+std::vector<BenchmarkResult>
+Benchmarks::run(int repetitions, std::vector<std::string> const& filter)
+    const
+{
+    std::vector<BenchmarkResult> results;
+    for (auto const& benchmark: _benchmarks)
+    {
+        if (!filter.empty()
+            && std::find(filter.begin(), filter.end(), benchmark.name)
+                   == filter.end())
+        {
+            continue;
+        }
+
+        std::cerr << "Running benchmark " << benchmark.name << std::endl;
+        BenchmarkResult result{ benchmark.name, {} };
+        for (int i = -1; i < repetitions; ++i)
+        {
+            if (benchmark.setup)
+            {
+                benchmark.setup();
+            }
+
+            auto const begin = std::chrono::steady_clock::now();
+            benchmark.run();
+            std::chrono::duration<double> const elapsed =
+                std::chrono::steady_clock::now() - begin;
+
+            // the first run only warms up
+            if (i >= 0)
+            {
+                result.seconds.push_back(elapsed.count());
+            }
+        }
+        results.push_back(std::move(result));
+    }
+    return results;
+}
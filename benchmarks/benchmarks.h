@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// The timings of one benchmark, one per repetition, in seconds.
+struct BenchmarkResult
+{
+    std::string         name;
+    std::vector<double> seconds;
+
+    double min() const;
+    double median() const;
+    double mean() const;
+    double max() const;
+};
+
+// A list of named benchmarks, run in the order they were added, the way
+// Tests in tests/utils.h runs tests.
+class Benchmarks
+{
+public:
+    // Add a benchmark that times run().  If setup is given, it is called
+    // before each call to run(), and is not timed.
+    void add_benchmark(
+        std::string const&           name,
+        std::function<void()> const& run,
+        std::function<void()> const& setup = nullptr);
+
+    std::vector<std::string> names() const;
+
+    // Run each benchmark named in filter (all of them if filter is empty)
+    // once to warm up, and then repetitions times.
+    std::vector<BenchmarkResult> run(
+        int                             repetitions,
+        std::vector<std::string> const& filter = {}) const;
+
+private:
+    struct Benchmark
+    {
+        std::string           name;
+        std::function<void()> run;
+        std::function<void()> setup;
+    };
+
+    std::vector<Benchmark> _benchmarks;
+};
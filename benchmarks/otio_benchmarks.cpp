@@ -0,0 +1,399 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// otio_benchmarks times the core operations of the C++ library on a
+// synthetic timeline of a given shape, and reports the timings as a table
+// and, optionally, as JSON that can be kept and compared across releases.
+
+#include "benchmarks.h"
+#include "syntheticTimeline.h"
+
+#include <opentimelineio/algo/editAlgorithm.h>
+#include <opentimelineio/clip.h>
+#include <opentimelineio/externalReference.h>
+#include <opentimelineio/serialization.h>
+#include <opentimelineio/stackAlgorithm.h>
+#include <opentimelineio/track.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
+
+namespace {
+
+// How many probes, conversions or edits a run of a benchmark makes.
+int const probe_count = 1000;
+int const edit_count  = 50;
+
+const char* const usage = R"(usage: otio_benchmarks [options] [BENCHMARK ...]
+
+Time core OpenTimelineIO operations on a synthetic timeline. With no
+BENCHMARK names, all of them are run.
+
+Timeline shape:
+  --tracks N             Number of tracks (default: 4)
+  --clips-per-track N    Number of clips in each track (default: 500)
+  --depth N              Levels of stacks nested in tracks (default: 1)
+  --metadata N           Metadata entries per object (default: 16)
+Running:
+  --repetitions N        Timed runs of each benchmark, at least 1
+                         (default: 5)
+  --json PATH            Also write the results as JSON to PATH; use '-'
+                         for standard output
+  --list                 List the benchmarks and exit
+)";
+
+struct Options
+{
+    SyntheticTimelineShape   shape;
+    int                      repetitions = 5;
+    std::string              json;
+    bool                     list = false;
+    std::vector<std::string> benchmarks;
+};
+
+bool
+parse_arguments(int argc, char* argv[], Options& options, std::string& error)
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (size_t i = 0; i < args.size(); ++i)
+    {
+        std::string const& arg = args[i];
+
+        auto value = [&](int* count, int minimum = 0) {
+            char* end = nullptr;
+            if (i + 1 < args.size())
+            {
+                *count = int(std::strtol(args[++i].c_str(), &end, 10));
+            }
+            if (!end || *end || *count < minimum)
+            {
+                error = "expected a count of at least "
+                        + std::to_string(minimum) + " for " + arg;
+                return false;
+            }
+            return true;
+        };
+
+        if (arg == "--tracks")
+        {
+            if (!value(&options.shape.tracks))
+            {
+                return false;
+            }
+        }
+        else if (arg == "--clips-per-track")
+        {
+            if (!value(&options.shape.clips_per_track))
+            {
+                return false;
+            }
+        }
+        else if (arg == "--depth")
+        {
+            if (!value(&options.shape.nesting_depth))
+            {
+                return false;
+            }
+        }
+        else if (arg == "--metadata")
+        {
+            if (!value(&options.shape.metadata_entries))
+            {
+                return false;
+            }
+        }
+        else if (arg == "--repetitions")
+        {
+            // the statistics of a result need at least one timing
+            if (!value(&options.repetitions, 1))
+            {
+                return false;
+            }
+        }
+        else if (arg == "--json")
+        {
+            if (i + 1 == args.size())
+            {
+                error = "expected a path for --json";
+                return false;
+            }
+            options.json = args[++i];
+        }
+        else if (arg == "--list")
+        {
+            options.list = true;
+        }
+        else if (arg == "-h" || arg == "--help" || arg[0] == '-')
+        {
+            error = arg == "-h" || arg == "--help" ? ""
+                                                   : "unknown option " + arg;
+            return false;
+        }
+        else
+        {
+            options.benchmarks.push_back(arg);
+        }
+    }
+
+    if (options.repetitions < 1 || options.shape.tracks < 1
+        || options.shape.clips_per_track < 1)
+    {
+        error = "--repetitions, --tracks and --clips-per-track must be at "
+                "least 1";
+        return false;
+    }
+    return true;
+}
+
+// Every benchmark works on one timeline, built once; the state it needs
+// besides is built once too, or, for those that change it, by their setup.
+struct State
+{
+    otio::SerializableObject::Retainer<otio::Timeline> timeline;
+    otio::SerializableObject::Retainer<otio::Timeline> copy;
+    std::string                                        json;
+    std::vector<otio::SerializableObject::Retainer<otio::Clip>> clips;
+    otio::SerializableObject::Retainer<otio::Track>             edit_track;
+};
+
+void
+add_benchmarks(Benchmarks& benchmarks, State& state)
+{
+    benchmarks.add_benchmark("deserialize", [&state] {
+        otio::SerializableObject::Retainer<> result(
+            otio::SerializableObject::from_json_string(state.json));
+    });
+
+    benchmarks.add_benchmark("serialize", [&state] {
+        state.timeline->to_json_string();
+    });
+
+    benchmarks.add_benchmark("clone", [&state] {
+        otio::SerializableObject::Retainer<> result(state.timeline->clone());
+    });
+
+    benchmarks.add_benchmark("is_equivalent_to", [&state] {
+        if (!state.timeline->is_equivalent_to(*state.copy))
+        {
+            std::cerr << "the clone of the timeline is not equivalent to it"
+                      << std::endl;
+            std::exit(1);
+        }
+    });
+
+    benchmarks.add_benchmark("range_of_all_children", [&state] {
+        state.timeline->tracks()->range_of_all_children();
+        for (auto const& child: state.timeline->tracks()->children())
+        {
+            if (auto track = otio::fast_cast<otio::Track>(child.value))
+            {
+                track->range_of_all_children();
+            }
+        }
+    });
+
+    benchmarks.add_benchmark("child_at_time", [&state] {
+        otio::Stack* stack    = state.timeline->tracks();
+        double const duration = stack->duration().value();
+        double const rate     = stack->duration().rate();
+        for (int i = 0; i < probe_count; ++i)
+        {
+            stack->child_at_time(
+                otio::RationalTime(duration * i / probe_count, rate));
+        }
+    });
+
+    benchmarks.add_benchmark("find_children", [&state] {
+        state.timeline->find_clips();
+    });
+
+    benchmarks.add_benchmark("flatten_stack", [&state] {
+        otio::SerializableObject::Retainer<otio::Track> result(
+            otio::flatten_stack(state.timeline->tracks()));
+    });
+
+    benchmarks.add_benchmark("transformed_time", [&state] {
+        otio::Stack* stack = state.timeline->tracks();
+        for (auto const& clip: state.clips)
+        {
+            clip->transformed_time(clip->trimmed_range().start_time(), stack);
+        }
+    });
+
+    benchmarks.add_benchmark(
+        "edit_algorithms",
+        [&state] {
+            otio::Track* track    = state.edit_track;
+            double const duration = track->duration().value();
+            double const rate     = track->duration().rate();
+            for (int i = 0; i < edit_count; ++i)
+            {
+                otio::RationalTime const time(duration * i / edit_count, rate);
+                otio::TimeRange const range(time, otio::RationalTime(6, rate));
+                otio::algo::overwrite(
+                    new otio::Clip("overwrite", nullptr, range),
+                    track,
+                    range);
+                otio::algo::insert(
+                    new otio::Clip("insert", nullptr, range),
+                    track,
+                    time + otio::RationalTime(3, rate));
+                otio::algo::slice(track, time + otio::RationalTime(1, rate));
+            }
+        },
+        [&state] {
+            auto first = state.timeline->tracks()->children().front();
+            state.edit_track =
+                dynamic_cast<otio::Track*>(first.value->clone());
+        });
+
+    benchmarks.add_benchmark("timecode", [] {
+        for (double rate: { 24.0, 30000.0 / 1001 })
+        {
+            for (int i = 0; i < probe_count; ++i)
+            {
+                otio::RationalTime const time(i * 997, rate);
+                std::string const timecode = time.to_timecode();
+                otio::RationalTime::from_timecode(timecode, rate);
+            }
+        }
+    });
+}
+
+// The results as JSON, in a form meant to be kept and compared.
+std::string
+results_json(
+    Options const&                      options,
+    std::vector<BenchmarkResult> const& results)
+{
+    otio::AnyDictionary shape;
+    shape["tracks"]           = int64_t(options.shape.tracks);
+    shape["clips_per_track"]  = int64_t(options.shape.clips_per_track);
+    shape["nesting_depth"]    = int64_t(options.shape.nesting_depth);
+    shape["metadata_entries"] = int64_t(options.shape.metadata_entries);
+
+    otio::AnyVector benchmarks;
+    for (auto const& result: results)
+    {
+        otio::AnyVector seconds;
+        for (double s: result.seconds)
+        {
+            seconds.push_back(s);
+        }
+
+        otio::AnyDictionary benchmark;
+        benchmark["name"]    = result.name;
+        benchmark["seconds"] = std::move(seconds);
+        benchmark["min"]     = result.min();
+        benchmark["median"]  = result.median();
+        benchmark["mean"]    = result.mean();
+        benchmark["max"]     = result.max();
+        benchmarks.push_back(std::move(benchmark));
+    }
+
+    otio::AnyDictionary root;
+    root["otio_version"] = std::string(OTIO_BENCHMARKS_OTIO_VERSION);
+    root["time"]         = int64_t(std::time(nullptr));
+    root["shape"]        = std::move(shape);
+    root["repetitions"]  = int64_t(options.repetitions);
+    root["benchmarks"]   = std::move(benchmarks);
+    return otio::serialize_json_to_string(std::any(std::move(root)));
+}
+
+void
+print_results(std::vector<BenchmarkResult> const& results)
+{
+    std::printf(
+        "%-24s %12s %12s %12s\n",
+        "benchmark",
+        "min [s]",
+        "median [s]",
+        "max [s]");
+    for (auto const& result: results)
+    {
+        std::printf(
+            "%-24s %12.6f %12.6f %12.6f\n",
+            result.name.c_str(),
+            result.min(),
+            result.median(),
+            result.max());
+    }
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    Options     options;
+    std::string error;
+    if (!parse_arguments(argc, argv, options, error))
+    {
+        if (!error.empty())
+        {
+            std::cerr << "otio_benchmarks: " << error << std::endl;
+        }
+        std::cerr << usage;
+        return error.empty() ? 0 : 2;
+    }
+
+    State      state;
+    Benchmarks benchmarks;
+    add_benchmarks(benchmarks, state);
+
+    if (options.list)
+    {
+        for (auto const& name: benchmarks.names())
+        {
+            std::cout << name << std::endl;
+        }
+        return 0;
+    }
+
+    for (auto const& name: options.benchmarks)
+    {
+        auto const names = benchmarks.names();
+        if (std::find(names.begin(), names.end(), name) == names.end())
+        {
+            std::cerr << "otio_benchmarks: no benchmark named " << name
+                      << std::endl;
+            return 2;
+        }
+    }
+
+    state.timeline = make_synthetic_timeline(options.shape);
+    state.copy = dynamic_cast<otio::Timeline*>(state.timeline->clone());
+    state.json = state.timeline->to_json_string();
+    state.clips = state.timeline->find_clips();
+
+    std::vector<BenchmarkResult> const results =
+        benchmarks.run(options.repetitions, options.benchmarks);
+    if (options.json != "-")
+    {
+        print_results(results);
+    }
+
+    if (!options.json.empty())
+    {
+        std::string const json = results_json(options, results);
+        if (options.json == "-")
+        {
+            std::cout << json << std::endl;
+        }
+        else if (!(std::ofstream(options.json) << json << std::endl))
+        {
+            std::cerr << "otio_benchmarks: cannot write " << options.json
+                      << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
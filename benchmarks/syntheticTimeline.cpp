@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "syntheticTimeline.h"
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/externalReference.h>
+#include <opentimelineio/gap.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/track.h>
+
+#include <algorithm>
+#include <string>
+
+namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
+
+namespace {
+
+double const rate = 24;
+
+// How often a track holds a gap, and a nested stack.
+int const gap_interval  = 10;
+int const nest_interval = 20;
+int const nested_tracks = 2;
+
+otio::AnyDictionary
+make_metadata(int entries, int index)
+{
+    otio::AnyDictionary metadata;
+    for (int i = 0; i < entries; ++i)
+    {
+        std::string const key = "field_" + std::to_string(i);
+        switch (i % 4)
+        {
+            case 0:
+                metadata[key] = "value " + std::to_string(index + i);
+                break;
+            case 1:
+                metadata[key] = int64_t(index) * i;
+                break;
+            case 2:
+                metadata[key] = index * 0.5 + i;
+                break;
+            default: {
+                otio::AnyDictionary nested;
+                nested["id"]      = int64_t(index);
+                nested["enabled"] = (index + i) % 2 == 0;
+                nested["label"]   = "vendor " + std::to_string(i);
+                metadata[key]     = std::move(nested);
+                break;
+            }
+        }
+    }
+    return metadata;
+}
+
+otio::Clip*
+make_clip(std::string const& name, int index, int metadata_entries)
+{
+    int const frames = 24 + (index * 7) % 48;
+
+    otio::TimeRange const available_range(
+        otio::RationalTime(0, rate),
+        otio::RationalTime(frames + 48, rate));
+    otio::TimeRange const source_range(
+        otio::RationalTime(12, rate),
+        otio::RationalTime(frames, rate));
+
+    auto reference = new otio::ExternalReference(
+        "file:///media/" + name + ".mov",
+        available_range);
+    return new otio::Clip(
+        name,
+        reference,
+        source_range,
+        make_metadata(metadata_entries, index));
+}
+
+otio::Stack* make_stack(
+    std::string const&            name,
+    SyntheticTimelineShape const& shape,
+    int                           tracks,
+    int                           clips_per_track,
+    int                           depth);
+
+otio::Track*
+make_track(
+    std::string const&            name,
+    SyntheticTimelineShape const& shape,
+    int                           clips_per_track,
+    int                           depth)
+{
+    auto track = new otio::Track(
+        name,
+        std::nullopt,
+        otio::Track::Kind::video,
+        make_metadata(shape.metadata_entries, 0));
+    for (int c = 0; c < clips_per_track; ++c)
+    {
+        std::string const child_name = name + "_" + std::to_string(c);
+        if (depth > 0 && c % nest_interval == nest_interval - 1)
+        {
+            track->append_child(make_stack(
+                child_name,
+                shape,
+                nested_tracks,
+                std::max(2, clips_per_track / nest_interval),
+                depth - 1));
+        }
+        else
+        {
+            track->append_child(
+                make_clip(child_name, c, shape.metadata_entries));
+        }
+
+        if (c % gap_interval == gap_interval - 1)
+        {
+            track->append_child(new otio::Gap(
+                otio::TimeRange(
+                    otio::RationalTime(0, rate),
+                    otio::RationalTime(12, rate)),
+                child_name + "_gap",
+                std::vector<otio::Effect*>(),
+                std::vector<otio::Marker*>(),
+                make_metadata(shape.metadata_entries, c)));
+        }
+    }
+    return track;
+}
+
+otio::Stack*
+make_stack(
+    std::string const&            name,
+    SyntheticTimelineShape const& shape,
+    int                           tracks,
+    int                           clips_per_track,
+    int                           depth)
+{
+    auto stack = new otio::Stack(name);
+    for (int t = 0; t < tracks; ++t)
+    {
+        stack->append_child(make_track(
+            name + "_V" + std::to_string(t + 1),
+            shape,
+            clips_per_track,
+            depth));
+    }
+    return stack;
+}
+
+} // namespace
+
+otio::Timeline*
+make_synthetic_timeline(SyntheticTimelineShape const& shape)
+{
+    auto timeline = new otio::Timeline(
+        "synthetic",
+        otio::RationalTime(86400 * rate, rate),
+        make_metadata(shape.metadata_entries, 0));
+    timeline->set_tracks(make_stack(
+        "tracks",
+        shape,
+        shape.tracks,
+        shape.clips_per_track,
+        shape.nesting_depth));
+    return timeline;
+}
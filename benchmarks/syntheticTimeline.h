@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <opentimelineio/timeline.h>
+
+// The size of a synthetic timeline.
+struct SyntheticTimelineShape
+{
+    int tracks           = 4;
+    int clips_per_track  = 500;
+    int nesting_depth    = 1;
+    int metadata_entries = 16;
+};
+
+// Build a timeline of shape.tracks video tracks, each holding
+// shape.clips_per_track clips of varying length with a gap after every
+// tenth.  Every clip, gap and track carries shape.metadata_entries entries
+// of metadata, every fourth of them a small nested dictionary.
+//
+// While shape.nesting_depth is above zero, every twentieth clip of a track
+// is replaced by a stack of two tracks built the same way, a twentieth the
+// length, one level less deep.
+//
+// The timeline is the same for the same shape, so results can be compared
+// between runs.
+opentimelineio::OPENTIMELINEIO_VERSION::Timeline*
+make_synthetic_timeline(SyntheticTimelineShape const& shape);
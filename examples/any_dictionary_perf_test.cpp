@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Counts the heap allocations made reading, cloning and writing a
+// metadata-heavy timeline, to compare the std::map storage of AnyDictionary
+// with the flat storage selected by OTIO_FLAT_ANY_DICTIONARY.
+//
+// Given a .otio file it measures that file; otherwise it builds a synthetic
+// timeline of clips that each carry a few dozen metadata entries, some of
+// them nested dictionaries, as metadata written by other tools often does.
+
+#include "util.h"
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/timeline.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
+
+using chrono_time_point = std::chrono::steady_clock::time_point;
+
+static std::atomic<size_t> allocation_count{ 0 };
+
+void*
+operator new(std::size_t size)
+{
+    ++allocation_count;
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+/// print the time and allocations since begin and start_count
+void
+print_measurement(
+        const std::string& message,
+        const chrono_time_point& begin,
+        size_t start_count
+)
+{
+    const size_t allocations = allocation_count - start_count;
+    const std::chrono::duration<float> dur =
+        std::chrono::steady_clock::now() - begin;
+
+    std::cout << message << ": " << dur.count() << " [s], ";
+    std::cout << allocations << " allocations" << std::endl;
+}
+
+/// metadata in the shape of a typical tool's: flat values plus a few
+/// nested dictionaries of its own
+otio::AnyDictionary
+make_metadata(int index)
+{
+    otio::AnyDictionary metadata;
+    for (int i = 0; i < 24; ++i)
+    {
+        metadata["field_" + std::to_string(i)] =
+            std::string("value ") + std::to_string(index + i);
+    }
+    for (const char* vendor: { "avid", "fcp", "resolve" })
+    {
+        otio::AnyDictionary nested;
+        nested["id"]      = int64_t(index);
+        nested["enabled"] = true;
+        nested["gain"]    = 0.5;
+        nested["label"]   = std::string(vendor) + " clip";
+        metadata[vendor]  = nested;
+    }
+    return metadata;
+}
+
+otio::Timeline*
+make_synthetic_timeline(int clip_count)
+{
+    const otio::TimeRange clip_range(
+        otio::RationalTime(0, 24),
+        otio::RationalTime(24, 24));
+
+    auto timeline = new otio::Timeline("synthetic");
+    auto track    = new otio::Track("V1");
+    for (int c = 0; c < clip_count; ++c)
+    {
+        track->append_child(new otio::Clip(
+            "clip_" + std::to_string(c),
+            nullptr,
+            clip_range,
+            make_metadata(c)));
+    }
+    timeline->tracks()->append_child(track);
+    return timeline;
+}
+
+int
+main(
+        int argc,
+        char *argv[]
+)
+{
+    if (argc > 1 && std::string(argv[1]) == "--help")
+    {
+        std::cerr << "usage: any_dictionary_perf_test [file.otio | clips]";
+        std::cerr << std::endl;
+        return 1;
+    }
+
+#ifdef OTIO_FLAT_ANY_DICTIONARY
+    std::cout << "AnyDictionary storage: flat" << std::endl;
+#else
+    std::cout << "AnyDictionary storage: std::map" << std::endl;
+#endif
+
+    otio::ErrorStatus err;
+    std::string       json;
+
+    const std::string argument = argc > 1 ? argv[1] : "10000";
+    if (argument.find_first_not_of("0123456789") == std::string::npos)
+    {
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_synthetic_timeline(std::atoi(argument.c_str()));
+        json = timeline->to_json_string(&err);
+    }
+    else
+    {
+        otio::SerializableObject::Retainer<> timeline =
+            otio::SerializableObject::from_json_file(argument, &err);
+        if (!otio::is_error(err))
+        {
+            json = timeline->to_json_string(&err);
+        }
+    }
+    if (otio::is_error(err))
+    {
+        examples::print_error(err);
+        return 1;
+    }
+    std::cout << json.size() << " bytes of JSON" << std::endl;
+
+    chrono_time_point begin = std::chrono::steady_clock::now();
+    size_t            start = allocation_count;
+    otio::SerializableObject::Retainer<> timeline =
+        otio::SerializableObject::from_json_string(json, &err);
+    print_measurement("from_json_string", begin, start);
+    if (otio::is_error(err))
+    {
+        examples::print_error(err);
+        return 1;
+    }
+
+    begin = std::chrono::steady_clock::now();
+    start = allocation_count;
+    otio::SerializableObject::Retainer<> clone = timeline->clone(&err);
+    print_measurement("clone", begin, start);
+
+    begin = std::chrono::steady_clock::now();
+    start = allocation_count;
+    const std::string output = timeline->to_json_string(&err);
+    print_measurement("to_json_string", begin, start);
+
+    if (otio::is_error(err) || output != json)
+    {
+        std::cerr << "the timeline did not round trip" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
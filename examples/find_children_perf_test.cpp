@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Compares searching a large timeline with Composition::find_children(),
+// with the visitor form Composition::visit_children(), and with
+// parallel_find_children().
+//
+// The synthetic timeline holds about a million objects: tracks of clips
+// and gaps, with a nested stack every so often.
+
+#include "util.h"
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/gap.h>
+#include <opentimelineio/parallelFind.h>
+#include <opentimelineio/threadPool.h>
+#include <opentimelineio/timeline.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
+
+using chrono_time_point = std::chrono::steady_clock::time_point;
+
+/// utility function for printing std::chrono elapsed time
+double
+print_elapsed_time(
+        const std::string& message,
+        const chrono_time_point& begin,
+        const chrono_time_point& end
+)
+{
+    const std::chrono::duration<float> dur = end - begin;
+
+    std::cout << message << ": " << dur.count() << " [s]" << std::endl;
+
+    return dur.count();
+}
+
+/// build a timeline of object_count composables spread over track_count
+/// tracks; every hundredth item is a stack holding a short track.
+otio::Timeline*
+make_synthetic_timeline(int track_count, int object_count)
+{
+    const otio::TimeRange clip_range(
+        otio::RationalTime(0, 24),
+        otio::RationalTime(24, 24));
+
+    auto timeline = new otio::Timeline("synthetic");
+    const int per_track = object_count / track_count;
+    for (int t = 0; t < track_count; ++t)
+    {
+        auto track = new otio::Track("V" + std::to_string(t + 1));
+        for (int c = 0; c < per_track; ++c)
+        {
+            if (c % 100 == 99)
+            {
+                auto stack = new otio::Stack("nested");
+                auto inner = new otio::Track("inner");
+                for (int i = 0; i < 8; ++i)
+                {
+                    inner->append_child(
+                        new otio::Clip("inner", nullptr, clip_range));
+                }
+                stack->append_child(inner);
+                track->append_child(stack);
+                c += 9;
+            }
+            else if (c % 10 == 5)
+            {
+                track->append_child(new otio::Gap(clip_range));
+            }
+            else
+            {
+                track->append_child(new otio::Clip(
+                    "clip_" + std::to_string(c),
+                    nullptr,
+                    clip_range));
+            }
+        }
+        timeline->tracks()->append_child(track);
+    }
+    return timeline;
+}
+
+int
+main(
+        int argc,
+        char *argv[]
+)
+{
+    if (argc > 1 && std::string(argv[1]) == "--help")
+    {
+        std::cerr << "usage: find_children_perf_test [objects] [tracks] ";
+        std::cerr << "[threads]" << std::endl;
+        return 1;
+    }
+
+    const int objects = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int tracks  = argc > 2 ? std::atoi(argv[2]) : 8;
+    const int threads = argc > 3 ? std::atoi(argv[3]) : 0;
+
+    otio::ErrorStatus err;
+
+    chrono_time_point begin = std::chrono::steady_clock::now();
+    otio::SerializableObject::Retainer<otio::Timeline> timeline =
+        make_synthetic_timeline(tracks, objects);
+    chrono_time_point end = std::chrono::steady_clock::now();
+    print_elapsed_time("build timeline", begin, end);
+
+    otio::Stack* root = timeline->tracks();
+    otio::ThreadPool pool(threads);
+    std::cout << pool.thread_count() << " threads" << std::endl;
+
+    begin = std::chrono::steady_clock::now();
+    auto serial = root->find_children<otio::Clip>(&err);
+    end = std::chrono::steady_clock::now();
+    const double serial_time = print_elapsed_time("find_children", begin, end);
+    if (otio::is_error(err))
+    {
+        examples::print_error(err);
+        return 1;
+    }
+    std::cout << "found " << serial.size() << " clips" << std::endl;
+
+    begin = std::chrono::steady_clock::now();
+    size_t visited = 0;
+    root->visit_children(
+        [&visited](otio::Composable* child) {
+            if (dynamic_cast<otio::Clip*>(child))
+            {
+                ++visited;
+            }
+            return true;
+        },
+        &err);
+    end = std::chrono::steady_clock::now();
+    print_elapsed_time("visit_children", begin, end);
+
+    begin = std::chrono::steady_clock::now();
+    auto parallel =
+        otio::parallel_find_children<otio::Clip>(root, &err, {}, &pool);
+    end = std::chrono::steady_clock::now();
+    const double parallel_time =
+        print_elapsed_time("parallel_find_children", begin, end);
+    if (otio::is_error(err))
+    {
+        examples::print_error(err);
+        return 1;
+    }
+
+    if (visited != serial.size() || parallel.size() != serial.size())
+    {
+        std::cerr << "searches found different numbers of clips" << std::endl;
+        return 1;
+    }
+    for (size_t i = 0; i < serial.size(); ++i)
+    {
+        if (parallel[i].value != serial[i].value)
+        {
+            std::cerr << "parallel_find_children result " << i;
+            std::cerr << " differs from find_children" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "speedup: " << serial_time / parallel_time << "x" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Compares flattening a batch of timelines one at a time with flatten_stack()
+// against flattening them all at once with flatten_stacks().
+//
+// Either loads a timeline from disk and flattens copies of it, or, if no
+// path is given, builds synthetic timelines with a few layered video tracks.
+
+#include "util.h"
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/gap.h>
+#include <opentimelineio/stackAlgorithm.h>
+#include <opentimelineio/threadPool.h>
+#include <opentimelineio/timeline.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
+
+using chrono_time_point = std::chrono::steady_clock::time_point;
+
+/// utility function for printing std::chrono elapsed time
+double
+print_elapsed_time(
+        const std::string& message,
+        const chrono_time_point& begin,
+        const chrono_time_point& end
+)
+{
+    const std::chrono::duration<float> dur = end - begin;
+
+    std::cout << message << ": " << dur.count() << " [s]" << std::endl;
+
+    return dur.count();
+}
+
+/// build a timeline whose upper tracks are punched through with gaps, so
+/// that flattening has to look down through every layer.
+otio::Timeline*
+make_synthetic_timeline(int track_count, int clips_per_track)
+{
+    const otio::TimeRange clip_range(
+        otio::RationalTime(0, 24),
+        otio::RationalTime(24, 24));
+
+    auto timeline = new otio::Timeline("synthetic");
+    for (int t = 0; t < track_count; ++t)
+    {
+        auto track = new otio::Track("V" + std::to_string(t + 1));
+        for (int c = 0; c < clips_per_track; ++c)
+        {
+            if (t > 0 && (c + t) % 4 == 0)
+            {
+                track->append_child(new otio::Gap(clip_range));
+            }
+            else
+            {
+                track->append_child(new otio::Clip(
+                    "clip_" + std::to_string(c),
+                    nullptr,
+                    clip_range));
+            }
+        }
+        timeline->tracks()->append_child(track);
+    }
+    return timeline;
+}
+
+int
+main(
+        int argc,
+        char *argv[]
+)
+{
+    if (argc > 1 && std::string(argv[1]) == "--help")
+    {
+        std::cerr << "usage: flatten_stack_perf_test [path/to/timeline.otio] ";
+        std::cerr << "[copies] [threads]" << std::endl;
+        return 1;
+    }
+
+    const std::string path    = argc > 1 ? argv[1] : "";
+    const int         copies  = argc > 2 ? std::atoi(argv[2]) : 1000;
+    const int         threads = argc > 3 ? std::atoi(argv[3]) : 0;
+
+    otio::ErrorStatus err;
+
+    otio::SerializableObject::Retainer<otio::Timeline> source;
+    if (path.empty())
+    {
+        source = make_synthetic_timeline(4, 100);
+    }
+    else
+    {
+        source = dynamic_cast<otio::Timeline*>(
+            otio::Timeline::from_json_file(path, &err));
+        if (!source)
+        {
+            examples::print_error(err);
+            return 1;
+        }
+    }
+
+    std::vector<otio::SerializableObject::Retainer<otio::Timeline>> timelines;
+    std::vector<otio::Stack*> stacks;
+    for (int i = 0; i < copies; ++i)
+    {
+        auto timeline = dynamic_cast<otio::Timeline*>(source->clone(&err));
+        if (!timeline)
+        {
+            examples::print_error(err);
+            return 1;
+        }
+        timelines.push_back(timeline);
+        stacks.push_back(timeline->tracks());
+    }
+
+    otio::ThreadPool pool(threads);
+    std::cout << "flattening " << copies << " timelines, ";
+    std::cout << pool.thread_count() << " threads" << std::endl;
+
+    chrono_time_point begin = std::chrono::steady_clock::now();
+    std::vector<otio::SerializableObject::Retainer<otio::Track>> serial;
+    for (auto stack: stacks)
+    {
+        serial.push_back(otio::flatten_stack(stack, &err));
+        if (otio::is_error(err))
+        {
+            examples::print_error(err);
+            return 1;
+        }
+    }
+    chrono_time_point end = std::chrono::steady_clock::now();
+    const double serial_time = print_elapsed_time("flatten_stack", begin, end);
+
+    begin = std::chrono::steady_clock::now();
+    auto flat_tracks = otio::flatten_stacks(stacks, &err, &pool);
+    end = std::chrono::steady_clock::now();
+    const double batch_time = print_elapsed_time("flatten_stacks", begin, end);
+    if (otio::is_error(err))
+    {
+        examples::print_error(err);
+        return 1;
+    }
+
+    std::vector<otio::SerializableObject::Retainer<otio::Track>> batch(
+        flat_tracks.begin(),
+        flat_tracks.end());
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        if (!batch[i]->is_equivalent_to(*serial[i]))
+        {
+            std::cerr << "flatten_stacks result " << i;
+            std::cerr << " differs from flatten_stack" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "speedup: " << serial_time / batch_time << "x" << std::endl;
+
+    return 0;
+}
@@ -144,7 +144,7 @@ overwrite(
 
             // We check if we are replacing a gap with a clip with timewarp,
             // which is the special case of fill() ReferencePoint::Fit.
-            if (dynamic_retainer_cast<Gap>(first_item))
+            if (fast_retainer_cast<Gap>(first_item))
             {
                 auto effects = item->effects();
                 for (auto& effect : effects)
@@ -302,7 +302,7 @@ insert(
     const TimeRange composition_range = composition->trimmed_range();
         
     // Find the item to insert into.
-    auto item = dynamic_retainer_cast<Item>(
+    auto item = fast_retainer_cast<Item>(
         composition->child_at_time(time, error_status));
     if (!item)
     {
@@ -402,7 +402,7 @@ void trim(
         start_time += delta_in;
         if (index > 0)
         {
-            auto previous = dynamic_retainer_cast<Item>(children[index - 1]);
+            auto previous = fast_retainer_cast<Item>(children[index - 1]);
             TimeRange previous_range = previous->trimmed_range();
             previous_range = TimeRange(previous_range.start_time(),
                                        previous_range.duration() + delta_in);
@@ -414,8 +414,8 @@ void trim(
         const int next_index = index + 1;
         if (static_cast<size_t>(next_index) < children.size())
         {
-            auto next = dynamic_retainer_cast<Item>(children[next_index]);
-            auto gap_next = dynamic_retainer_cast<Gap>(children[next_index]);
+            auto next = fast_retainer_cast<Item>(children[next_index]);
+            auto gap_next = fast_retainer_cast<Gap>(children[next_index]);
             if (gap_next && delta_out.value() > 0.0)
             {
                 end_time_exclusive += delta_out;
@@ -461,7 +461,7 @@ slice(
     bool const          remove_transitions,
     ErrorStatus*        error_status)
 {
-    auto item = dynamic_retainer_cast<Item>(
+    auto item = fast_retainer_cast<Item>(
         composition->child_at_time(time, error_status));
     if (!item)
     {
@@ -481,10 +481,10 @@ slice(
     
     // Accumulate intersecting transitions
     std::vector<Transition*> transitions;
-    if (auto track = dynamic_cast<Track*>(composition))
+    if (auto track = fast_cast<Track>(composition))
     {
         const auto neighbors = track->neighbors_of(item, error_status);
-        if (auto transition = dynamic_cast<Transition*>(neighbors.second.value))
+        if (auto transition = fast_cast<Transition>(neighbors.second.value))
         {
             const auto transition_range =
                 track->trimmed_range_of_child(transition).value();
@@ -493,7 +493,7 @@ slice(
                 transitions.push_back(transition);
             }
         }
-        if (auto transition = dynamic_cast<Transition*>(neighbors.first.value))
+        if (auto transition = fast_cast<Transition>(neighbors.first.value))
         {
             const auto transition_range =
                 track->trimmed_range_of_child(transition).value();
@@ -593,7 +593,7 @@ void slide(
     }
     
     auto children = composition->children();
-    auto previous = dynamic_retainer_cast<Item>(children[index - 1]);
+    auto previous = fast_retainer_cast<Item>(children[index - 1]);
     const TimeRange range = previous->trimmed_range();
     const TimeRange available_range = previous->available_range();
     RationalTime offset = delta;
@@ -704,7 +704,7 @@ roll(
             in_offset = -start_time;
         if (index > 0)
         {
-            auto previous = dynamic_retainer_cast<Item>(children[index - 1]);
+            auto previous = fast_retainer_cast<Item>(children[index - 1]);
             TimeRange previous_range = previous->trimmed_range();
 
             // Clamp to previous clip's range first
@@ -732,7 +732,7 @@ roll(
         const size_t next_index = index + 1;
         if (next_index < children.size())
         {
-            auto next = dynamic_retainer_cast<Item>(children[next_index]);
+            auto next = fast_retainer_cast<Item>(children[next_index]);
             TimeRange next_range = next->trimmed_range();
             const TimeRange next_available_range = next->available_range();
             RationalTime next_start_time = next_range.start_time();
@@ -773,7 +773,7 @@ fill(
     ErrorStatus*         error_status)
 {
     // Find the gap to replace.
-    auto gap = dynamic_retainer_cast<Gap>(
+    auto gap = fast_retainer_cast<Gap>(
         track->child_at_time(track_time, error_status, true));
     if (!gap)
     {
@@ -863,7 +863,7 @@ void remove(
     Item*               fill_template,
     ErrorStatus*        error_status)
 {
-    auto item = dynamic_retainer_cast<Item>(
+    auto item = fast_retainer_cast<Item>(
         composition->child_at_time(time, error_status));
     if (!item)
     {
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+/**
+ * An opt-in hook for counting the allocations of a program, to check what
+ * a code path allocates, or how close memory_footprint() comes to what a
+ * graph of objects really holds.
+ *
+ * The library never includes this header. Including it in one source file
+ * of a program (and only one) replaces the global operator new and delete
+ * of the whole program with ones that count allocations, and the bytes
+ * they hold. A program that replaces them itself, or runs under a tool
+ * that does, should not include it.
+ */
+
+#include "opentimelineio/version.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+namespace allocation_counter {
+
+inline std::atomic<size_t> allocations{ 0 };
+inline std::atomic<size_t> bytes_in_use{ 0 };
+
+// Room before each block for its size, keeping the block aligned.
+constexpr size_t header_size = alignof(std::max_align_t);
+
+} // namespace allocation_counter
+
+// The number of allocations made so far.
+inline size_t
+allocation_count()
+{
+    return allocation_counter::allocations.load();
+}
+
+// The bytes held by the allocations not yet freed.
+inline size_t
+allocated_bytes()
+{
+    return allocation_counter::bytes_in_use.load();
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
+
+void*
+operator new(std::size_t size)
+{
+    using namespace opentimelineio::OPENTIMELINEIO_VERSION::allocation_counter;
+    if (auto p = static_cast<char*>(std::malloc(header_size + size)))
+    {
+        *reinterpret_cast<std::size_t*>(p) = size;
+        ++allocations;
+        bytes_in_use += size;
+        return p + header_size;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+    using namespace opentimelineio::OPENTIMELINEIO_VERSION::allocation_counter;
+    if (p)
+    {
+        char* const block = static_cast<char*>(p) - header_size;
+        bytes_in_use -= *reinterpret_cast<std::size_t*>(block);
+        std::free(block);
+    }
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
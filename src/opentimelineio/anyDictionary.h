@@ -5,13 +5,23 @@
 
 #include "opentimelineio/version.h"
 
+#ifdef OTIO_FLAT_ANY_DICTIONARY
+#    include "opentimelineio/flatMap.h"
+#endif
+
 #include <any>
 #include <assert.h>
+#include <atomic>
+#include <initializer_list>
 #include <map>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
 
+class SerializableObject;
+
 /**
  * An AnyDictionary has exactly the same API as
  *    std::map<std::string, std::any>
@@ -25,9 +35,30 @@ namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
  * This allows us to hand out iterators that can be aware of mutation and moves
  * and take steps to safe-guard themselves from causing a crash.  (Yes,
  * I'm talking to you, Python...)
+ *
+ * Building with OTIO_FLAT_ANY_DICTIONARY stores the entries in a FlatMap
+ * instead, which keeps them sorted in one vector: far fewer allocations for
+ * the small dictionaries that metadata is made of, and the same iteration
+ * order.  Since inserting into a FlatMap may move any of its entries, that
+ * build also bumps the stamp for emplace, insert and operator[].
+ *
+ * A dictionary that belongs to an object (its metadata or dynamic fields)
+ * may be given that object as its owner, which it tells about each write
+ * made through its members, so that the object's generation counts it.
+ * operator[] and at() count as writes when called on a non-const
+ * dictionary; writes made later through the references and iterators they
+ * return are not seen.
  */
-class AnyDictionary : private std::map<std::string, std::any>
+#ifdef OTIO_FLAT_ANY_DICTIONARY
+using AnyDictionaryStorage = FlatMap<std::string, std::any>;
+#else
+using AnyDictionaryStorage = std::map<std::string, std::any>;
+#endif
+
+class AnyDictionary : private AnyDictionaryStorage
 {
+    using map = AnyDictionaryStorage;
+
 public:
     using map::map;
 
@@ -43,6 +74,15 @@ public:
         , _mutation_stamp{}
     {}
 
+    // the stamp and the owner stay with other, which is left empty
+    AnyDictionary(AnyDictionary&& other)
+        : map(std::move(static_cast<map&>(other)))
+        , _mutation_stamp{}
+    {
+        other.mutate();
+        other._modified();
+    }
+
     ~AnyDictionary()
     {
         if (_mutation_stamp)
@@ -56,6 +96,7 @@ public:
     {
         mutate();
         map::operator=(other);
+        _modified();
         return *this;
     }
 
@@ -63,7 +104,9 @@ public:
     {
         mutate();
         other.mutate();
-        map::operator=(other);
+        map::operator=(std::move(static_cast<map&>(other)));
+        _modified();
+        other._modified();
         return *this;
     }
 
@@ -71,13 +114,36 @@ public:
     {
         mutate();
         map::operator=(ilist);
+        _modified();
         return *this;
     }
 
     using map::get_allocator;
 
-    using map::at;
-    using map::operator[];
+    mapped_type& at(const key_type& key)
+    {
+        mapped_type& value = map::at(key);
+        _modified();
+        return value;
+    }
+
+    mapped_type const& at(const key_type& key) const { return map::at(key); }
+
+    mapped_type& operator[](const key_type& key)
+    {
+        _will_insert(key);
+        mapped_type& value = map::operator[](key);
+        _modified();
+        return value;
+    }
+
+    mapped_type& operator[](key_type&& key)
+    {
+        _will_insert(key);
+        mapped_type& value = map::operator[](std::move(key));
+        _modified();
+        return value;
+    }
 
     using map::begin;
     using map::cbegin;
@@ -88,31 +154,94 @@ public:
     using map::rbegin;
     using map::rend;
 
-    void clear() noexcept
+    void clear()
     {
         mutate();
         map::clear();
+        _modified();
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        _will_insert();
+        auto result = map::emplace(std::forward<Args>(args)...);
+        _modified();
+        return result;
+    }
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args)
+    {
+        _will_insert();
+        auto result = map::emplace_hint(hint, std::forward<Args>(args)...);
+        _modified();
+        return result;
+    }
+
+    std::pair<iterator, bool> insert(value_type const& value)
+    {
+        _will_insert();
+        auto result = map::insert(value);
+        _modified();
+        return result;
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        _will_insert();
+        auto result = map::insert(std::move(value));
+        _modified();
+        return result;
+    }
+
+    void insert(std::initializer_list<value_type> ilist)
+    {
+        _will_insert();
+        map::insert(ilist);
+        _modified();
+    }
+
+    template <typename... Args>
+    decltype(auto) insert(Args&&... args)
+    {
+        _will_insert();
+        if constexpr (std::is_void_v<decltype(map::insert(
+                          std::forward<Args>(args)...))>)
+        {
+            map::insert(std::forward<Args>(args)...);
+            _modified();
+        }
+        else
+        {
+            auto result = map::insert(std::forward<Args>(args)...);
+            _modified();
+            return result;
+        }
     }
-    using map::emplace;
-    using map::emplace_hint;
-    using map::insert;
 
     iterator erase(const_iterator pos)
     {
         mutate();
-        return map::erase(pos);
+        auto result = map::erase(pos);
+        _modified();
+        return result;
     }
 
     iterator erase(const_iterator first, const_iterator last)
     {
         mutate();
-        return map::erase(first, last);
+        auto result = map::erase(first, last);
+        _modified();
+        return result;
     }
 
     size_type erase(const key_type& key)
     {
         mutate();
-        return map::erase(key);
+        size_type const result = map::erase(key);
+        _modified();
+        return result;
     }
 
     void swap(AnyDictionary& other)
@@ -120,6 +249,8 @@ public:
         mutate();
         other.mutate();
         map::swap(other);
+        _modified();
+        other._modified();
     }
 
     /// @TODO: remove all of these @{
@@ -184,6 +315,9 @@ public:
     using map::empty;
     using map::max_size;
     using map::size;
+#ifdef OTIO_FLAT_ANY_DICTIONARY
+    using map::capacity;
+#endif
 
     using map::count;
     using map::equal_range;
@@ -258,10 +392,34 @@ public:
         return _mutation_stamp;
     }
 
+    // Whether a stamp is watching this dictionary, which whoever holds the
+    // stamp may modify through it.
+    bool has_mutation_stamp() const noexcept
+    {
+        return _mutation_stamp != nullptr;
+    }
+
     friend struct MutationStamp;
 
+    // The object told about writes to this dictionary, if any.  Copies
+    // start without an owner.  Atomic, since a dictionary shared between
+    // objects stops having one when it is first shared, which may happen
+    // on several threads at once.
+    SerializableObject* owner() const noexcept
+    {
+        return _owner.load(std::memory_order_relaxed);
+    }
+
+    void set_owner(SerializableObject* owner) noexcept
+    {
+        _owner.store(owner, std::memory_order_relaxed);
+    }
+
 private:
-    MutationStamp* _mutation_stamp = nullptr;
+    // Only mutating members and get_or_create_mutation_stamp() touch the
+    // stamp, so const access from several threads at once is safe.
+    MutationStamp*                   _mutation_stamp = nullptr;
+    std::atomic<SerializableObject*> _owner{ nullptr };
 
     void mutate() noexcept
     {
@@ -270,6 +428,37 @@ private:
             _mutation_stamp->stamp++;
         }
     }
+
+    // Before inserting: in the flat build, inserting may move any entry.
+    void _will_insert() noexcept
+    {
+#ifdef OTIO_FLAT_ANY_DICTIONARY
+        mutate();
+#endif
+    }
+
+    void _will_insert(const key_type& key) noexcept
+    {
+#ifdef OTIO_FLAT_ANY_DICTIONARY
+        if (!count(key))
+        {
+            mutate();
+        }
+#else
+        (void) key;
+#endif
+    }
+
+    void _modified()
+    {
+        if (SerializableObject* owner = this->owner())
+        {
+            _owner_modified(owner);
+        }
+    }
+
+    // Defined in serializableObject.cpp.
+    static void _owner_modified(SerializableObject* owner);
 };
 
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
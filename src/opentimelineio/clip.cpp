@@ -23,7 +23,33 @@ Clip::Clip(
 }
 
 Clip::~Clip()
-{}
+{
+    _release_media_references();
+}
+
+void
+Clip::_adopt_media_references()
+{
+    for (auto const& m: _media_references)
+    {
+        if (m.second)
+        {
+            m.second.value->_clip = this;
+        }
+    }
+}
+
+void
+Clip::_release_media_references()
+{
+    for (auto const& m: _media_references)
+    {
+        if (m.second && m.second.value->_clip == this)
+        {
+            m.second.value->_clip = nullptr;
+        }
+    }
+}
 
 MediaReference*
 Clip::media_reference() const noexcept
@@ -88,7 +114,7 @@ void
 Clip::set_media_references(
     MediaReferences const& media_references,
     std::string const&     new_active_key,
-    ErrorStatus*           error_status) noexcept
+    ErrorStatus*           error_status)
 {
     if (!check_for_valid_media_reference_key(
             "set_media_references",
@@ -99,13 +125,16 @@ Clip::set_media_references(
         return;
     }
 
+    _release_media_references();
     _media_references.clear();
     for (auto const& m: media_references)
     {
         _media_references[m.first] = m.second ? m.second : new MissingReference;
     }
+    _adopt_media_references();
 
     _active_media_reference_key = new_active_key;
+    _changed();
 }
 
 std::string
@@ -117,7 +146,7 @@ Clip::active_media_reference_key() const noexcept
 void
 Clip::set_active_media_reference_key(
     std::string const& new_active_key,
-    ErrorStatus*       error_status) noexcept
+    ErrorStatus*       error_status)
 {
     if (!check_for_valid_media_reference_key(
             "set_active_media_reference_key",
@@ -128,23 +157,32 @@ Clip::set_active_media_reference_key(
         return;
     }
     _active_media_reference_key = new_active_key;
+    _changed();
 }
 
 void
 Clip::set_media_reference(MediaReference* media_reference)
 {
-    _media_references[_active_media_reference_key] =
-        media_reference ? media_reference : new MissingReference;
+    auto& active = _media_references[_active_media_reference_key];
+    if (active && active.value->_clip == this)
+    {
+        active.value->_clip = nullptr;
+    }
+    active = media_reference ? media_reference : new MissingReference;
+    active.value->_clip = this;
+    _changed();
 }
 
 bool
 Clip::read_from(Reader& reader)
 {
-    return reader.read("media_references", &_media_references)
-           && reader.read(
-               "active_media_reference_key",
-               &_active_media_reference_key)
-           && Parent::read_from(reader);
+    bool result = reader.read("media_references", &_media_references)
+                  && reader.read(
+                      "active_media_reference_key",
+                      &_active_media_reference_key)
+                  && Parent::read_from(reader);
+    _adopt_media_references();
+    return result;
 }
 
 void
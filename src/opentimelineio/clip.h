@@ -40,12 +40,12 @@ public:
     void            set_media_references(
                    MediaReferences const& media_references,
                    std::string const&     new_active_key,
-                   ErrorStatus*           error_status = nullptr) noexcept;
+                   ErrorStatus*           error_status = nullptr);
 
     std::string active_media_reference_key() const noexcept;
     void        set_active_media_reference_key(
                std::string const& new_active_key,
-               ErrorStatus*       error_status = nullptr) noexcept;
+               ErrorStatus*       error_status = nullptr);
 
     TimeRange
     available_range(ErrorStatus* error_status = nullptr) const override;
@@ -60,6 +60,11 @@ protected:
     void write_to(Writer&) const override;
 
 private:
+    // Point the media references at this clip, or away from it, so that
+    // their changes are passed on to it.
+    void _adopt_media_references();
+    void _release_media_references();
+
     template <typename MediaRefMap>
     bool check_for_valid_media_reference_key(
         std::string const& caller,
@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "opentimelineio/clipTable.h"
+#include "opentimelineio/externalReference.h"
+#include "opentimelineio/imageSequenceReference.h"
+#include "opentimelineio/track.h"
+
+#include <map>
+#include <unordered_map>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+namespace {
+
+class ClipTableBuilder
+{
+public:
+    ClipTableBuilder(
+        ClipTable&                      table,
+        std::vector<std::string> const& metadata_keys)
+        : _table(table)
+    {
+        _table.metadata_keys = metadata_keys;
+        _table.metadata.resize(metadata_keys.size());
+    }
+
+    bool add_composition(
+        Composition const* composition,
+        int32_t            parent_row,
+        int32_t            track_row,
+        ErrorStatus*       error_status);
+
+private:
+    int32_t _intern(std::string const& s);
+
+    void _append_range(
+        TimeRange const&     range,
+        std::vector<double>& start,
+        std::vector<double>& duration,
+        std::vector<double>& rate);
+
+    void _add_clip(
+        Clip const*      clip,
+        TimeRange const& trimmed_range,
+        TimeRange const& range_in_parent,
+        int32_t          parent_row,
+        int32_t          track_row);
+
+    ClipTable&                               _table;
+    std::unordered_map<std::string, int32_t> _string_ids;
+};
+
+int32_t
+ClipTableBuilder::_intern(std::string const& s)
+{
+    auto inserted = _string_ids.emplace(s, int32_t(_table.strings.size()));
+    if (inserted.second)
+    {
+        _table.strings.push_back(s);
+    }
+    return inserted.first->second;
+}
+
+void
+ClipTableBuilder::_append_range(
+    TimeRange const&     range,
+    std::vector<double>& start,
+    std::vector<double>& duration,
+    std::vector<double>& rate)
+{
+    // store both the start and duration in the duration's rate, so that a
+    // single rate column describes the row.
+    double const r = range.duration().rate();
+    start.push_back(range.start_time().value_rescaled_to(r));
+    duration.push_back(range.duration().value());
+    rate.push_back(r);
+}
+
+void
+ClipTableBuilder::_add_clip(
+    Clip const*      clip,
+    TimeRange const& trimmed_range,
+    TimeRange const& range_in_parent,
+    int32_t          parent_row,
+    int32_t          track_row)
+{
+    _table.clips.push_back(clip);
+    _table.name.push_back(_intern(clip->name()));
+
+    int32_t    media_url       = -1;
+    auto const media_reference = clip->media_reference();
+    if (auto external = dynamic_cast<ExternalReference*>(media_reference))
+    {
+        media_url = _intern(external->target_url());
+    }
+    else if (
+        auto sequence = dynamic_cast<ImageSequenceReference*>(media_reference))
+    {
+        media_url = _intern(sequence->target_url_base());
+    }
+    _table.media_url.push_back(media_url);
+
+    _append_range(
+        trimmed_range,
+        _table.trimmed_start,
+        _table.trimmed_duration,
+        _table.trimmed_rate);
+    _append_range(
+        range_in_parent,
+        _table.range_in_parent_start,
+        _table.range_in_parent_duration,
+        _table.range_in_parent_rate);
+
+    _table.parent_index.push_back(parent_row);
+    _table.track_index.push_back(track_row);
+
+    AnyDictionary const& metadata = clip->metadata_ref();
+    for (size_t i = 0; i < _table.metadata_keys.size(); ++i)
+    {
+        int32_t value = -1;
+        auto    e     = metadata.find(_table.metadata_keys[i]);
+        if (e != metadata.end() && e->second.type() == typeid(std::string))
+        {
+            value = _intern(std::any_cast<std::string const&>(e->second));
+        }
+        _table.metadata[i].push_back(value);
+    }
+}
+
+bool
+ClipTableBuilder::add_composition(
+    Composition const* composition,
+    int32_t            parent_row,
+    int32_t            track_row,
+    ErrorStatus*       error_status)
+{
+    int32_t const row = int32_t(_table.compositions.size());
+    _table.compositions.push_back(composition);
+    _table.composition_name.push_back(_intern(composition->name()));
+    _table.composition_kind.push_back(_intern(composition->composition_kind()));
+    _table.composition_parent.push_back(parent_row);
+
+    if (fast_cast<Track>(composition))
+    {
+        track_row = row;
+    }
+
+    auto const& children = composition->children();
+    if (children.empty())
+    {
+        return true;
+    }
+
+    // compute the range of every child in one pass where the composition
+    // supports it, rather than asking for each child's range in turn.
+    ErrorStatus                      ranges_error;
+    std::map<Composable*, TimeRange> ranges =
+        composition->range_of_all_children(&ranges_error);
+    bool const have_ranges = !is_error(ranges_error);
+    if (!have_ranges
+        && ranges_error.outcome != ErrorStatus::NOT_IMPLEMENTED)
+    {
+        if (error_status)
+        {
+            *error_status = ranges_error;
+        }
+        return false;
+    }
+
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        Composable* child = children[i];
+        if (auto clip = fast_cast<Clip>(child))
+        {
+            TimeRange range_in_parent;
+            if (have_ranges)
+            {
+                range_in_parent = ranges[child];
+            }
+            else
+            {
+                range_in_parent =
+                    composition->range_of_child_at_index(int(i), error_status);
+                if (is_error(error_status))
+                {
+                    return false;
+                }
+            }
+
+            TimeRange trimmed_range = clip->trimmed_range(error_status);
+            if (is_error(error_status))
+            {
+                return false;
+            }
+
+            _add_clip(clip, trimmed_range, range_in_parent, row, track_row);
+        }
+        else if (auto child_composition = fast_cast<Composition>(child))
+        {
+            if (!add_composition(
+                    child_composition,
+                    row,
+                    track_row,
+                    error_status))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+ClipTable
+clip_table(
+    Composition const*              root,
+    std::vector<std::string> const& metadata_keys,
+    ErrorStatus*                    error_status)
+{
+    ClipTable table;
+    if (!root)
+    {
+        if (error_status)
+        {
+            *error_status = ErrorStatus(
+                ErrorStatus::INTERNAL_ERROR,
+                "cannot build the clip table of a null composition");
+        }
+        return table;
+    }
+
+    ClipTableBuilder builder(table, metadata_keys);
+    if (!builder.add_composition(root, -1, -1, error_status))
+    {
+        return ClipTable();
+    }
+    return table;
+}
+
+ClipTable
+clip_table(
+    Timeline const*                 timeline,
+    std::vector<std::string> const& metadata_keys,
+    ErrorStatus*                    error_status)
+{
+    return clip_table(
+        timeline ? timeline->tracks() : nullptr,
+        metadata_keys,
+        error_status);
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
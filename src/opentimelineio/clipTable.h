@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentimelineio/clip.h"
+#include "opentimelineio/composition.h"
+#include "opentimelineio/timeline.h"
+#include "opentimelineio/version.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+/// A columnar description of the clips in a composition, gathered in a
+/// single traversal.
+///
+/// Every column is a flat array, so the table can be handed to analytics
+/// code (or wrapped as numpy or Arrow arrays) without copying.
+///
+/// String columns hold indices into strings, where each distinct string
+/// is stored once; -1 marks a missing value. Times are stored as a start
+/// and duration in the units of the accompanying rate column.
+///
+/// The table holds plain pointers to the compositions and clips it
+/// describes, and is only valid while they are alive and unmodified.
+struct ClipTable
+{
+    std::vector<std::string> strings;
+
+    /// One row per composition, in depth-first order, starting with the
+    /// root. composition_parent is the row of the parent composition, or
+    /// -1 for the root.
+    std::vector<Composition const*> compositions;
+    std::vector<int32_t>            composition_name;
+    std::vector<int32_t>            composition_kind;
+    std::vector<int32_t>            composition_parent;
+
+    /// One row per clip, in the same order as Composition::find_clips().
+    std::vector<Clip const*> clips;
+    std::vector<int32_t>     name;
+
+    /// The target_url of the clip's media reference, if it is an
+    /// ExternalReference; the target_url_base, if it is an
+    /// ImageSequenceReference.
+    std::vector<int32_t> media_url;
+
+    /// The clip's trimmed_range().
+    std::vector<double> trimmed_start;
+    std::vector<double> trimmed_duration;
+    std::vector<double> trimmed_rate;
+
+    /// The clip's range_in_parent().
+    std::vector<double> range_in_parent_start;
+    std::vector<double> range_in_parent_duration;
+    std::vector<double> range_in_parent_rate;
+
+    /// The composition rows of the clip's parent and of the closest Track
+    /// containing it (-1 if there is none).
+    std::vector<int32_t> parent_index;
+    std::vector<int32_t> track_index;
+
+    /// For each requested metadata key, a string column holding the
+    /// clip's metadata value for that key, if that value is a string.
+    std::vector<std::string>          metadata_keys;
+    std::vector<std::vector<int32_t>> metadata;
+
+    size_t size() const noexcept { return clips.size(); }
+};
+
+/// Build the clip table of root and everything beneath it.
+///
+/// metadata_keys names the top level metadata entries to gather into
+/// columns. If the operation fails, an empty table is returned and
+/// error_status is set appropriately.
+ClipTable clip_table(
+    Composition const*              root,
+    std::vector<std::string> const& metadata_keys = std::vector<std::string>(),
+    ErrorStatus*                    error_status  = nullptr);
+
+/// Build the clip table of the tracks of timeline.
+ClipTable clip_table(
+    Timeline const*                 timeline,
+    std::vector<std::string> const& metadata_keys = std::vector<std::string>(),
+    ErrorStatus*                    error_status  = nullptr);
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -35,9 +35,19 @@ Composable::_set_parent(Composition* new_parent) noexcept
     }
 
     _parent = new_parent;
+    if (new_parent && _is_unsettled())
+    {
+        new_parent->_unsettle();
+    }
     return true;
 }
 
+SerializableObject*
+Composable::_change_parent() const
+{
+    return _parent ? _parent : _holder();
+}
+
 Composable*
 Composable::_highest_ancestor() noexcept
 {
@@ -48,6 +48,8 @@ protected:
 
     virtual ~Composable();
 
+    SerializableObject* _change_parent() const override;
+
     bool read_from(Reader&) override;
     void write_to(Writer&) const override;
 
@@ -3,8 +3,10 @@
 
 #include "opentimelineio/composition.h"
 #include "opentimelineio/clip.h"
+#include "opentimelineio/instrumentation.h"
 #include "opentimelineio/vectorIndexing.h"
 
+#include <algorithm>
 #include <assert.h>
 #include <set>
 
@@ -36,11 +38,16 @@ Composition::clear_children()
 {
     for (Composable* child: _children)
     {
-        child->_set_parent(nullptr);
+        if (child->parent() == this)
+        {
+            child->_set_parent(nullptr);
+        }
     }
 
     _children.clear();
     _child_set.clear();
+    _parents_of_shared.clear();
+    _changed();
 }
 
 bool
@@ -67,6 +74,46 @@ Composition::set_children(
 
     _children  = decltype(_children)(children.begin(), children.end());
     _child_set = std::set<Composable*>(children.begin(), children.end());
+    _changed();
+    return true;
+}
+
+bool
+Composition::_share_children(
+    std::vector<Composable*> const& children,
+    ErrorStatus*                    error_status)
+{
+    if (!_children.empty())
+    {
+        if (error_status)
+        {
+            *error_status = ErrorStatus(
+                ErrorStatus::INTERNAL_ERROR,
+                "children can only be shared into an empty composition");
+        }
+        return false;
+    }
+
+    for (auto child: children)
+    {
+        if (!child->parent())
+        {
+            child->_set_parent(this);
+        }
+        else if (
+            std::find(
+                _parents_of_shared.begin(),
+                _parents_of_shared.end(),
+                child->parent())
+            == _parents_of_shared.end())
+        {
+            _parents_of_shared.emplace_back(child->parent());
+        }
+    }
+
+    _children  = decltype(_children)(children.begin(), children.end());
+    _child_set = std::set<Composable*>(children.begin(), children.end());
+    _changed();
     return true;
 }
 
@@ -98,6 +145,7 @@ Composition::insert_child(
     }
 
     _child_set.insert(child);
+    _changed();
     return true;
 }
 
@@ -130,6 +178,7 @@ Composition::set_child(int index, Composable* child, ErrorStatus* error_status)
         child->_set_parent(this);
         _children[index] = child;
         _child_set.insert(child);
+        _changed();
     }
     return true;
 }
@@ -162,6 +211,7 @@ Composition::remove_child(int index, ErrorStatus* error_status)
         _children.erase(_children.begin() + index);
     }
 
+    _changed();
     return true;
 }
 
@@ -206,7 +256,31 @@ void
 Composition::write_to(Writer& writer) const
 {
     Parent::write_to(writer);
-    writer.write("children", _children);
+    if (writer._omit_children_of == this)
+    {
+        writer.write("children", AnyVector());
+    }
+    else
+    {
+        writer.write("children", _children);
+    }
+}
+
+void
+Composition::_settle_held()
+{
+    Parent::_settle_held();
+    for (auto const& child: _children)
+    {
+        child.value->generation();
+    }
+}
+
+Composition*
+Composition::clone_without_children(ErrorStatus* error_status) const
+{
+    return dynamic_cast<Composition*>(
+        _clone(error_status, this));
 }
 
 bool
@@ -243,6 +317,13 @@ Composition::_path_from_child(
     Composable const* child,
     ErrorStatus*      error_status) const
 {
+    // a child shared from another composition (see _share_children())
+    // is a child of this one all the same.
+    if (child->parent() != this && _child_set.count(const_cast<Composable*>(child)))
+    {
+        return { const_cast<Composition*>(this) };
+    }
+
     auto                      current = child->parent();
     std::vector<Composition*> parents{ current };
 
@@ -479,6 +560,8 @@ Composition::child_at_time(
     ErrorStatus*        error_status,
     bool                shallow_search) const
 {
+    OTIO_TRACE_SCOPE("Composition::child_at_time");
+
     Retainer<Composable> result;
 
     auto range_map = range_of_all_children(error_status);
@@ -531,7 +614,7 @@ Composition::child_at_time(
 
     // if the search cannot or should not continue
     auto composition =
-        Retainer<Composition>(dynamic_cast<Composition*>(result.value));
+        Retainer<Composition>(fast_cast<Composition>(result.value));
     if (!result || shallow_search || !composition)
     {
         return result;
@@ -562,6 +645,8 @@ Composition::children_in_range(
     TimeRange const& search_range,
     ErrorStatus*     error_status) const
 {
+    OTIO_TRACE_SCOPE("Composition::children_in_range");
+
     std::vector<Retainer<Composable>> children;
 
     auto range_map = range_of_all_children(error_status);
@@ -694,11 +779,11 @@ Composition::has_clips() const
 {
     for (auto child: children())
     {
-        if (dynamic_cast<Clip*>(child.value))
+        if (fast_cast<Clip>(child.value))
         {
             return true;
         }
-        else if (auto child_comp = dynamic_cast<Composition*>(child.value))
+        else if (auto child_comp = fast_cast<Composition>(child.value))
         {
             if (child_comp->has_clips())
             {
@@ -6,6 +6,7 @@
 #include "opentimelineio/item.h"
 #include "opentimelineio/version.h"
 #include <set>
+#include <type_traits>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
 
@@ -87,6 +88,14 @@ public:
 
     bool has_child(Composable* child) const;
 
+    // Makes a clone of this composition without its children.
+    //
+    // Everything else, including effects, markers and metadata, is cloned
+    // as clone() would. If the operation fails, nullptr is returned and
+    // error_status is set appropriately.
+    Composition*
+    clone_without_children(ErrorStatus* error_status = nullptr) const;
+
     bool has_clips() const;
 
     virtual std::map<Composable*, TimeRange>
@@ -116,12 +125,31 @@ public:
         std::optional<TimeRange> search_range   = std::nullopt,
         bool                     shallow_search = false) const;
 
+    // Call visitor(child) on each child object, in the order find_children()
+    // returns them, without collecting them. The visitor returns false to
+    // stop the search.
+    //
+    // An optional search_range may be provided to limit the search.
+    //
+    // The search is recursive unless shallow_search is set to true.
+    //
+    // Returns true if the search ran to completion; false if the visitor
+    // stopped it or an error occurred.
+    template <typename VISITOR>
+    bool visit_children(
+        VISITOR&&                       visitor,
+        ErrorStatus*                    error_status   = nullptr,
+        std::optional<TimeRange> const& search_range   = std::nullopt,
+        bool                            shallow_search = false) const;
+
 protected:
     virtual ~Composition();
 
     bool read_from(Reader&) override;
     void write_to(Writer&) const override;
 
+    void _settle_held() override;
+
     std::vector<Composition*> _path_from_child(
         Composable const* child,
         ErrorStatus*      error_status = nullptr) const;
@@ -163,11 +191,24 @@ private:
         std::optional<int64_t> lower_search_bound = std::optional<int64_t>(0),
         std::optional<int64_t> upper_search_bound = std::nullopt) const;
 
+    // Set the children, parenting those that have no parent, and holding
+    // the others without re-parenting them: see TimelineSnapshotter, whose
+    // snapshots share their unchanged tracks.
+    bool _share_children(
+        std::vector<Composable*> const& children,
+        ErrorStatus*                    error_status);
+
     std::vector<Retainer<Composable>> _children;
 
     // This is for fast lookup only, and varies automatically
     // as _children is mutated.
     std::set<Composable*> _child_set;
+
+    // The parents of the children shared by _share_children(), which must
+    // outlive this composition.
+    std::vector<Retainer<Composition>> _parents_of_shared;
+
+    friend class TimelineSnapshotter;
 };
 
 template <typename T>
@@ -177,63 +218,88 @@ Composition::find_children(
     std::optional<TimeRange> search_range,
     bool                     shallow_search) const
 {
-    std::vector<Retainer<T>>          out;
-    std::vector<Retainer<Composable>> children;
+    std::vector<Retainer<T>> out;
+    visit_children(
+        [&out](Composable* child) {
+            if constexpr (std::is_same<T, Composable>::value)
+            {
+                out.push_back(child);
+            }
+            else if (auto valid_child = fast_cast<T>(child))
+            {
+                out.push_back(valid_child);
+            }
+            return true;
+        },
+        error_status,
+        search_range,
+        shallow_search);
+    return out;
+}
+
+template <typename VISITOR>
+inline bool
+Composition::visit_children(
+    VISITOR&&                       visitor,
+    ErrorStatus*                    error_status,
+    std::optional<TimeRange> const& search_range,
+    bool                            shallow_search) const
+{
+    std::vector<Retainer<Composable>> children_in_search_range;
     if (search_range)
     {
         // limit the search to children who are in the search_range
-        children = children_in_range(*search_range, error_status);
+        children_in_search_range =
+            children_in_range(*search_range, error_status);
         if (is_error(error_status))
         {
-            return out;
+            return false;
         }
     }
-    else
-    {
-        // otherwise search all the children
-        children = _children;
-    }
-    for (const auto& child: children)
+
+    // otherwise search all the children
+    auto const& children = search_range ? children_in_search_range : _children;
+    for (auto const& child: children)
     {
-        if (auto valid_child = dynamic_cast<T*>(child.value))
+        if (!visitor(child.value))
         {
-            out.push_back(valid_child);
+            return false;
         }
 
         // if not a shallow_search, for children that are compositions,
         // recurse into their children
-        if (!shallow_search)
+        if (shallow_search)
         {
-            if (auto composition = dynamic_cast<Composition*>(child.value))
+            continue;
+        }
+        auto composition = fast_cast<Composition>(child.value);
+        if (!composition)
+        {
+            continue;
+        }
+
+        std::optional<TimeRange> child_search_range;
+        if (search_range)
+        {
+            child_search_range = transformed_time_range(
+                *search_range,
+                composition,
+                error_status);
+            if (is_error(error_status))
             {
-                if (search_range)
-                {
-                    search_range = transformed_time_range(
-                        *search_range,
-                        composition,
-                        error_status);
-                    if (is_error(error_status))
-                    {
-                        return out;
-                    }
-                }
-
-                const auto valid_children = composition->find_children<T>(
-                    error_status,
-                    search_range,
-                    shallow_search);
-                if (is_error(error_status))
-                {
-                    return out;
-                }
-                for (const auto& valid_child: valid_children)
-                {
-                    out.push_back(valid_child);
-                }
+                return false;
             }
         }
+        if (!composition->visit_children(
+                visitor,
+                error_status,
+                child_search_range,
+                shallow_search))
+        {
+            return false;
+        }
     }
-    return out;
+    return true;
 }
 
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
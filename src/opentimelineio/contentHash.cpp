@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "opentimelineio/contentHash.h"
+#include "opentimelineio/threadPool.h"
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+std::string
+ContentHash::to_string() const
+{
+    static char const digits[] = "0123456789abcdef";
+
+    std::string result(32, '0');
+    for (int i = 0; i < 16; ++i)
+    {
+        result[15 - i] = digits[(high >> (4 * i)) & 0xf];
+        result[31 - i] = digits[(low >> (4 * i)) & 0xf];
+    }
+    return result;
+}
+
+std::vector<ContentHash>
+content_hashes(
+    std::vector<SerializableObject const*> const& roots,
+    ErrorStatus*                                  error_status,
+    ThreadPool*                                   thread_pool)
+{
+    std::vector<ContentHash> result(roots.size());
+    std::vector<ErrorStatus> errors(roots.size());
+    parallel_for(
+        thread_pool ? *thread_pool : ThreadPool::global(),
+        roots.size(),
+        [&](size_t i) { result[i] = content_hash(roots[i], &errors[i]); });
+
+    for (auto const& error: errors)
+    {
+        if (is_error(error))
+        {
+            if (error_status)
+            {
+                *error_status = error;
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
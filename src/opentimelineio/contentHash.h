@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentimelineio/errorStatus.h"
+#include "opentimelineio/version.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+class SerializableObject;
+class ThreadPool;
+
+/**
+ * A 128 bit hash of what an object holds, for keying caches of what is
+ * derived from it (renders, proxies, exports) and for finding duplicates.
+ */
+struct ContentHash
+{
+    uint64_t high = 0;
+    uint64_t low  = 0;
+
+    // The hash as 32 hexadecimal digits.
+    std::string to_string() const;
+
+    friend bool operator==(ContentHash lhs, ContentHash rhs) noexcept
+    {
+        return lhs.high == rhs.high && lhs.low == rhs.low;
+    }
+
+    friend bool operator!=(ContentHash lhs, ContentHash rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(ContentHash lhs, ContentHash rhs) noexcept
+    {
+        return lhs.high < rhs.high
+               || (lhs.high == rhs.high && lhs.low < rhs.low);
+    }
+};
+
+/**
+ * Hash root and everything it holds, walking the objects the same way that
+ * serializing them does, without producing any output. Objects that would
+ * serialize to the same JSON have the same hash, as a clone has that of
+ * its original: the hash does not depend on where objects are in memory,
+ * on the order of the entries of dictionaries, or on the platform.
+ *
+ * The hash of each object is kept with it, along with its generation (see
+ * SerializableObject::generation()), so hashing again after an edit only
+ * walks what the edit changed, plus the objects whose generation does not
+ * count every change to what they hold: those holding objects in their
+ * metadata.
+ *
+ * Hashing only reads the objects, so several threads may hash objects at
+ * once, overlapping or not, as long as none of them is being modified.
+ *
+ * A null root has a hash of zero. If the walk fails (say, because the
+ * graph holds a cycle), a hash of zero is returned and error_status is set.
+ */
+ContentHash content_hash(
+    SerializableObject const* root,
+    ErrorStatus*              error_status = nullptr);
+
+/**
+ * Hash each of roots as content_hash() does, concurrently on thread_pool
+ * (or ThreadPool::global() if none is given). If hashing one of them
+ * fails, its hash is zero and error_status is set from the first failure.
+ */
+std::vector<ContentHash> content_hashes(
+    std::vector<SerializableObject const*> const& roots,
+    ErrorStatus*                                  error_status = nullptr,
+    ThreadPool*                                   thread_pool  = nullptr);
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -0,0 +1,605 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "opentimelineio/deltaSerializer.h"
+#include "opentimelineio/deserialization.h"
+#include "opentimelineio/serialization.h"
+#include "opentimelineio/stack.h"
+#include "opentimelineio/timeline.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+namespace {
+
+char const* const children_key = "/children";
+char const* const tracks_key   = "/tracks";
+
+// The children of object, if it holds any: those of a composition, or
+// those of the tracks stack of a timeline.
+Composition*
+children_holder(SerializableObject* object)
+{
+    if (auto timeline = fast_cast<Timeline>(object))
+    {
+        return timeline->tracks();
+    }
+    return fast_cast<Composition>(object);
+}
+
+Composition const*
+children_holder(SerializableObject const* object)
+{
+    return children_holder(const_cast<SerializableObject*>(object));
+}
+
+// The path of the children of object, relative to object.
+std::string
+children_path(SerializableObject const* object)
+{
+    return fast_cast<Timeline>(object)
+               ? std::string(tracks_key) + children_key
+               : std::string(children_key);
+}
+
+// A clone of object, a composition or a timeline, without its children.
+SerializableObject*
+clone_without_children(
+    SerializableObject const* object,
+    ErrorStatus*              error_status)
+{
+    if (auto timeline = fast_cast<Timeline>(object))
+    {
+        return timeline->clone_without_children(error_status);
+    }
+    return fast_cast<Composition>(object)->clone_without_children(
+        error_status);
+}
+
+AnyDictionary
+operation(std::string const& op, std::string const& path)
+{
+    AnyDictionary result;
+    result["op"]   = op;
+    result["path"] = path;
+    return result;
+}
+
+} // namespace
+
+struct DeltaSerializer::_Changes
+{
+    ErrorStatus error_status;
+    AnyVector   operations;
+
+    // Applied once the patch has been written: first the containers that
+    // left the document are forgotten, then the new state is recorded.
+    std::vector<SerializableObject const*>                        forgotten;
+    std::vector<std::pair<SerializableObject const*, _Container>> recorded;
+};
+
+DeltaSerializer::DeltaSerializer(SerializableObject const* root)
+    : _root(root)
+    , _root_generation(0)
+{}
+
+std::string
+DeltaSerializer::base_json(ErrorStatus* error_status, int indent)
+{
+    _Changes          changes;
+    std::string const json = serialize_json_to_string(
+        std::any(SerializableObject::Retainer<>(_root)),
+        nullptr,
+        &changes.error_status,
+        indent);
+    if (is_error(changes.error_status) || !_record(_root, changes))
+    {
+        if (error_status)
+        {
+            *error_status = changes.error_status;
+        }
+        return std::string();
+    }
+
+    _containers.clear();
+    for (auto& e: changes.recorded)
+    {
+        _containers[e.first] = std::move(e.second);
+    }
+    _root_generation = _root->generation();
+    return json;
+}
+
+std::string
+DeltaSerializer::patch_json(ErrorStatus* error_status, int indent)
+{
+    _Changes changes;
+    bool     ok = true;
+    if (_root->generation() != _root_generation)
+    {
+        ok = _containers.count(_root) ? _diff(_root, std::string(), changes)
+                                      : _replace(_root, std::string(), changes);
+    }
+
+    std::string json;
+    if (ok)
+    {
+        json = serialize_json_to_string(
+            std::any(std::move(changes.operations)),
+            nullptr,
+            &changes.error_status,
+            indent);
+    }
+    if (!ok || is_error(changes.error_status))
+    {
+        if (error_status)
+        {
+            *error_status = changes.error_status;
+        }
+        return std::string();
+    }
+
+    for (auto object: changes.forgotten)
+    {
+        _forget(object);
+    }
+    for (auto& e: changes.recorded)
+    {
+        _containers[e.first] = std::move(e.second);
+    }
+    _root_generation = _root->generation();
+    return json;
+}
+
+bool
+DeltaSerializer::_record(SerializableObject const* object, _Changes& changes)
+{
+    Composition const* holder = children_holder(object);
+    if (!holder)
+    {
+        return true;
+    }
+
+    SerializableObject::Retainer<> shallow(
+        clone_without_children(object, &changes.error_status));
+    if (is_error(changes.error_status) || !shallow)
+    {
+        return false;
+    }
+
+    _Container container;
+    container.shallow_json =
+        shallow->to_json_string(&changes.error_status, nullptr, 0);
+    container.children.reserve(holder->children().size());
+    for (auto const& child: holder->children())
+    {
+        container.children.emplace_back(child.value, child->generation());
+        if (!_record(child.value, changes))
+        {
+            return false;
+        }
+    }
+    changes.recorded.emplace_back(object, std::move(container));
+    return !is_error(changes.error_status);
+}
+
+bool
+DeltaSerializer::_diff(
+    SerializableObject const* object,
+    std::string const&        path,
+    _Changes&                 changes)
+{
+    auto saved = _containers.find(object);
+    if (saved == _containers.end() || !children_holder(object))
+    {
+        return _replace(object, path, changes);
+    }
+
+    // the fields of the object itself
+    SerializableObject::Retainer<> shallow(
+        clone_without_children(object, &changes.error_status));
+    if (is_error(changes.error_status) || !shallow)
+    {
+        return false;
+    }
+
+    _Container container;
+    container.shallow_json =
+        shallow->to_json_string(&changes.error_status, nullptr, 0);
+    if (is_error(changes.error_status))
+    {
+        return false;
+    }
+    if (container.shallow_json != saved->second.shallow_json)
+    {
+        AnyDictionary update = operation("update", path);
+        update["value"]      = shallow;
+        changes.operations.push_back(std::move(update));
+    }
+
+    // Children that stayed at the start and at the end of the list are
+    // kept; those in between are replaced.
+    auto const& old_children = saved->second.children;
+    auto const& children     = children_holder(object)->children();
+    size_t      prefix       = 0;
+    size_t      suffix       = 0;
+    while (prefix < old_children.size() && prefix < children.size()
+           && old_children[prefix].first == children[prefix].value)
+    {
+        ++prefix;
+    }
+    while (suffix < old_children.size() - prefix
+           && suffix < children.size() - prefix
+           && old_children[old_children.size() - 1 - suffix].first
+                  == children[children.size() - 1 - suffix].value)
+    {
+        ++suffix;
+    }
+
+    std::string const child_path = path + children_path(object);
+    size_t const      removed    = old_children.size() - prefix - suffix;
+    size_t const      inserted   = children.size() - prefix - suffix;
+    if (removed || inserted)
+    {
+        AnyVector insert;
+        for (size_t i = prefix; i < prefix + inserted; ++i)
+        {
+            insert.push_back(
+                SerializableObject::Retainer<>(children[i].value));
+            if (!_record(children[i].value, changes))
+            {
+                return false;
+            }
+        }
+        for (size_t i = prefix; i < prefix + removed; ++i)
+        {
+            changes.forgotten.push_back(old_children[i].first);
+        }
+
+        AnyDictionary splice = operation("splice", child_path);
+        splice["index"]      = int64_t(prefix);
+        splice["remove"]     = int64_t(removed);
+        splice["insert"]     = std::move(insert);
+        changes.operations.push_back(std::move(splice));
+    }
+
+    container.children.reserve(children.size());
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        Composable const* child = children[i];
+        container.children.emplace_back(child, child->generation());
+
+        bool const kept = i < prefix || i >= prefix + inserted;
+        size_t const old_index =
+            i < prefix ? i : i - inserted + removed;
+        if (kept && old_children[old_index].second != child->generation()
+            && !_diff(child, child_path + "/" + std::to_string(i), changes))
+        {
+            return false;
+        }
+    }
+    changes.recorded.emplace_back(object, std::move(container));
+    return true;
+}
+
+bool
+DeltaSerializer::_replace(
+    SerializableObject const* object,
+    std::string const&        path,
+    _Changes&                 changes)
+{
+    AnyDictionary replace = operation("replace", path);
+    replace["value"]      = SerializableObject::Retainer<>(object);
+    changes.operations.push_back(std::move(replace));
+
+    changes.forgotten.push_back(object);
+    return _record(object, changes);
+}
+
+void
+DeltaSerializer::_forget(SerializableObject const* object)
+{
+    // Only what was saved is looked at: the object may no longer exist.
+    auto saved = _containers.find(object);
+    if (saved == _containers.end())
+    {
+        return;
+    }
+    std::vector<Child> const children = std::move(saved->second.children);
+    _containers.erase(saved);
+    for (auto const& child: children)
+    {
+        _forget(child.first);
+    }
+}
+
+namespace {
+
+bool
+patch_error(ErrorStatus* error_status, std::string const& details)
+{
+    if (error_status)
+    {
+        *error_status = ErrorStatus(ErrorStatus::MALFORMED_SCHEMA, details);
+    }
+    return false;
+}
+
+template <typename T>
+T const*
+field(AnyDictionary const& dictionary, std::string const& key)
+{
+    auto e = dictionary.find(key);
+    return e != dictionary.end() ? std::any_cast<T>(&e->second) : nullptr;
+}
+
+// The object at path in the document under root, and where it sits: at
+// index in the children of parent, or as the tracks of timeline, or, if
+// neither is set, at the root.
+struct Location
+{
+    SerializableObject* object   = nullptr;
+    Composition*        parent   = nullptr;
+    int                 index    = 0;
+    Timeline*           timeline = nullptr;
+};
+
+bool
+locate(
+    SerializableObject* root,
+    std::string const&  path,
+    Location&           location,
+    ErrorStatus*        error_status)
+{
+    location = Location{ root };
+    for (size_t start = 0; start < path.size();)
+    {
+        if (path.compare(start, strlen(tracks_key), tracks_key) == 0)
+        {
+            auto timeline = fast_cast<Timeline>(location.object);
+            if (!timeline)
+            {
+                return patch_error(error_status, "no tracks at " + path);
+            }
+            location          = Location{ timeline->tracks() };
+            location.timeline = timeline;
+            start += strlen(tracks_key);
+            continue;
+        }
+
+        auto composition = fast_cast<Composition>(location.object);
+        if (!composition
+            || path.compare(start, strlen(children_key), children_key) != 0
+            || start + strlen(children_key) == path.size()
+            || path[start + strlen(children_key)] != '/')
+        {
+            return patch_error(error_status, "no object at " + path);
+        }
+        start += strlen(children_key) + 1;
+
+        char*      end   = nullptr;
+        long const index = std::strtol(path.c_str() + start, &end, 10);
+        if (end == path.c_str() + start || index < 0
+            || size_t(index) >= composition->children().size())
+        {
+            if (error_status)
+            {
+                *error_status = ErrorStatus(ErrorStatus::ILLEGAL_INDEX, path);
+            }
+            return false;
+        }
+        location        = Location{ composition->children()[index].value };
+        location.parent = composition;
+        location.index  = int(index);
+        start           = end - path.c_str();
+    }
+    return true;
+}
+
+// Put object at location, in place of what is there.
+bool
+place(
+    SerializableObject::Retainer<>& root,
+    Location const&                 location,
+    SerializableObject*             object,
+    ErrorStatus*                    error_status)
+{
+    if (location.parent)
+    {
+        auto composable = fast_cast<Composable>(object);
+        return composable
+               && location.parent->set_child(
+                   location.index,
+                   composable,
+                   error_status);
+    }
+    if (location.timeline)
+    {
+        auto stack = fast_cast<Stack>(object);
+        if (!stack)
+        {
+            return patch_error(error_status, "the tracks must be a stack");
+        }
+        location.timeline->set_tracks(stack);
+        return true;
+    }
+    root = object;
+    return true;
+}
+
+bool
+apply_operation(
+    SerializableObject::Retainer<>& root,
+    AnyDictionary const&            operation,
+    ErrorStatus*                    error_status)
+{
+    auto op   = field<std::string>(operation, "op");
+    auto path = field<std::string>(operation, "path");
+    if (!op || !path)
+    {
+        return patch_error(error_status, "operation without an op or path");
+    }
+
+    if (*op == "splice")
+    {
+        // the path is that of the children themselves
+        std::string const holder_path =
+            path->substr(0, path->size() - strlen(children_key));
+        Location location;
+        auto     index  = field<int64_t>(operation, "index");
+        auto     remove = field<int64_t>(operation, "remove");
+        auto     insert = field<AnyVector>(operation, "insert");
+        if (!index || !remove || !insert
+            || holder_path + children_key != *path)
+        {
+            return patch_error(error_status, "malformed splice at " + *path);
+        }
+        if (!locate(root, holder_path, location, error_status))
+        {
+            return false;
+        }
+        auto composition = fast_cast<Composition>(location.object);
+        if (!composition || *index < 0 || *remove < 0
+            || size_t(*index + *remove) > composition->children().size())
+        {
+            return patch_error(error_status, "malformed splice at " + *path);
+        }
+
+        for (int64_t i = 0; i < *remove; ++i)
+        {
+            composition->remove_child(int(*index), error_status);
+        }
+        int i = int(*index);
+        for (auto const& e: *insert)
+        {
+            auto child = std::any_cast<SerializableObject::Retainer<>>(&e);
+            auto composable =
+                child ? fast_cast<Composable>(child->value) : nullptr;
+            if (!composable
+                || !composition->insert_child(i++, composable, error_status))
+            {
+                return patch_error(
+                    error_status,
+                    "cannot insert a child at " + *path);
+            }
+        }
+        return true;
+    }
+
+    auto value = field<SerializableObject::Retainer<>>(operation, "value");
+    if ((*op != "replace" && *op != "update") || !value || !value->value)
+    {
+        return patch_error(error_status, "malformed operation at " + *path);
+    }
+
+    Location location;
+    if (!locate(root, *path, location, error_status))
+    {
+        return false;
+    }
+
+    if (*op == "update")
+    {
+        Composition* from = children_holder(location.object);
+        Composition* to   = children_holder(value->value);
+        if (!from || !to)
+        {
+            return patch_error(error_status, "cannot update " + *path);
+        }
+        auto const children = from->children();
+        from->clear_children();
+        for (auto const& child: children)
+        {
+            if (!to->append_child(child, error_status))
+            {
+                return false;
+            }
+        }
+    }
+
+    if (!place(root, location, value->value, error_status))
+    {
+        return is_error(error_status)
+                   ? false
+                   : patch_error(error_status, "cannot replace " + *path);
+    }
+    return true;
+}
+
+} // namespace
+
+SerializableObject::Retainer<>
+apply_json_patch(
+    SerializableObject* root,
+    std::string const&  patch,
+    ErrorStatus*        error_status)
+{
+    std::any value;
+    if (!deserialize_json_from_string(patch, &value, error_status))
+    {
+        return nullptr;
+    }
+
+    auto operations = std::any_cast<AnyVector>(&value);
+    if (!operations)
+    {
+        patch_error(error_status, "a patch must be a list of operations");
+        return nullptr;
+    }
+
+    SerializableObject::Retainer<> result(root);
+    for (auto const& e: *operations)
+    {
+        auto operation = std::any_cast<AnyDictionary>(&e);
+        if (!operation)
+        {
+            patch_error(error_status, "an operation must be a dictionary");
+            return nullptr;
+        }
+        if (!apply_operation(result, *operation, error_status))
+        {
+            return nullptr;
+        }
+    }
+    return result;
+}
+
+std::string
+compact_json_patches(
+    std::string const&              base,
+    std::vector<std::string> const& patches,
+    ErrorStatus*                    error_status,
+    int                             indent)
+{
+    std::any value;
+    if (!deserialize_json_from_string(base, &value, error_status))
+    {
+        return std::string();
+    }
+    auto root = std::any_cast<SerializableObject::Retainer<>>(&value);
+    if (!root || !root->value)
+    {
+        patch_error(error_status, "the base must hold an object");
+        return std::string();
+    }
+
+    SerializableObject::Retainer<> result = *root;
+    value.reset();
+    for (auto const& patch: patches)
+    {
+        result = apply_json_patch(result, patch, error_status);
+        if (!result)
+        {
+            return std::string();
+        }
+    }
+    return serialize_json_to_string(
+        std::any(result),
+        nullptr,
+        error_status,
+        indent);
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
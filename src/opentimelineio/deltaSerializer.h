@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentimelineio/serializableObject.h"
+#include "opentimelineio/version.h"
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+/// Saves a document that is being edited as a base followed by patches,
+/// so that saving it again after an edit costs about as much as the edit,
+/// not as the whole document.
+///
+/// base_json() writes the whole document. Each patch_json() after that
+/// writes only what changed since the previous base or patch, as a JSON
+/// list of operations in the spirit of JSON Patch:
+///
+///   { "op": "replace", "path": P, "value": OBJECT }
+///       P now holds OBJECT.
+///   { "op": "update", "path": P, "value": OBJECT }
+///       P now holds OBJECT, a composition (or timeline) written without
+///       its children, which takes over the children P held before.
+///   { "op": "splice", "path": P, "index": I, "remove": N,
+///     "insert": [ OBJECT, ... ] }
+///       The N children of P from index I on are replaced by the
+///       inserted objects.
+///
+/// Paths address objects by where they sit in the document, as in JSON
+/// Pointer: "" is the root, "/tracks" is the tracks stack of a timeline,
+/// and "/children/3" is the fourth child of a composition, so that
+/// "/tracks/children/0/children/3" is the fourth item of the first track.
+/// Each operation sees the document as the operations before it left it.
+///
+/// apply_json_patch() and compact_json_patches() put a base and its
+/// patches back together.
+///
+/// Changes are found through generations (see
+/// SerializableObject::generation()): whatever has kept its generation
+/// since the previous save is skipped without being looked at, so only
+/// the changes that generations count are saved. The document must only
+/// be read and changed on the thread that saves it.
+class DeltaSerializer
+{
+public:
+    explicit DeltaSerializer(SerializableObject const* root);
+
+    /// The whole document, as serialize_json_to_string would write it,
+    /// which the patches that follow are relative to. If the operation
+    /// fails, an empty string is returned and error_status is set
+    /// appropriately.
+    std::string base_json(ErrorStatus* error_status = nullptr, int indent = 4);
+
+    /// The changes to the document since the previous base or patch. If
+    /// nothing has changed, the list is empty; if no base has been written,
+    /// the patch replaces the whole document. If the operation fails, an
+    /// empty string is returned, error_status is set appropriately, and the
+    /// next patch is still relative to the previous one.
+    std::string patch_json(ErrorStatus* error_status = nullptr, int indent = 4);
+
+private:
+    using Child = std::pair<SerializableObject const*, uint64_t>;
+
+    // What was saved of a composition, or a timeline: its fields besides
+    // its children, and its children.
+    struct _Container
+    {
+        std::string        shallow_json;
+        std::vector<Child> children;
+    };
+
+    struct _Changes;
+
+    bool _record(SerializableObject const* object, _Changes& changes);
+    bool _diff(
+        SerializableObject const* object,
+        std::string const&        path,
+        _Changes&                 changes);
+    bool _replace(
+        SerializableObject const* object,
+        std::string const&        path,
+        _Changes&                 changes);
+    void _forget(SerializableObject const* object);
+
+    SerializableObject const* _root;
+    uint64_t                  _root_generation;
+
+    std::unordered_map<SerializableObject const*, _Container> _containers;
+};
+
+/// Apply a patch written by DeltaSerializer::patch_json() to root, which
+/// must hold the document as the patch found it (the base, or the result
+/// of applying the patches before this one). Returns the root of the
+/// patched document: root itself, unless the patch replaced it. If the
+/// operation fails, null is returned and error_status is set
+/// appropriately; root may then have been partly patched.
+SerializableObject::Retainer<> apply_json_patch(
+    SerializableObject* root,
+    std::string const&  patch,
+    ErrorStatus*        error_status = nullptr);
+
+/// Put a base, as written by DeltaSerializer::base_json(), together with
+/// the patches written after it, in order, and return the document they
+/// describe, as a new base. If the operation fails, an empty string is
+/// returned and error_status is set appropriately.
+std::string compact_json_patches(
+    std::string const&              base,
+    std::vector<std::string> const& patches,
+    ErrorStatus*                    error_status = nullptr,
+    int                             indent       = 4);
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -4,6 +4,7 @@
 #include "opentime/rationalTime.h"
 #include "opentime/timeRange.h"
 #include "opentime/timeTransform.h"
+#include "opentimelineio/instrumentation.h"
 #include "opentimelineio/serializableObject.h"
 #include "opentimelineio/serializableObjectWithMetadata.h"
 #include "stringUtils.h"
@@ -203,11 +204,11 @@ public:
             auto& top = _stack.back();
             if (top.is_dict)
             {
-                top.dict.emplace(_stack.back().cur_key, a);
+                top.dict.emplace(_stack.back().cur_key, std::move(a));
             }
             else
             {
-                top.array.emplace_back(a);
+                top.array.emplace_back(std::move(a));
             }
         }
         return true;
@@ -670,6 +671,7 @@ SerializableObject::Reader::_decode(_Resolver& resolver)
             {
                 resolver.object_for_id[ref_id] = so;
             }
+            OTIO_COUNT("objects decoded", 1);
             resolver.data_for_object.emplace(so, std::move(_dict));
             resolver.line_number_for_object[so] = _line_number;
             return std::any(SerializableObject::Retainer<>(so));
@@ -738,6 +740,29 @@ SerializableObject::Reader::read(std::string const& key, AnyDictionary* value)
     return _fetch(key, value);
 }
 
+bool
+SerializableObject::Reader::read(
+    std::string const&   key,
+    SharedAnyDictionary* value)
+{
+    // a clone is handed the original's dictionary to share
+    auto e = _dict.find(key);
+    if (e != _dict.end() && e->second.type() == typeid(SharedAnyDictionary))
+    {
+        *value = std::move(std::any_cast<SharedAnyDictionary&>(e->second));
+        _dict.erase(e);
+        return true;
+    }
+
+    AnyDictionary dictionary;
+    if (!_fetch(key, &dictionary))
+    {
+        return false;
+    }
+    *value = SharedAnyDictionary(std::move(dictionary));
+    return true;
+}
+
 bool
 SerializableObject::Reader::read(std::string const& key, AnyVector* value)
 {
@@ -855,6 +880,8 @@ deserialize_json_from_string(
     std::any*          destination,
     ErrorStatus*       error_status)
 {
+    OTIO_TRACE_SCOPE("deserialize_json_from_string");
+
     OTIO_rapidjson::Reader                            reader;
     OTIO_rapidjson::StringStream                      ss(input.c_str());
     OTIO_rapidjson::CursorStreamWrapper<decltype(ss)> csw(ss);
@@ -896,6 +923,7 @@ deserialize_json_from_file(
     std::any*          destination,
     ErrorStatus*       error_status)
 {
+    OTIO_TRACE_SCOPE("deserialize_json_from_file");
 
     FILE* fp = nullptr;
 #if defined(_WINDOWS)
@@ -30,11 +30,16 @@ public:
     void set_effect_name(std::string const& effect_name)
     {
         _effect_name = effect_name;
+        _changed();
     }
 
     bool enabled() const { return _enabled; };
 
-    void set_enabled(bool enabled) { _enabled = enabled; }  
+    void set_enabled(bool enabled)
+    {
+        _enabled = enabled;
+        _changed();
+    }
 
 protected:
     virtual ~Effect();
@@ -5,70 +5,119 @@
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
 
-std::string
-ErrorStatus::outcome_to_string(Outcome o)
+static char const*
+_outcome_c_str(ErrorStatus::Outcome o)
 {
     switch (o)
     {
-        case OK:
-            return std::string();
-        case NOT_IMPLEMENTED:
+        case ErrorStatus::OK:
+            return "";
+        case ErrorStatus::NOT_IMPLEMENTED:
             return "method not implemented for this class";
-        case UNRESOLVED_OBJECT_REFERENCE:
+        case ErrorStatus::UNRESOLVED_OBJECT_REFERENCE:
             return "unresolved object reference encountered";
-        case DUPLICATE_OBJECT_REFERENCE:
+        case ErrorStatus::DUPLICATE_OBJECT_REFERENCE:
             return "duplicate object reference encountered";
-        case MALFORMED_SCHEMA:
+        case ErrorStatus::MALFORMED_SCHEMA:
             return "schema specifier is malformed/illegal";
-        case JSON_PARSE_ERROR:
+        case ErrorStatus::JSON_PARSE_ERROR:
             return "JSON parse error";
-        case CHILD_ALREADY_PARENTED:
+        case ErrorStatus::CHILD_ALREADY_PARENTED:
             return "child already has a parent";
-        case FILE_OPEN_FAILED:
+        case ErrorStatus::FILE_OPEN_FAILED:
             return "failed to open file for reading";
-        case FILE_WRITE_FAILED:
+        case ErrorStatus::FILE_WRITE_FAILED:
             return "failed to open file for writing";
-        case SCHEMA_ALREADY_REGISTERED:
+        case ErrorStatus::SCHEMA_ALREADY_REGISTERED:
             return "schema has already been registered";
-        case SCHEMA_NOT_REGISTERED:
+        case ErrorStatus::SCHEMA_NOT_REGISTERED:
             return "schema is not registered/known";
-        case KEY_NOT_FOUND:
+        case ErrorStatus::KEY_NOT_FOUND:
             return "key not present reading from dictionary";
-        case ILLEGAL_INDEX:
+        case ErrorStatus::ILLEGAL_INDEX:
             return "illegal index";
-        case TYPE_MISMATCH:
+        case ErrorStatus::TYPE_MISMATCH:
             return "type mismatch while decoding";
-        case INTERNAL_ERROR:
+        case ErrorStatus::INTERNAL_ERROR:
             return "internal error (aka \"this code has a bug\")";
-        case NOT_DESCENDED_FROM:
+        case ErrorStatus::NOT_DESCENDED_FROM:
             return "item is not a descendent of specified object";
-        case NOT_A_CHILD_OF:
+        case ErrorStatus::NOT_A_CHILD_OF:
             return "item is not a child of specified object";
-        case NOT_AN_ITEM:
+        case ErrorStatus::NOT_AN_ITEM:
             return "object is not descendent of Item type";
-        case SCHEMA_VERSION_UNSUPPORTED:
+        case ErrorStatus::SCHEMA_VERSION_UNSUPPORTED:
             return "unsupported schema version";
-        case NOT_A_CHILD:
+        case ErrorStatus::NOT_A_CHILD:
             return "item has no parent";
-        case CANNOT_COMPUTE_AVAILABLE_RANGE:
+        case ErrorStatus::CANNOT_COMPUTE_AVAILABLE_RANGE:
             return "Cannot compute available range";
-        case INVALID_TIME_RANGE:
+        case ErrorStatus::INVALID_TIME_RANGE:
             return "computed time range would be invalid";
-        case OBJECT_WITHOUT_DURATION:
+        case ErrorStatus::OBJECT_WITHOUT_DURATION:
             return "cannot compute duration on this type of object";
-        case CANNOT_TRIM_TRANSITION:
+        case ErrorStatus::CANNOT_TRIM_TRANSITION:
             return "cannot trim transition";
-        case CANNOT_COMPUTE_BOUNDS:
+        case ErrorStatus::CANNOT_COMPUTE_BOUNDS:
             return "cannot compute image bounds";
-        case MEDIA_REFERENCES_DO_NOT_CONTAIN_ACTIVE_KEY:
+        case ErrorStatus::MEDIA_REFERENCES_DO_NOT_CONTAIN_ACTIVE_KEY:
             return "active key not found in media references";
-        case MEDIA_REFERENCES_CONTAIN_EMPTY_KEY:
+        case ErrorStatus::MEDIA_REFERENCES_CONTAIN_EMPTY_KEY:
             return "the media references cannot contain an empty key";
-        case NOT_A_GAP:
+        case ErrorStatus::NOT_A_GAP:
             return "object is not descendent of Gap type";
         default:
             return "unknown/illegal ErrorStatus::Outcome code";
     };
 }
 
+std::string
+ErrorStatus::outcome_to_string(Outcome o)
+{
+    return outcome_text(o);
+}
+
+std::string const&
+ErrorStatus::outcome_text(Outcome o)
+{
+    // the texts are made once, the first time any of them is needed; the
+    // last one is for codes that are not outcomes
+    static std::string const texts[] = {
+        _outcome_c_str(OK),
+        _outcome_c_str(NOT_IMPLEMENTED),
+        _outcome_c_str(UNRESOLVED_OBJECT_REFERENCE),
+        _outcome_c_str(DUPLICATE_OBJECT_REFERENCE),
+        _outcome_c_str(MALFORMED_SCHEMA),
+        _outcome_c_str(JSON_PARSE_ERROR),
+        _outcome_c_str(CHILD_ALREADY_PARENTED),
+        _outcome_c_str(FILE_OPEN_FAILED),
+        _outcome_c_str(FILE_WRITE_FAILED),
+        _outcome_c_str(SCHEMA_ALREADY_REGISTERED),
+        _outcome_c_str(SCHEMA_NOT_REGISTERED),
+        _outcome_c_str(SCHEMA_VERSION_UNSUPPORTED),
+        _outcome_c_str(KEY_NOT_FOUND),
+        _outcome_c_str(ILLEGAL_INDEX),
+        _outcome_c_str(TYPE_MISMATCH),
+        _outcome_c_str(INTERNAL_ERROR),
+        _outcome_c_str(NOT_AN_ITEM),
+        _outcome_c_str(NOT_A_CHILD_OF),
+        _outcome_c_str(NOT_A_CHILD),
+        _outcome_c_str(NOT_DESCENDED_FROM),
+        _outcome_c_str(CANNOT_COMPUTE_AVAILABLE_RANGE),
+        _outcome_c_str(INVALID_TIME_RANGE),
+        _outcome_c_str(OBJECT_WITHOUT_DURATION),
+        _outcome_c_str(CANNOT_TRIM_TRANSITION),
+        _outcome_c_str(OBJECT_CYCLE),
+        _outcome_c_str(CANNOT_COMPUTE_BOUNDS),
+        _outcome_c_str(MEDIA_REFERENCES_DO_NOT_CONTAIN_ACTIVE_KEY),
+        _outcome_c_str(MEDIA_REFERENCES_CONTAIN_EMPTY_KEY),
+        _outcome_c_str(NOT_A_GAP),
+        _outcome_c_str(Outcome(NOT_A_GAP + 1))
+    };
+    constexpr int count = sizeof(texts) / sizeof(texts[0]);
+    static_assert(count == NOT_A_GAP + 2, "an outcome has no text");
+
+    return texts[(o >= OK && o <= NOT_A_GAP) ? o : count - 1];
+}
+
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -4,12 +4,137 @@
 #pragma once
 
 #include "opentimelineio/version.h"
+#include <ostream>
 #include <string>
+#include <utility>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
 
 class SerializableObject;
 
+// The details or full description of an ErrorStatus, which reads as a
+// std::string. The text of a built-in outcome is not copied: it refers to
+// the outcome's static text until it is changed, or bound to a non-const
+// std::string&. Const reads never change it, so one ErrorStatus can be read
+// from several threads at once.
+class ErrorText
+{
+public:
+    ErrorText() = default;
+
+    ErrorText(std::string text)
+        : _text(std::move(text))
+    {}
+
+    ErrorText(char const* text)
+        : _text(text)
+    {}
+
+    // Refers to static_text, which must outlive this.
+    static ErrorText refer_to(std::string const& static_text) noexcept
+    {
+        ErrorText text;
+        text._static_text = &static_text;
+        return text;
+    }
+
+    std::string const& str() const noexcept
+    {
+        return _static_text ? *_static_text : _text;
+    }
+
+    operator std::string const&() const noexcept { return str(); }
+
+    operator std::string&() { return _own(); }
+
+    char const* c_str() const noexcept { return str().c_str(); }
+
+    bool empty() const noexcept { return str().empty(); }
+
+    size_t size() const noexcept { return str().size(); }
+
+    ErrorText& operator+=(std::string const& more)
+    {
+        _own() += more;
+        return *this;
+    }
+
+    ErrorText& operator+=(char const* more)
+    {
+        _own() += more;
+        return *this;
+    }
+
+    friend bool operator==(ErrorText const& lhs, ErrorText const& rhs)
+    {
+        return lhs.str() == rhs.str();
+    }
+
+    friend bool operator==(ErrorText const& lhs, std::string const& rhs)
+    {
+        return lhs.str() == rhs;
+    }
+
+    friend bool operator==(ErrorText const& lhs, char const* rhs)
+    {
+        return lhs.str() == rhs;
+    }
+
+    friend bool operator!=(ErrorText const& lhs, ErrorText const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator!=(ErrorText const& lhs, std::string const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator!=(ErrorText const& lhs, char const* rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend std::string operator+(ErrorText const& lhs, std::string const& rhs)
+    {
+        return lhs.str() + rhs;
+    }
+
+    friend std::string operator+(ErrorText const& lhs, char const* rhs)
+    {
+        return lhs.str() + rhs;
+    }
+
+    friend std::string operator+(std::string const& lhs, ErrorText const& rhs)
+    {
+        return lhs + rhs.str();
+    }
+
+    friend std::string operator+(char const* lhs, ErrorText const& rhs)
+    {
+        return lhs + rhs.str();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, ErrorText const& text)
+    {
+        return os << text.str();
+    }
+
+private:
+    std::string& _own()
+    {
+        if (_static_text)
+        {
+            _text        = *_static_text;
+            _static_text = nullptr;
+        }
+        return _text;
+    }
+
+    std::string const* _static_text = nullptr;
+    std::string        _text;
+};
+
 struct ErrorStatus
 {
     enum Outcome
@@ -50,9 +175,12 @@ struct ErrorStatus
         , object_details(nullptr)
     {}
 
+    // The text of an outcome is its static text from outcome_text(), so
+    // making, copying and reading a status set to an outcome alone never
+    // allocates.
     ErrorStatus(Outcome in_outcome)
         : outcome(in_outcome)
-        , details(outcome_to_string(in_outcome))
+        , details(ErrorText::refer_to(outcome_text(in_outcome)))
         , full_description(details)
         , object_details(nullptr)
     {}
@@ -63,7 +191,7 @@ struct ErrorStatus
         SerializableObject const* object = nullptr)
         : outcome(in_outcome)
         , details(in_details)
-        , full_description(outcome_to_string(in_outcome) + ": " + in_details)
+        , full_description(outcome_text(in_outcome) + ": " + in_details)
         , object_details(object)
     {}
 
@@ -74,11 +202,15 @@ struct ErrorStatus
     }
 
     Outcome                   outcome;
-    std::string               details;
-    std::string               full_description;
+    ErrorText                 details;
+    ErrorText                 full_description;
     SerializableObject const* object_details;
 
     static std::string outcome_to_string(Outcome);
+
+    // The description of an outcome, as a string that lives as long as the
+    // program.
+    static std::string const& outcome_text(Outcome);
 };
 
 // Check whether the given ErrorStatus is an error.
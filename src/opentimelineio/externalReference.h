@@ -31,6 +31,7 @@ public:
     void set_target_url(std::string const& target_url)
     {
         _target_url = target_url;
+        _changed();
     }
 
 protected:
@@ -0,0 +1,322 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "opentimelineio/filterAlgorithm.h"
+#include "opentimelineio/composition.h"
+#include "opentimelineio/stack.h"
+#include "opentimelineio/timeline.h"
+#include "opentimelineio/track.h"
+
+#include <set>
+#include <unordered_map>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+namespace {
+
+// Builds the filtered copy of a tree while it walks it. An object is only
+// copied when the walk reaches its parent, and a composition is copied
+// without its children; they are copied when the walk reaches it, just
+// before it is filtered, so that the filter sees it with its direct
+// children. A timeline is treated as a composition whose only child is its
+// tracks stack.
+//
+// The children of a composition are taken out of it once it has been
+// filtered, and what the filter returns for them is put back in one go.
+class Filter
+{
+public:
+    Filter(
+        SequenceFilterFunction const& filter,
+        PrunePredicate const&         prune,
+        bool                          with_neighbors)
+        : _filter_function(filter)
+        , _prune(prune)
+        , _with_neighbors(with_neighbors)
+    {}
+
+    FilterResult filter_root(SerializableObject const* root)
+    {
+        SerializableObject::Retainer<> copy(_copy_of(root));
+        if (is_error(error))
+        {
+            return FilterResult();
+        }
+
+        FilterResult result = _filter(copy, nullptr, nullptr);
+        if (!result.empty())
+        {
+            _filter_children_of(copy);
+        }
+        return is_error(error) ? FilterResult() : result;
+    }
+
+    ErrorStatus error;
+
+private:
+    // The original of a copy the walk has not reached yet. The copy is
+    // retained so that its address is not reused while it is in _originals.
+    struct _Original
+    {
+        SerializableObject::Retainer<> copy;
+        SerializableObject const*      object;
+        bool                           children_copied;
+    };
+
+    // Copies original, leaving out the children of a composition or the
+    // tracks of a timeline.
+    SerializableObject* _copy_of(SerializableObject const* original)
+    {
+        SerializableObject* copy = nullptr;
+        if (auto composition = fast_cast<Composition>(original))
+        {
+            copy = composition->clone_without_children(&error);
+        }
+        else if (auto timeline = dynamic_cast<Timeline const*>(original))
+        {
+            copy = timeline->clone_without_children(&error);
+        }
+        else
+        {
+            copy = original->clone(&error);
+        }
+
+        if (copy)
+        {
+            _originals[copy] = _Original{ copy, original, false };
+        }
+        return copy;
+    }
+
+    // Copies the children of original into copy, if it is a composition
+    // or timeline.
+    bool _copy_children(
+        SerializableObject*       copy,
+        SerializableObject const* original)
+    {
+        if (auto timeline = dynamic_cast<Timeline*>(copy))
+        {
+            Stack*       tracks = timeline->tracks();
+            Stack const* original_tracks =
+                dynamic_cast<Timeline const*>(original)->tracks();
+            _originals[tracks] = _Original{ tracks, original_tracks, true };
+            return _copy_children(tracks, original_tracks);
+        }
+
+        auto composition = fast_cast<Composition>(copy);
+        if (!composition)
+        {
+            return true;
+        }
+
+        auto const& children = fast_cast<Composition>(original)->children();
+        std::vector<Composable*> copies;
+        copies.reserve(children.size());
+        for (auto const& child: children)
+        {
+            auto child_copy = fast_cast<Composable>(_copy_of(child));
+            if (!child_copy)
+            {
+                return false;
+            }
+            copies.push_back(child_copy);
+        }
+        return composition->set_children(copies, &error);
+    }
+
+    // Filters an object of the copy. The prune predicate is passed its
+    // original, or the object itself if the filter created it.
+    FilterResult _filter(
+        SerializableObject* object,
+        Composable*         previous,
+        Composable*         next)
+    {
+        SerializableObject const* original        = object;
+        bool                      children_copied = true;
+        auto                      found           = _originals.find(object);
+        if (found != _originals.end())
+        {
+            original        = found->second.object;
+            children_copied = found->second.children_copied;
+            _originals.erase(found);
+        }
+
+        if ((_prune && _prune(original))
+            || (!children_copied && !_copy_children(object, original)))
+        {
+            return FilterResult();
+        }
+        return _filter_function(previous, object, next);
+    }
+
+    // The children of an object that was not pruned are filtered even if
+    // the filter replaced it, as they always have been; only what is still
+    // in the copy ends up in the result.
+    void _filter_children_of(SerializableObject* object)
+    {
+        if (auto composition = fast_cast<Composition>(object))
+        {
+            _filter_children(composition);
+        }
+        else if (auto timeline = dynamic_cast<Timeline*>(object))
+        {
+            _filter_tracks(timeline);
+        }
+    }
+
+    void _filter_children(Composition* composition)
+    {
+        // the neighbors passed to the filter are the children as they were
+        // before any of them was filtered
+        auto const children = composition->children();
+        bool const with_neighbors =
+            _with_neighbors && fast_cast<Track>(composition);
+        composition->clear_children();
+
+        // the results are retained until they are put in the composition
+        FilterResult             results;
+        std::vector<Composable*> filtered;
+        std::set<Composable*>    placed;
+        filtered.reserve(children.size());
+        for (size_t i = 0; i < children.size(); ++i)
+        {
+            Composable* previous = nullptr;
+            Composable* next     = nullptr;
+            if (with_neighbors && i > 0)
+            {
+                previous = children[i - 1];
+            }
+            if (with_neighbors && i + 1 < children.size())
+            {
+                next = children[i + 1];
+            }
+
+            FilterResult const result =
+                _filter(children[i], previous, next);
+            if (is_error(error))
+            {
+                return;
+            }
+            for (auto const& object: result)
+            {
+                auto composable = fast_cast<Composable>(object.value);
+                if (!composable)
+                {
+                    error = ErrorStatus(
+                        ErrorStatus::TYPE_MISMATCH,
+                        "filter result is not a composable",
+                        object.value);
+                    return;
+                }
+                if (composable->parent() || !placed.insert(composable).second)
+                {
+                    error = ErrorStatus(
+                        ErrorStatus::CHILD_ALREADY_PARENTED,
+                        "filter result is already a child",
+                        object.value);
+                    return;
+                }
+                filtered.push_back(composable);
+                results.push_back(object);
+            }
+
+            if (!result.empty())
+            {
+                _filter_children_of(children[i]);
+                if (is_error(error))
+                {
+                    return;
+                }
+            }
+        }
+
+        composition->set_children(filtered, &error);
+    }
+
+    void _filter_tracks(Timeline* timeline)
+    {
+        SerializableObject::Retainer<Stack> tracks(timeline->tracks());
+        FilterResult const result = _filter(tracks, nullptr, nullptr);
+        if (is_error(error))
+        {
+            return;
+        }
+
+        Stack* replacement =
+            result.size() == 1 ? fast_cast<Stack>(result.front().value)
+                               : nullptr;
+        if (!replacement && !result.empty())
+        {
+            error = ErrorStatus(
+                ErrorStatus::TYPE_MISMATCH,
+                "the tracks of a timeline can only be replaced by one stack",
+                timeline);
+            return;
+        }
+        if (replacement != tracks.value)
+        {
+            // a pruned stack leaves the timeline with no tracks
+            timeline->set_tracks(replacement);
+        }
+
+        if (!result.empty())
+        {
+            _filter_children(tracks);
+        }
+    }
+
+    SequenceFilterFunction const& _filter_function;
+    PrunePredicate const&         _prune;
+    bool                          _with_neighbors;
+
+    std::unordered_map<SerializableObject const*, _Original> _originals;
+};
+
+} // namespace
+
+static FilterResult
+_run_filter(
+    SerializableObject const*     root,
+    SequenceFilterFunction const& filter,
+    PrunePredicate const&         prune,
+    bool                          with_neighbors,
+    ErrorStatus*                  error_status)
+{
+    Filter       runner(filter, prune, with_neighbors);
+    FilterResult result = runner.filter_root(root);
+    if (is_error(runner.error))
+    {
+        if (error_status)
+        {
+            *error_status = runner.error;
+        }
+        return FilterResult();
+    }
+    return result;
+}
+
+FilterResult
+filtered_composition(
+    SerializableObject const* root,
+    FilterFunction const&     filter,
+    PrunePredicate const&     prune,
+    ErrorStatus*              error_status)
+{
+    SequenceFilterFunction unary_filter =
+        [&filter](Composable*, SerializableObject* object, Composable*) {
+            return filter(object);
+        };
+    return _run_filter(root, unary_filter, prune, false, error_status);
+}
+
+FilterResult
+filtered_with_sequence_context(
+    SerializableObject const*     root,
+    SequenceFilterFunction const& filter,
+    PrunePredicate const&         prune,
+    ErrorStatus*                  error_status)
+{
+    return _run_filter(root, filter, prune, true, error_status);
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentimelineio/composable.h"
+#include "opentimelineio/version.h"
+
+#include <functional>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+/// The objects that take the place of a filtered object, in order.
+///
+/// Returning the object itself keeps it, and an empty result prunes it.
+using FilterResult = std::vector<SerializableObject::Retainer<>>;
+
+/// Filters the copy of one object.
+using FilterFunction = std::function<FilterResult(SerializableObject* object)>;
+
+/// Filters the copy of one object, given the copies of its neighbors when
+/// it is the child of a track (and nullptr otherwise).
+using SequenceFilterFunction = std::function<FilterResult(
+    Composable*         previous,
+    SerializableObject* object,
+    Composable*         next)>;
+
+/// Returns true for objects that are pruned without calling the filter.
+/// Unlike the filter, it is passed the objects of the original, or the
+/// objects the filter created.
+using PrunePredicate = std::function<bool(SerializableObject const* object)>;
+
+/// Filter a copy of root and its children with filter.
+///
+/// The objects of root are visited depth first, starting with root. If
+/// prune returns true for an object it is pruned; otherwise a copy of it is
+/// passed to filter, and whatever filter returns takes its place. The
+/// children of a pruned object are neither visited nor copied.
+///
+/// A composition, or the tracks of a timeline, is passed to filter with
+/// copies of its direct children; their own children are copied when they
+/// are visited in turn. The children are filtered afterwards, once they
+/// have all been taken out of the composition, and what filter returns for
+/// them is put back in at the end. If filter replaces a composition by
+/// other objects, its children are still visited, but do not end up in the
+/// result.
+///
+/// The result is what filter returned for root. If an error occurs, such
+/// as filter returning an object that cannot be added to a composition,
+/// the result is empty and error_status is set appropriately.
+FilterResult filtered_composition(
+    SerializableObject const* root,
+    FilterFunction const&     filter,
+    PrunePredicate const&     prune        = nullptr,
+    ErrorStatus*              error_status = nullptr);
+
+/// Filter a copy of root and its children as filtered_composition() does,
+/// passing filter the copies of the previous and next children of each
+/// child of a track as well.
+///
+/// The neighbors are always the copies of the original neighbors, not
+/// what earlier calls to filter returned. Like the object itself, they are
+/// out of the track when filter is called.
+FilterResult filtered_with_sequence_context(
+    SerializableObject const*     root,
+    SequenceFilterFunction const& filter,
+    PrunePredicate const&         prune        = nullptr,
+    ErrorStatus*                  error_status = nullptr);
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -0,0 +1,334 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentimelineio/version.h"
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+/**
+ * A FlatMap has the subset of the std::map API that AnyDictionary exposes,
+ * but keeps its entries sorted by key in a single vector.  A map costs one
+ * allocation however many entries it holds, lookups are binary searches
+ * over adjacent memory, and moving a map moves only the vector.  Iteration
+ * is in key order, exactly as for std::map.
+ *
+ * Unlike std::map:
+ *   - inserting an entry invalidates every iterator and reference into
+ *     the map, since the vector may be reallocated; erasing an entry
+ *     invalidates those to it and to every entry after it;
+ *   - value_type is std::pair<Key, T>, whose key must not be modified
+ *     through an iterator;
+ *   - Compare must be stateless.
+ *
+ * Entries are most often added in key order (JSON written by OTIO has
+ * sorted keys), so appending is checked for first and is amortized O(1).
+ *
+ * The entries are kept in key order rather than insertion order, and on
+ * the heap rather than inline, so that iteration, JSON output and
+ * lower_bound()/upper_bound() stay those of std::map, and so that a
+ * FlatMap stays the size of one vector wherever an AnyDictionary is held.
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class FlatMap
+{
+    using Storage = std::vector<std::pair<Key, T>>;
+
+public:
+    using key_type               = Key;
+    using mapped_type            = T;
+    using value_type             = std::pair<Key, T>;
+    using key_compare            = Compare;
+    using allocator_type         = std::allocator<value_type>;
+    using reference              = value_type&;
+    using const_reference        = value_type const&;
+    using pointer                = value_type*;
+    using const_pointer          = value_type const*;
+    using iterator               = typename Storage::iterator;
+    using const_iterator         = typename Storage::const_iterator;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using size_type              = typename Storage::size_type;
+    using difference_type        = typename Storage::difference_type;
+
+    class value_compare
+    {
+    public:
+        bool operator()(const_reference lhs, const_reference rhs) const
+        {
+            return Compare()(lhs.first, rhs.first);
+        }
+    };
+
+    FlatMap() = default;
+
+    template <typename InputIt>
+    FlatMap(InputIt first, InputIt last)
+    {
+        insert(first, last);
+    }
+
+    FlatMap(std::initializer_list<value_type> ilist)
+    {
+        insert(ilist);
+    }
+
+    FlatMap& operator=(std::initializer_list<value_type> ilist)
+    {
+        clear();
+        insert(ilist);
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept
+    {
+        return _entries.get_allocator();
+    }
+
+    T& at(Key const& key)
+    {
+        auto it = find(key);
+        if (it == end())
+        {
+            throw std::out_of_range("FlatMap::at: key not found");
+        }
+        return it->second;
+    }
+
+    T const& at(Key const& key) const
+    {
+        auto it = find(key);
+        if (it == end())
+        {
+            throw std::out_of_range("FlatMap::at: key not found");
+        }
+        return it->second;
+    }
+
+    T& operator[](Key const& key) { return _try_emplace(key).first->second; }
+
+    T& operator[](Key&& key)
+    {
+        return _try_emplace(std::move(key)).first->second;
+    }
+
+    iterator       begin() noexcept { return _entries.begin(); }
+    const_iterator begin() const noexcept { return _entries.begin(); }
+    const_iterator cbegin() const noexcept { return _entries.cbegin(); }
+    iterator       end() noexcept { return _entries.end(); }
+    const_iterator end() const noexcept { return _entries.end(); }
+    const_iterator cend() const noexcept { return _entries.cend(); }
+
+    reverse_iterator       rbegin() noexcept { return _entries.rbegin(); }
+    const_reverse_iterator rbegin() const noexcept { return _entries.rbegin(); }
+    const_reverse_iterator crbegin() const noexcept
+    {
+        return _entries.crbegin();
+    }
+    reverse_iterator       rend() noexcept { return _entries.rend(); }
+    const_reverse_iterator rend() const noexcept { return _entries.rend(); }
+    const_reverse_iterator crend() const noexcept { return _entries.crend(); }
+
+    bool      empty() const noexcept { return _entries.empty(); }
+    size_type size() const noexcept { return _entries.size(); }
+    size_type max_size() const noexcept { return _entries.max_size(); }
+    size_type capacity() const noexcept { return _entries.capacity(); }
+
+    void clear() noexcept { _entries.clear(); }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        value_type value(std::forward<Args>(args)...);
+        return _insert(lower_bound(value.first), std::move(value));
+    }
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args)
+    {
+        value_type value(std::forward<Args>(args)...);
+        return _insert(_position(hint, value.first), std::move(value)).first;
+    }
+
+    std::pair<iterator, bool> insert(value_type const& value)
+    {
+        return emplace(value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        return emplace(std::move(value));
+    }
+
+    template <
+        typename P,
+        typename =
+            std::enable_if_t<std::is_constructible<value_type, P&&>::value>>
+    std::pair<iterator, bool> insert(P&& value)
+    {
+        return emplace(std::forward<P>(value));
+    }
+
+    iterator insert(const_iterator hint, value_type const& value)
+    {
+        return emplace_hint(hint, value);
+    }
+
+    iterator insert(const_iterator hint, value_type&& value)
+    {
+        return emplace_hint(hint, std::move(value));
+    }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+        {
+            emplace(*first);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> ilist)
+    {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    iterator erase(const_iterator pos) { return _entries.erase(pos); }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        return _entries.erase(first, last);
+    }
+
+    size_type erase(Key const& key)
+    {
+        auto it = find(key);
+        if (it == end())
+        {
+            return 0;
+        }
+        _entries.erase(it);
+        return 1;
+    }
+
+    void swap(FlatMap& other) noexcept { _entries.swap(other._entries); }
+
+    size_type count(Key const& key) const { return find(key) != end(); }
+
+    iterator find(Key const& key)
+    {
+        auto it = lower_bound(key);
+        return (it != end() && !Compare()(key, it->first)) ? it : end();
+    }
+
+    const_iterator find(Key const& key) const
+    {
+        auto it = lower_bound(key);
+        return (it != end() && !Compare()(key, it->first)) ? it : end();
+    }
+
+    std::pair<iterator, iterator> equal_range(Key const& key)
+    {
+        return { lower_bound(key), upper_bound(key) };
+    }
+
+    std::pair<const_iterator, const_iterator>
+    equal_range(Key const& key) const
+    {
+        return { lower_bound(key), upper_bound(key) };
+    }
+
+    iterator lower_bound(Key const& key)
+    {
+        return _entries.begin() + _lower_bound_index(key);
+    }
+
+    const_iterator lower_bound(Key const& key) const
+    {
+        return _entries.begin() + _lower_bound_index(key);
+    }
+
+    iterator upper_bound(Key const& key)
+    {
+        return std::upper_bound(begin(), end(), key, _key_before_entry);
+    }
+
+    const_iterator upper_bound(Key const& key) const
+    {
+        return std::upper_bound(begin(), end(), key, _key_before_entry);
+    }
+
+    key_compare   key_comp() const { return key_compare(); }
+    value_compare value_comp() const { return value_compare(); }
+
+private:
+    static bool _entry_before_key(const_reference entry, Key const& key)
+    {
+        return Compare()(entry.first, key);
+    }
+
+    static bool _key_before_entry(Key const& key, const_reference entry)
+    {
+        return Compare()(key, entry.first);
+    }
+
+    difference_type _lower_bound_index(Key const& key) const
+    {
+        if (_entries.empty() || _entry_before_key(_entries.back(), key))
+        {
+            return difference_type(_entries.size());
+        }
+        return std::lower_bound(
+                   _entries.begin(),
+                   _entries.end(),
+                   key,
+                   _entry_before_key)
+               - _entries.begin();
+    }
+
+    // The insertion position of key, which is hint if hint is right.
+    iterator _position(const_iterator hint, Key const& key)
+    {
+        if ((hint == _entries.cbegin() || _entry_before_key(*(hint - 1), key))
+            && (hint == _entries.cend() || _key_before_entry(key, *hint)))
+        {
+            return _entries.begin() + (hint - _entries.cbegin());
+        }
+        return lower_bound(key);
+    }
+
+    // Insert value at pos, the lower bound of its key, unless the key is
+    // already there.
+    std::pair<iterator, bool> _insert(iterator pos, value_type&& value)
+    {
+        if (pos != end() && !Compare()(value.first, pos->first))
+        {
+            return { pos, false };
+        }
+        return { _entries.insert(pos, std::move(value)), true };
+    }
+
+    template <typename K>
+    std::pair<iterator, bool> _try_emplace(K&& key)
+    {
+        auto pos = lower_bound(key);
+        if (pos != end() && !Compare()(key, pos->first))
+        {
+            return { pos, false };
+        }
+        return { _entries.emplace(pos, std::forward<K>(key), T()), true };
+    }
+
+    Storage _entries;
+};
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -15,7 +15,9 @@ GeneratorReference::GeneratorReference(
     : Parent(name, available_range, metadata, available_image_bounds)
     , _generator_kind(generator_kind)
     , _parameters(parameters)
-{}
+{
+    _parameters.set_owner(this);
+}
 
 GeneratorReference::~GeneratorReference()
 {}
@@ -33,8 +33,11 @@ public:
     void set_generator_kind(std::string const& generator_kind)
     {
         _generator_kind = generator_kind;
+        _changed();
     }
 
+    // Writes made through the dictionary returned count as modifications
+    // of this reference.
     AnyDictionary& parameters() noexcept { return _parameters; }
 
     AnyDictionary parameters() const noexcept { return _parameters; }
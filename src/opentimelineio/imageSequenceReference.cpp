@@ -3,6 +3,8 @@
 
 #include "opentimelineio/imageSequenceReference.h"
 
+#include <algorithm>
+
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
 
 ImageSequenceReference::ImageSequenceReference(
@@ -98,70 +100,172 @@ ImageSequenceReference::target_url_for_image_number(
     int          image_number,
     ErrorStatus* error_status) const
 {
-    if (_rate == 0)
+    return URLFormatter(*this).url(image_number, error_status);
+}
+
+ImageSequenceReference::URLList
+ImageSequenceReference::target_urls_for_image_range(
+    int          start_image_number,
+    int          image_count,
+    ErrorStatus* error_status) const
+{
+    URLList      result;
+    URLFormatter formatter(*this);
+    if (!formatter._check_range(start_image_number, image_count, error_status))
     {
-        if (error_status)
-        {
-            *error_status = ErrorStatus(
-                ErrorStatus::ILLEGAL_INDEX,
-                "Zero rate sequence has no frames.");
-        }
-        return std::string();
+        return result;
+    }
+
+    // every URL is the same length, give or take the sign and the digits
+    // beyond the padding.
+    size_t const url_size_estimate = formatter._head.size()
+                                     + formatter._name_suffix.size()
+                                     + std::max(_frame_zero_padding, 10) + 1;
+    result.buffer.reserve(size_t(image_count) * url_size_estimate);
+    result.offsets.reserve(size_t(image_count) + 1);
+
+    result.offsets.push_back(0);
+    for (int i = 0; i < image_count; ++i)
+    {
+        formatter._append_url(start_image_number + i, result.buffer);
+        result.offsets.push_back(result.buffer.size());
+    }
+
+    if (error_status)
+    {
+        *error_status = ErrorStatus(ErrorStatus::OK);
+    }
+    return result;
+}
+
+ImageSequenceReference::URLFormatter::URLFormatter(
+    ImageSequenceReference const& reference)
+    : _name_suffix(reference._name_suffix)
+    , _start_frame(reference._start_frame)
+    , _frame_step(reference._frame_step)
+    , _frame_zero_padding(reference._frame_zero_padding)
+    , _image_count(0)
+{
+    auto const available_range = reference.available_range();
+    if (reference._rate == 0)
+    {
+        _sequence_error = ErrorStatus(
+            ErrorStatus::ILLEGAL_INDEX,
+            "Zero rate sequence has no frames.");
+        return;
     }
     else if (
-        !this->available_range().has_value()
-        || this->available_range().value().duration().value() == 0)
+        !available_range.has_value()
+        || available_range->duration().value() == 0)
+    {
+        _sequence_error = ErrorStatus(
+            ErrorStatus::ILLEGAL_INDEX,
+            "Zero duration sequences has no frames.");
+        return;
+    }
+
+    _image_count = reference.number_of_images_in_sequence();
+
+    // If the base does not include a trailing slash, add it
+    std::string const& target_url_base = reference._target_url_base;
+    _head.reserve(target_url_base.size() + 1 + reference._name_prefix.size());
+    _head = target_url_base;
+    if (!target_url_base.empty() && target_url_base.back() != '/')
+    {
+        _head += '/';
+    }
+    _head += reference._name_prefix;
+}
+
+bool
+ImageSequenceReference::URLFormatter::_check_range(
+    int          start_image_number,
+    int          image_count,
+    ErrorStatus* error_status) const
+{
+    if (is_error(_sequence_error))
     {
         if (error_status)
         {
-            *error_status = ErrorStatus(
-                ErrorStatus::ILLEGAL_INDEX,
-                "Zero duration sequences has no frames.");
+            *error_status = _sequence_error;
         }
-        return std::string();
+        return false;
     }
-    else if (image_number >= this->number_of_images_in_sequence())
+    else if (
+        image_count < 0
+        || int64_t(start_image_number) + image_count > _image_count)
     {
         if (error_status)
         {
             *error_status = ErrorStatus(ErrorStatus::ILLEGAL_INDEX);
         }
-        return std::string();
+        return false;
     }
-    const int  file_image_num = _start_frame + (image_number * _frame_step);
-    const bool is_negative    = (file_image_num < 0);
+    return true;
+}
 
-    std::string image_num_string = std::to_string(abs(file_image_num));
+void
+ImageSequenceReference::URLFormatter::_append_url(
+    int          image_number,
+    std::string& out) const
+{
+    const int64_t file_image_num =
+        int64_t(_start_frame) + int64_t(image_number) * _frame_step;
+
+    // format the digits back to front into a local buffer
+    char     digits[24];
+    char*    digits_end   = digits + sizeof(digits);
+    char*    digits_begin = digits_end;
+    uint64_t magnitude    = file_image_num < 0 ? uint64_t(-file_image_num)
+                                               : uint64_t(file_image_num);
+    do
+    {
+        *--digits_begin = char('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+
+    const int digit_count = int(digits_end - digits_begin);
 
-    std::string zero_pad = std::string();
-    if (static_cast<int>(image_num_string.length()) < _frame_zero_padding)
+    out += _head;
+    if (file_image_num < 0)
     {
-        zero_pad =
-            std::string(_frame_zero_padding - image_num_string.length(), '0');
+        out += '-';
     }
-
-    std::string sign = std::string();
-    if (is_negative)
+    if (digit_count < _frame_zero_padding)
     {
-        sign = "-";
+        out.append(size_t(_frame_zero_padding - digit_count), '0');
     }
+    out.append(digits_begin, digits_end);
+    out += _name_suffix;
+}
 
-    // If the base does not include a trailing slash, add it
-    std::string path_sep            = std::string();
-    const auto  target_url_base_len = _target_url_base.length();
-    if (target_url_base_len > 0
-        && _target_url_base.compare(target_url_base_len - 1, 1, "/") != 0)
+bool
+ImageSequenceReference::URLFormatter::append_url(
+    int          image_number,
+    std::string& out,
+    ErrorStatus* error_status) const
+{
+    if (!_check_range(image_number, 1, error_status))
     {
-        path_sep = "/";
+        return false;
     }
 
-    std::string out_string = _target_url_base + path_sep + _name_prefix + sign
-                             + zero_pad + image_num_string + _name_suffix;
+    _append_url(image_number, out);
     if (error_status)
     {
         *error_status = ErrorStatus(ErrorStatus::OK);
     }
-    return out_string;
+    return true;
+}
+
+std::string
+ImageSequenceReference::URLFormatter::url(
+    int          image_number,
+    ErrorStatus* error_status) const
+{
+    std::string result;
+    append_url(image_number, result, error_status);
+    return result;
 }
 
 RationalTime
@@ -183,6 +287,100 @@ ImageSequenceReference::presentation_time_for_image_number(
     return time_multiplier.applied_to(frame_duration());
 }
 
+size_t
+ImageSequenceReference::frames_for_times(
+    RationalTime const* times,
+    size_t              count,
+    int*                frames,
+    uint8_t*            valid) const
+{
+    auto const range = this->available_range();
+    if (!range.has_value())
+    {
+        std::fill(frames, frames + count, 0);
+        if (valid)
+        {
+            std::fill(valid, valid + count, uint8_t(0));
+        }
+        return 0;
+    }
+
+    RationalTime const start      = range->start_time();
+    RationalTime const end        = range->end_time_exclusive();
+    int const          last_frame = end_frame();
+    bool const hold = _missing_frame_policy == MissingFramePolicy::hold;
+
+    size_t valid_count = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        RationalTime const time     = times[i];
+        bool const         contains = start <= time && time < end;
+        int frame = _start_frame + (time - start).to_frames(_rate);
+        if (hold)
+        {
+            frame = time < start ? _start_frame
+                                 : (time < end ? frame : last_frame);
+        }
+
+        bool const is_valid = contains || hold;
+        frames[i]           = frame;
+        if (valid)
+        {
+            valid[i] = uint8_t(is_valid);
+        }
+        valid_count += is_valid;
+    }
+    return valid_count;
+}
+
+size_t
+ImageSequenceReference::presentation_times_for_image_numbers(
+    int const*    image_numbers,
+    size_t        count,
+    RationalTime* times,
+    uint8_t*      valid) const
+{
+    int const  image_count = number_of_images_in_sequence();
+    auto const range       = this->available_range();
+    if (!range.has_value() || image_count <= 0)
+    {
+        std::fill(times, times + count, RationalTime());
+        if (valid)
+        {
+            std::fill(valid, valid + count, uint8_t(0));
+        }
+        return 0;
+    }
+
+    // the same arithmetic as presentation_time_for_image_number(), with the
+    // TimeTransform unrolled.
+    RationalTime const first_frame_time = range->start_time();
+    RationalTime const duration         = frame_duration();
+    bool const hold = _missing_frame_policy == MissingFramePolicy::hold;
+
+    size_t valid_count = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        int        image_number = image_numbers[i];
+        bool const contains     = image_number < image_count;
+        if (hold && !contains)
+        {
+            image_number = image_count - 1;
+        }
+
+        bool const is_valid = contains || hold;
+        times[i] =
+            RationalTime(duration.value() * image_number, duration.rate())
+            + first_frame_time;
+        if (valid)
+        {
+            valid[i] = uint8_t(is_valid);
+        }
+        valid_count += is_valid;
+    }
+    return valid_count;
+}
+
 bool
 ImageSequenceReference::read_from(Reader& reader)
 {
@@ -6,6 +6,10 @@
 #include "opentimelineio/mediaReference.h"
 #include "opentimelineio/version.h"
 
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
 
 class ImageSequenceReference final : public MediaReference
@@ -46,6 +50,7 @@ public:
     void set_target_url_base(std::string const& target_url_base)
     {
         _target_url_base = target_url_base;
+        _changed();
     }
 
     std::string name_prefix() const noexcept { return _name_prefix; }
@@ -53,6 +58,7 @@ public:
     void set_name_prefix(std::string const& target_url_base)
     {
         _name_prefix = target_url_base;
+        _changed();
     }
 
     std::string name_suffix() const noexcept { return _name_suffix; }
@@ -60,34 +66,45 @@ public:
     void set_name_suffix(std::string const& target_url_base)
     {
         _name_suffix = target_url_base;
+        _changed();
     }
 
     int start_frame() const noexcept { return _start_frame; }
 
-    void set_start_frame(int start_frame) noexcept
+    void set_start_frame(int start_frame)
     {
         _start_frame = start_frame;
+        _changed();
     }
 
     int frame_step() const noexcept { return _frame_step; }
 
-    void set_frame_step(int frame_step) noexcept { _frame_step = frame_step; }
+    void set_frame_step(int frame_step)
+    {
+        _frame_step = frame_step;
+        _changed();
+    }
 
     double rate() const noexcept { return _rate; }
 
-    void set_rate(double rate) noexcept { _rate = rate; }
+    void set_rate(double rate)
+    {
+        _rate = rate;
+        _changed();
+    }
 
     int frame_zero_padding() const noexcept { return _frame_zero_padding; }
 
-    void set_frame_zero_padding(int frame_zero_padding) noexcept
+    void set_frame_zero_padding(int frame_zero_padding)
     {
         _frame_zero_padding = frame_zero_padding;
+        _changed();
     }
 
-    void
-    set_missing_frame_policy(MissingFramePolicy missing_frame_policy) noexcept
+    void set_missing_frame_policy(MissingFramePolicy missing_frame_policy)
     {
         _missing_frame_policy = missing_frame_policy;
+        _changed();
     }
 
     MissingFramePolicy missing_frame_policy() const noexcept
@@ -109,6 +126,106 @@ public:
         int          image_number,
         ErrorStatus* error_status = nullptr) const;
 
+    /// Array versions of frame_for_time() and
+    /// presentation_time_for_image_number().
+    ///
+    /// The sequence parameters are looked up and checked once, after which
+    /// every element is mapped independently in a single pass. If valid is
+    /// given, valid[i] is set to 1 if element i maps to an image of the
+    /// sequence and 0 otherwise, following missing_frame_policy(): with
+    /// hold, elements outside the sequence are clamped to its first or last
+    /// image and count as valid; with error or black they are mapped as if
+    /// the sequence extended that far, and are invalid.
+    ///
+    /// Returns the number of valid elements.
+    size_t frames_for_times(
+        RationalTime const* times,
+        size_t              count,
+        int*                frames,
+        uint8_t*            valid = nullptr) const;
+
+    size_t presentation_times_for_image_numbers(
+        int const*    image_numbers,
+        size_t        count,
+        RationalTime* times,
+        uint8_t*      valid = nullptr) const;
+
+    /// Formats the target URLs of a sequence's images.
+    ///
+    /// Everything that does not depend on the image number, including the
+    /// checks that the sequence has any images at all, is worked out once
+    /// when the formatter is made, which makes it much cheaper than
+    /// target_url_for_image_number() for many URLs. The formatter copies
+    /// what it needs, so later changes to the reference are not reflected.
+    class URLFormatter
+    {
+    public:
+        explicit URLFormatter(ImageSequenceReference const& reference);
+
+        int number_of_images_in_sequence() const noexcept
+        {
+            return _image_count;
+        }
+
+        /// Append the URL of image_number to out. If there is no such
+        /// image, out is left unchanged and false is returned.
+        bool append_url(
+            int          image_number,
+            std::string& out,
+            ErrorStatus* error_status = nullptr) const;
+
+        std::string
+        url(int image_number, ErrorStatus* error_status = nullptr) const;
+
+    private:
+        bool _check_range(
+            int          start_image_number,
+            int          image_count,
+            ErrorStatus* error_status) const;
+
+        void _append_url(int image_number, std::string& out) const;
+
+        std::string _head; // target_url_base, separator and name_prefix
+        std::string _name_suffix;
+        int         _start_frame;
+        int         _frame_step;
+        int         _frame_zero_padding;
+        int         _image_count;
+        ErrorStatus _sequence_error;
+
+        friend class ImageSequenceReference;
+    };
+
+    /// The target URLs of a run of images, packed into one buffer.
+    ///
+    /// URL i is the slice [offsets[i], offsets[i + 1]) of buffer.
+    struct URLList
+    {
+        std::string         buffer;
+        std::vector<size_t> offsets;
+
+        size_t size() const noexcept
+        {
+            return offsets.empty() ? 0 : offsets.size() - 1;
+        }
+
+        std::string_view operator[](size_t index) const
+        {
+            return std::string_view(buffer).substr(
+                offsets[index],
+                offsets[index + 1] - offsets[index]);
+        }
+    };
+
+    /// Return the target URLs of image_count images starting at
+    /// start_image_number. Fails, returning an empty list, if any of those
+    /// images is out of range, in the same way as
+    /// target_url_for_image_number().
+    URLList target_urls_for_image_range(
+        int          start_image_number,
+        int          image_count,
+        ErrorStatus* error_status = nullptr) const;
+
 protected:
     virtual ~ImageSequenceReference();
 
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "opentimelineio/instrumentation.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+namespace {
+
+// Sites are only ever added, at the front.
+std::atomic<InstrumentationSite*> first_site{ nullptr };
+
+std::atomic<bool> tracing{ false };
+
+struct TraceEvent
+{
+    InstrumentationSite const* site;
+    uint32_t                   thread;
+    int64_t                    start_nanoseconds;
+    uint64_t                   nanoseconds;
+};
+
+std::mutex              trace_mutex;
+std::vector<TraceEvent> trace_events;
+
+std::chrono::steady_clock::time_point
+trace_epoch()
+{
+    static auto const epoch = std::chrono::steady_clock::now();
+    return epoch;
+}
+
+// A small number for the calling thread, which reads better in a trace
+// viewer than a native thread id.
+uint32_t
+trace_thread()
+{
+    static std::atomic<uint32_t> next_thread{ 0 };
+    thread_local uint32_t const  thread = ++next_thread;
+    return thread;
+}
+
+} // namespace
+
+bool
+instrumentation_enabled() noexcept
+{
+#ifdef OTIO_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+InstrumentationSite::InstrumentationSite(char const* name) noexcept
+    : _name(name)
+{
+    _next = first_site.load(std::memory_order_relaxed);
+    while (!first_site.compare_exchange_weak(
+        _next,
+        this,
+        std::memory_order_release,
+        std::memory_order_relaxed))
+    {}
+}
+
+InstrumentationScope::~InstrumentationScope()
+{
+    auto const     end         = std::chrono::steady_clock::now();
+    uint64_t const nanoseconds = uint64_t(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - _start)
+            .count());
+    _site.add(1, nanoseconds);
+
+    if (tracing.load(std::memory_order_relaxed))
+    {
+        int64_t const start =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                _start - trace_epoch())
+                .count();
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        trace_events.push_back({ &_site, trace_thread(), start, nanoseconds });
+    }
+}
+
+std::vector<InstrumentationCounter>
+instrumentation_counters()
+{
+    std::map<std::string, InstrumentationCounter> by_name;
+    for (auto site = first_site.load(std::memory_order_acquire); site;
+         site      = site->_next)
+    {
+        auto& counter = by_name[site->_name];
+        counter.name  = site->_name;
+        counter.count += site->_count.load(std::memory_order_relaxed);
+        counter.seconds +=
+            site->_nanoseconds.load(std::memory_order_relaxed) * 1e-9;
+    }
+
+    std::vector<InstrumentationCounter> result;
+    result.reserve(by_name.size());
+    for (auto& e: by_name)
+    {
+        result.push_back(std::move(e.second));
+    }
+    return result;
+}
+
+void
+reset_instrumentation()
+{
+    for (auto site = first_site.load(std::memory_order_acquire); site;
+         site      = site->_next)
+    {
+        site->_count.store(0, std::memory_order_relaxed);
+        site->_nanoseconds.store(0, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    trace_events.clear();
+}
+
+void
+set_instrumentation_tracing(bool enabled) noexcept
+{
+    // start the clock before the first event can be recorded
+    trace_epoch();
+    tracing.store(enabled, std::memory_order_relaxed);
+}
+
+bool
+instrumentation_tracing() noexcept
+{
+    return tracing.load(std::memory_order_relaxed);
+}
+
+std::string
+instrumentation_trace_json()
+{
+    std::vector<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        events = trace_events;
+    }
+
+    // Site names are string literals in the code, so need no escaping.
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    char        buffer[128];
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        auto const& event = events[i];
+        json += i ? ",\n{\"name\":\"" : "\n{\"name\":\"";
+        json += event.site->name();
+        std::snprintf(
+            buffer,
+            sizeof(buffer),
+            "\",\"cat\":\"otio\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+            "\"pid\":1,\"tid\":%u}",
+            event.start_nanoseconds * 1e-3,
+            event.nanoseconds * 1e-3,
+            unsigned(event.thread));
+        json += buffer;
+    }
+    json += "\n]}\n";
+    return json;
+}
+
+bool
+write_instrumentation_trace(
+    std::string const& file_name,
+    ErrorStatus*       error_status)
+{
+    std::ofstream file(file_name);
+    if (!(file << instrumentation_trace_json()))
+    {
+        if (error_status)
+        {
+            *error_status =
+                ErrorStatus(ErrorStatus::FILE_WRITE_FAILED, file_name);
+        }
+        return false;
+    }
+    return true;
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
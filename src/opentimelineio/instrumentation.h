@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentimelineio/errorStatus.h"
+#include "opentimelineio/version.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+/**
+ * Timers and counters along the library's hot paths (parsing, reference
+ * resolution, schema upgrades and downgrades, cloning and the composition
+ * range queries), for finding out where the time of a slow job goes.
+ *
+ * They are compiled in only when the library is built with
+ * OTIO_INSTRUMENTATION; otherwise the OTIO_TRACE_SCOPE and OTIO_COUNT
+ * macros expand to nothing and the functions below report nothing.
+ *
+ * Every site always counts its calls and the time spent in it.  While
+ * tracing is turned on, every call is also recorded as an event, for
+ * export in the Chrome trace event format, which chrome://tracing and
+ * Perfetto display as a timeline per thread.
+ */
+
+// Whether the library was built with OTIO_INSTRUMENTATION.
+bool instrumentation_enabled() noexcept;
+
+struct InstrumentationCounter
+{
+    std::string name;
+
+    // The number of calls to a timed scope, or the sum of the amounts
+    // counted by OTIO_COUNT.
+    uint64_t count = 0;
+
+    // The total time spent in a timed scope; zero for OTIO_COUNT.
+    double seconds = 0;
+};
+
+// The counters of every site reached so far, sorted by name; sites of the
+// same name are added together.
+std::vector<InstrumentationCounter> instrumentation_counters();
+
+// Zero all counters and discard the recorded trace events.
+void reset_instrumentation();
+
+void set_instrumentation_tracing(bool enabled) noexcept;
+bool instrumentation_tracing() noexcept;
+
+// The trace events recorded so far, as Chrome trace event JSON.
+std::string instrumentation_trace_json();
+
+bool write_instrumentation_trace(
+    std::string const& file_name,
+    ErrorStatus*       error_status = nullptr);
+
+// A place in the code that is timed or counted.  The macros below make
+// one static instance per place; instances register themselves so that
+// their counters can be reported.
+class InstrumentationSite
+{
+public:
+    explicit InstrumentationSite(char const* name) noexcept;
+
+    InstrumentationSite(InstrumentationSite const&)            = delete;
+    InstrumentationSite& operator=(InstrumentationSite const&) = delete;
+
+    char const* name() const noexcept { return _name; }
+
+    void add(uint64_t count, uint64_t nanoseconds = 0) noexcept
+    {
+        _count.fetch_add(count, std::memory_order_relaxed);
+        _nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+private:
+    char const*           _name;
+    std::atomic<uint64_t> _count{ 0 };
+    std::atomic<uint64_t> _nanoseconds{ 0 };
+    InstrumentationSite*  _next = nullptr;
+
+    friend std::vector<InstrumentationCounter> instrumentation_counters();
+    friend void                                reset_instrumentation();
+};
+
+// Times the scope it lives in, for OTIO_TRACE_SCOPE.
+class InstrumentationScope
+{
+public:
+    explicit InstrumentationScope(InstrumentationSite& site) noexcept
+        : _site(site)
+        , _start(std::chrono::steady_clock::now())
+    {}
+
+    ~InstrumentationScope();
+
+    InstrumentationScope(InstrumentationScope const&)            = delete;
+    InstrumentationScope& operator=(InstrumentationScope const&) = delete;
+
+private:
+    InstrumentationSite&                  _site;
+    std::chrono::steady_clock::time_point _start;
+};
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
+
+#define OTIO_INSTRUMENTATION_CONCAT_(a, b) a##b
+#define OTIO_INSTRUMENTATION_CONCAT(a, b) OTIO_INSTRUMENTATION_CONCAT_(a, b)
+
+#ifdef OTIO_INSTRUMENTATION
+
+/// Time the rest of the enclosing scope under name, a string literal.
+#    define OTIO_TRACE_SCOPE(name)                                             \
+        static OTIO_NS::InstrumentationSite OTIO_INSTRUMENTATION_CONCAT(       \
+            otio_instrumentation_site_,                                        \
+            __LINE__){ name };                                                 \
+        OTIO_NS::InstrumentationScope OTIO_INSTRUMENTATION_CONCAT(             \
+            otio_instrumentation_scope_,                                       \
+            __LINE__)(                                                         \
+            OTIO_INSTRUMENTATION_CONCAT(otio_instrumentation_site_, __LINE__))
+
+/// Add amount to the counter called name, a string literal.
+#    define OTIO_COUNT(name, amount)                                           \
+        do                                                                     \
+        {                                                                      \
+            static OTIO_NS::InstrumentationSite otio_instrumentation_site{     \
+                name                                                           \
+            };                                                                 \
+            otio_instrumentation_site.add(amount);                             \
+        } while (0)
+
+#else
+
+#    define OTIO_TRACE_SCOPE(name) ((void) 0)
+#    define OTIO_COUNT(name, amount) ((void) 0)
+
+#endif
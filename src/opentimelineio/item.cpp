@@ -6,6 +6,7 @@
 #include "opentimelineio/effect.h"
 #include "opentimelineio/marker.h"
 
+#include <algorithm>
 #include <assert.h>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
@@ -22,10 +23,32 @@ Item::Item(
     , _effects(effects.begin(), effects.end())
     , _markers(markers.begin(), markers.end())
     , _enabled(enabled)
-{}
+{
+    _hold_all();
+}
 
 Item::~Item()
-{}
+{
+    for (auto const& effect: _effects)
+    {
+        _release_held(effect, this);
+    }
+    for (auto const& marker: _markers)
+    {
+        _release_held(marker, this);
+    }
+    if (_lent)
+    {
+        for (auto const& effect: _lent->effects)
+        {
+            _release_held(effect, this);
+        }
+        for (auto const& marker: _lent->markers)
+        {
+            _release_held(marker, this);
+        }
+    }
+}
 
 bool
 Item::visible() const
@@ -139,6 +162,17 @@ Item::transformed_time(
     while (item != root && item != ancestor)
     {
         auto parent = item->parent();
+        if (!parent)
+        {
+            // to_item is not in the same hierarchy as this item
+            if (error_status)
+            {
+                *error_status = ErrorStatus::NOT_DESCENDED_FROM;
+                error_status->object_details = to_item;
+            }
+            return result;
+        }
+
         result += item->trimmed_range(error_status).start_time();
         if (is_error(error_status))
         {
@@ -172,11 +206,14 @@ Item::transformed_time_range(
 bool
 Item::read_from(Reader& reader)
 {
-    return reader.read_if_present("source_range", &_source_range)
-           && reader.read_if_present("effects", &_effects)
-           && reader.read_if_present("markers", &_markers)
-           && reader.read_if_present("enabled", &_enabled)
-           && Parent::read_from(reader);
+    bool const result =
+        reader.read_if_present("source_range", &_source_range)
+        && reader.read_if_present("effects", &_effects)
+        && reader.read_if_present("markers", &_markers)
+        && reader.read_if_present("enabled", &_enabled)
+        && Parent::read_from(reader);
+    _hold_all();
+    return result;
 }
 
 void
@@ -189,4 +226,78 @@ Item::write_to(Writer& writer) const
     writer.write("enabled", _enabled);
 }
 
+void
+Item::_lend_held()
+{
+    if (!_lent)
+    {
+        _lent.reset(new _Lent{ _effects, _markers });
+        _unsettle();
+    }
+}
+
+void
+Item::_hold_all()
+{
+    for (auto const& effect: _effects)
+    {
+        if (effect)
+        {
+            _set_holder(effect, this);
+        }
+    }
+    for (auto const& marker: _markers)
+    {
+        if (marker)
+        {
+            _set_holder(marker, this);
+        }
+    }
+}
+
+namespace {
+
+template <typename T>
+bool
+same_objects(
+    std::vector<SerializableObject::Retainer<T>> const& a,
+    std::vector<SerializableObject::Retainer<T>> const& b)
+{
+    return std::equal(
+        a.begin(),
+        a.end(),
+        b.begin(),
+        b.end(),
+        [](auto const& x, auto const& y) { return x.value == y.value; });
+}
+
+} // namespace
+
+void
+Item::_settle_held()
+{
+    Parent::_settle_held();
+    if (!_lent)
+    {
+        return;
+    }
+
+    std::unique_ptr<_Lent> const lent = std::move(_lent);
+    for (auto const& effect: lent->effects)
+    {
+        _release_held(effect, this);
+    }
+    for (auto const& marker: lent->markers)
+    {
+        _release_held(marker, this);
+    }
+    _hold_all();
+
+    if (!same_objects(lent->effects, _effects)
+        || !same_objects(lent->markers, _markers))
+    {
+        _changed();
+    }
+}
+
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
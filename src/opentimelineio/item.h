@@ -37,7 +37,11 @@ public:
 
     bool enabled() const { return _enabled; };
 
-    void set_enabled(bool enabled) { _enabled = enabled; }
+    void set_enabled(bool enabled)
+    {
+        _enabled = enabled;
+        _changed();
+    }
 
     std::optional<TimeRange> source_range() const noexcept
     {
@@ -47,16 +51,28 @@ public:
     void set_source_range(std::optional<TimeRange> const& source_range)
     {
         _source_range = source_range;
+        _changed();
     }
 
-    std::vector<Retainer<Effect>>& effects() noexcept { return _effects; }
+    // Effects and markers added to or removed from the vector returned are
+    // counted as modifications when the generation is next read; see
+    // SerializableObject::generation().
+    std::vector<Retainer<Effect>>& effects()
+    {
+        _lend_held();
+        return _effects;
+    }
 
     std::vector<Retainer<Effect>> const& effects() const noexcept
     {
         return _effects;
     }
 
-    std::vector<Retainer<Marker>>& markers() noexcept { return _markers; }
+    std::vector<Retainer<Marker>>& markers()
+    {
+        _lend_held();
+        return _markers;
+    }
 
     std::vector<Retainer<Marker>> const& markers() const noexcept
     {
@@ -96,11 +112,25 @@ protected:
     bool read_from(Reader&) override;
     void write_to(Writer&) const override;
 
+    void _settle_held() override;
+
 private:
+    void _lend_held();
+    void _hold_all();
+
     std::optional<TimeRange>      _source_range;
     std::vector<Retainer<Effect>> _effects;
     std::vector<Retainer<Marker>> _markers;
     bool                          _enabled;
+
+    // What _effects and _markers held when they were first handed out
+    // since the last settling, if they were.
+    struct _Lent
+    {
+        std::vector<Retainer<Effect>> effects;
+        std::vector<Retainer<Marker>> markers;
+    };
+    std::unique_ptr<_Lent> _lent;
 };
 
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -27,9 +27,10 @@ public:
 
     double time_scalar() const noexcept { return _time_scalar; }
 
-    void set_time_scalar(double time_scalar) noexcept
+    void set_time_scalar(double time_scalar)
     {
         _time_scalar = time_scalar;
+        _changed();
     }
 
 protected:
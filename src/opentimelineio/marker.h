@@ -43,18 +43,27 @@ public:
 
     std::string color() const noexcept { return _color; }
 
-    void set_color(std::string const& color) { _color = color; }
+    void set_color(std::string const& color)
+    {
+        _color = color;
+        _changed();
+    }
 
     TimeRange marked_range() const noexcept { return _marked_range; }
 
-    void set_marked_range(TimeRange const& marked_range) noexcept
+    void set_marked_range(TimeRange const& marked_range)
     {
         _marked_range = marked_range;
+        _changed();
     }
 
     std::string comment() const noexcept { return _comment; }
 
-    void set_comment(std::string const& comment) { _comment = comment; }
+    void set_comment(std::string const& comment)
+    {
+        _comment = comment;
+        _changed();
+    }
 
 protected:
     virtual ~Marker();
@@ -18,6 +18,12 @@ MediaReference::MediaReference(
 MediaReference::~MediaReference()
 {}
 
+SerializableObject*
+MediaReference::_change_parent() const
+{
+    return _clip;
+}
+
 bool
 MediaReference::is_missing_reference() const
 {
@@ -38,6 +38,7 @@ public:
     void set_available_range(std::optional<TimeRange> const& available_range)
     {
         _available_range = available_range;
+        _changed();
     }
 
     virtual bool is_missing_reference() const;
@@ -51,17 +52,25 @@ public:
         std::optional<IMATH_NAMESPACE::Box2d> const& available_image_bounds)
     {
         _available_image_bounds = available_image_bounds;
+        _changed();
     }
 
 protected:
     virtual ~MediaReference();
 
+    SerializableObject* _change_parent() const override;
+
     bool read_from(Reader&) override;
     void write_to(Writer&) const override;
 
 private:
     std::optional<TimeRange>              _available_range;
     std::optional<IMATH_NAMESPACE::Box2d> _available_image_bounds;
+
+    // The clip this reference passes its changes on to. A reference shared
+    // by several clips only reaches the clip it was most recently given to.
+    SerializableObject* _clip = nullptr;
+    friend class Clip;
 };
 
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentimelineio/errorStatus.h"
+#include "opentimelineio/version.h"
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+class SerializableObject;
+
+/**
+ * An estimate of the memory held by a graph of objects, for services that
+ * keep many timelines loaded and need to hold them to a budget.
+ *
+ * The sizes are estimated from the types of the values the objects hold,
+ * as they are stored, rather than measured, so they leave out what the
+ * allocator adds to each allocation; they are meant for comparing graphs
+ * and for watching one grow, not for accounting to the byte.  A program
+ * can check them against what it really allocates by including
+ * opentimelineio/allocationCounter.h.
+ */
+struct MemoryFootprint
+{
+    struct SchemaFootprint
+    {
+        size_t objects = 0;
+        size_t bytes   = 0;
+    };
+
+    // By schema name.  The bytes of an object include those of its
+    // metadata and strings, but not those of its children.
+    std::map<std::string, SchemaFootprint> schemas;
+
+    size_t object_count = 0;
+    size_t total_bytes  = 0;
+
+    // The parts of total_bytes held in metadata, and in the characters of
+    // strings (both inside and outside metadata).
+    size_t metadata_bytes = 0;
+    size_t string_bytes   = 0;
+};
+
+/**
+ * Estimate the memory held by root and everything it holds, walking the
+ * objects the same way that serializing them does, without producing any
+ * output.
+ *
+ * A dictionary that objects share (as clones share their metadata, until
+ * it changes) is counted once, against the first of them found.
+ *
+ * If the walk fails (say, because the graph holds a cycle), the footprint
+ * of the part walked is returned and error_status is set.
+ */
+MemoryFootprint memory_footprint(
+    SerializableObject const* root,
+    ErrorStatus*              error_status = nullptr);
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
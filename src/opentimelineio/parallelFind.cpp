@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "opentimelineio/parallelFind.h"
+#include "opentimelineio/threadPool.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+namespace {
+
+using ChildVector = std::vector<SerializableObject::Retainer<Composable>>;
+
+// A contiguous run of the children of one composition, searched together
+// on one thread. Tasks are kept in the order of the serial search, so that
+// concatenating their results gives the serial result.
+struct FindTask
+{
+    // Null for a task that only holds matches found while planning.
+    Composition const* composition = nullptr;
+
+    // The children of composition within search_range; null when there is
+    // no search range and the children are searched directly.
+    std::shared_ptr<ChildVector> children_in_range;
+    size_t                       begin = 0;
+    size_t                       end   = 0;
+    std::optional<TimeRange>     search_range;
+
+    std::vector<Composable*> found;
+    ErrorStatus              error;
+};
+
+// Compositions nested deeper than this are never split across tasks.
+constexpr int _max_split_depth = 3;
+
+class FindPlanner
+{
+public:
+    FindPlanner(bool (*matches)(Composable const*), size_t task_target)
+        : _matches(matches)
+        , _task_target(task_target)
+    {}
+
+    // Split the search of composition into tasks. Compositions with fewer
+    // children than the task target are opened up so that their own
+    // children can be split; larger ones are cut into slices.
+    bool plan(
+        Composition const*              composition,
+        std::optional<TimeRange> const& search_range,
+        int                             depth,
+        ErrorStatus*                    error_status)
+    {
+        std::shared_ptr<ChildVector> children_in_range;
+        if (search_range)
+        {
+            children_in_range = std::make_shared<ChildVector>(
+                composition->children_in_range(*search_range, error_status));
+            if (is_error(error_status))
+            {
+                return false;
+            }
+        }
+        auto const& children =
+            children_in_range ? *children_in_range : composition->children();
+
+        if (depth < _max_split_depth && children.size() < _task_target)
+        {
+            for (auto const& child: children)
+            {
+                if (_matches(child.value))
+                {
+                    _add_match(child.value);
+                }
+
+                auto nested = fast_cast<Composition>(child.value);
+                if (!nested)
+                {
+                    continue;
+                }
+
+                std::optional<TimeRange> nested_search_range;
+                if (search_range)
+                {
+                    nested_search_range = composition->transformed_time_range(
+                        *search_range,
+                        nested,
+                        error_status);
+                    if (is_error(error_status))
+                    {
+                        return false;
+                    }
+                }
+                if (!plan(nested, nested_search_range, depth + 1, error_status))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        size_t slice_count = std::min(children.size(), _task_target);
+        for (size_t i = 0; i < slice_count; ++i)
+        {
+            FindTask task;
+            task.composition       = composition;
+            task.children_in_range = children_in_range;
+            task.begin             = children.size() * i / slice_count;
+            task.end               = children.size() * (i + 1) / slice_count;
+            task.search_range      = search_range;
+            tasks.push_back(std::move(task));
+        }
+        return true;
+    }
+
+    std::vector<FindTask> tasks;
+
+private:
+    void _add_match(Composable* child)
+    {
+        if (tasks.empty() || tasks.back().composition)
+        {
+            tasks.emplace_back();
+        }
+        tasks.back().found.push_back(child);
+    }
+
+    bool (*_matches)(Composable const*);
+    size_t _task_target;
+};
+
+} // namespace
+
+static void
+_run_find_task(FindTask& task, bool (*matches)(Composable const*))
+{
+    auto const& children = task.children_in_range
+                               ? *task.children_in_range
+                               : task.composition->children();
+    auto visitor = [&task, matches](Composable* child) {
+        if (matches(child))
+        {
+            task.found.push_back(child);
+        }
+        return true;
+    };
+
+    for (size_t i = task.begin; i < task.end; ++i)
+    {
+        Composable* child = children[i].value;
+        visitor(child);
+
+        auto nested = fast_cast<Composition>(child);
+        if (!nested)
+        {
+            continue;
+        }
+
+        std::optional<TimeRange> nested_search_range;
+        if (task.search_range)
+        {
+            nested_search_range = task.composition->transformed_time_range(
+                *task.search_range,
+                nested,
+                &task.error);
+            if (is_error(task.error))
+            {
+                return;
+            }
+        }
+        if (!nested->visit_children(visitor, &task.error, nested_search_range))
+        {
+            return;
+        }
+    }
+}
+
+std::vector<Composable*>
+parallel_find_if(
+    Composition const*              composition,
+    bool                            (*matches)(Composable const*),
+    ErrorStatus*                    error_status,
+    std::optional<TimeRange> const& search_range,
+    ThreadPool*                     thread_pool)
+{
+    ThreadPool& pool = thread_pool ? *thread_pool : ThreadPool::global();
+
+    std::vector<Composable*> out;
+    if (pool.thread_count() == 0)
+    {
+        composition->visit_children(
+            [&out, matches](Composable* child) {
+                if (matches(child))
+                {
+                    out.push_back(child);
+                }
+                return true;
+            },
+            error_status,
+            search_range);
+        return out;
+    }
+
+    // a few tasks per thread, so that uneven subtrees even out
+    FindPlanner planner(matches, pool.thread_count() * 4);
+    if (!planner.plan(composition, search_range, 0, error_status))
+    {
+        return out;
+    }
+
+    auto& tasks = planner.tasks;
+    parallel_for(pool, tasks.size(), [&tasks, matches](size_t i) {
+        if (tasks[i].composition)
+        {
+            _run_find_task(tasks[i], matches);
+        }
+    });
+
+    size_t found_count = 0;
+    for (auto const& task: tasks)
+    {
+        found_count += task.found.size();
+    }
+    out.reserve(found_count);
+    for (auto const& task: tasks)
+    {
+        out.insert(out.end(), task.found.begin(), task.found.end());
+        if (is_error(task.error))
+        {
+            if (error_status)
+            {
+                *error_status = task.error;
+            }
+            break;
+        }
+    }
+    return out;
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentimelineio/composition.h"
+#include "opentimelineio/version.h"
+
+#include <type_traits>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+class ThreadPool;
+
+/// Find the child objects of composition for which matches() returns true,
+/// as Composition::visit_children() would visit them, searching subtrees
+/// concurrently on thread_pool (or ThreadPool::global() if none is given).
+///
+/// The results are in the same order as a serial search returns them, and
+/// are plain pointers that stay valid as long as composition does. The
+/// search is always recursive. If an error occurs, the objects found before
+/// it are returned and error_status is set appropriately.
+///
+/// matches is called from several threads at once. The composition must not
+/// be modified while the search runs.
+std::vector<Composable*> parallel_find_if(
+    Composition const*              composition,
+    bool                            (*matches)(Composable const*),
+    ErrorStatus*                    error_status = nullptr,
+    std::optional<TimeRange> const& search_range = std::nullopt,
+    ThreadPool*                     thread_pool  = nullptr);
+
+/// Find child objects that match the given template type, as
+/// Composition::find_children() does, searching subtrees concurrently with
+/// parallel_find_if().
+template <typename T = Composable>
+std::vector<SerializableObject::Retainer<T>>
+parallel_find_children(
+    Composition const*              composition,
+    ErrorStatus*                    error_status = nullptr,
+    std::optional<TimeRange> const& search_range = std::nullopt,
+    ThreadPool*                     thread_pool  = nullptr)
+{
+    static_assert(
+        std::is_base_of<Composable, T>::value,
+        "parallel_find_children() finds composables");
+
+    auto found = parallel_find_if(
+        composition,
+        [](Composable const* child) {
+            return fast_cast<T>(child) != nullptr;
+        },
+        error_status,
+        search_range,
+        thread_pool);
+
+    std::vector<SerializableObject::Retainer<T>> out;
+    out.reserve(found.size());
+    for (auto child: found)
+    {
+        out.emplace_back(static_cast<T*>(child));
+    }
+    return out;
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
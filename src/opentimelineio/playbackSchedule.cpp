@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "opentimelineio/playbackSchedule.h"
+
+#include <algorithm>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+namespace {
+
+bool
+build_track_schedule(
+    Track const*                     track,
+    PlaybackSchedule::TrackSchedule& track_schedule,
+    ErrorStatus*                     error_status)
+{
+    track_schedule.track      = track;
+    track_schedule.generation = track->generation();
+    track_schedule.segments.clear();
+    track_schedule.start_times.clear();
+    track_schedule.end_times.clear();
+
+    auto ranges = track->range_of_all_children(error_status);
+    if (is_error(error_status))
+    {
+        return false;
+    }
+
+    // the segment of the previous child, if it was scheduled, and the
+    // previous child itself, if it was a transition.
+    size_t const      no_segment          = size_t(-1);
+    size_t            previous_segment    = no_segment;
+    Transition const* previous_transition = nullptr;
+
+    auto& segments = track_schedule.segments;
+    segments.reserve(track->children().size());
+    for (auto const& child: track->children())
+    {
+        if (auto transition = fast_cast<Transition>(child.value))
+        {
+            if (previous_segment != no_segment)
+            {
+                segments[previous_segment].out_transition = transition;
+            }
+            previous_segment    = no_segment;
+            previous_transition = transition;
+            continue;
+        }
+
+        auto item = fast_cast<Item>(child.value);
+        if (!item || !item->visible())
+        {
+            previous_segment    = no_segment;
+            previous_transition = nullptr;
+            continue;
+        }
+
+        TimeRange const range         = ranges[child];
+        TimeRange const trimmed_range = item->trimmed_range(error_status);
+        if (is_error(error_status))
+        {
+            return false;
+        }
+
+        auto clip = fast_cast<Clip>(item);
+        segments.push_back(PlaybackSchedule::Segment{
+            range,
+            item,
+            clip,
+            clip ? clip->media_reference() : nullptr,
+            trimmed_range.start_time() - range.start_time(),
+            previous_transition,
+            nullptr });
+        previous_segment    = segments.size() - 1;
+        previous_transition = nullptr;
+    }
+
+    track_schedule.start_times.reserve(segments.size());
+    track_schedule.end_times.reserve(segments.size());
+    for (auto const& segment: segments)
+    {
+        track_schedule.start_times.push_back(
+            segment.range.start_time().to_seconds());
+        track_schedule.end_times.push_back(
+            segment.range.end_time_exclusive().to_seconds());
+    }
+    return true;
+}
+
+} // namespace
+
+PlaybackSchedule::PlaybackSchedule(
+    Timeline const* timeline,
+    ErrorStatus*    error_status)
+    : _timeline(timeline)
+    , _tracks_generation(0)
+{
+    if (!timeline)
+    {
+        if (error_status)
+        {
+            *error_status = ErrorStatus(
+                ErrorStatus::INTERNAL_ERROR,
+                "cannot schedule a null timeline");
+        }
+        return;
+    }
+
+    update(error_status);
+}
+
+bool
+PlaybackSchedule::update(ErrorStatus* error_status)
+{
+    if (!_timeline)
+    {
+        return true;
+    }
+
+    // the stack's generation covers every change to every track.
+    Stack const* stack = _timeline->tracks();
+    if (!_tracks.empty() && stack->generation() == _tracks_generation)
+    {
+        return true;
+    }
+
+    std::vector<Track const*> tracks;
+    for (auto const& child: stack->children())
+    {
+        if (auto track = fast_cast<Track>(child.value))
+        {
+            tracks.push_back(track);
+        }
+    }
+
+    bool same_tracks = tracks.size() == _tracks.size();
+    for (size_t i = 0; same_tracks && i < tracks.size(); ++i)
+    {
+        same_tracks = tracks[i] == _tracks[i].track;
+    }
+
+    if (same_tracks)
+    {
+        // only compare generations of tracks known to be alive.
+        for (auto& track_schedule: _tracks)
+        {
+            if (track_schedule.track->generation() != track_schedule.generation
+                && !build_track_schedule(
+                    track_schedule.track,
+                    track_schedule,
+                    error_status))
+            {
+                _tracks.clear();
+                return false;
+            }
+        }
+    }
+    else
+    {
+        // tracks were added, removed or moved; keep the schedules of the
+        // tracks that are still there and have not changed.
+        std::vector<TrackSchedule> old_tracks;
+        old_tracks.swap(_tracks);
+        _tracks.resize(tracks.size());
+        for (size_t i = 0; i < tracks.size(); ++i)
+        {
+            auto old = std::find_if(
+                old_tracks.begin(),
+                old_tracks.end(),
+                [&](TrackSchedule const& track_schedule) {
+                    return track_schedule.track == tracks[i];
+                });
+            if (old != old_tracks.end()
+                && old->generation == tracks[i]->generation())
+            {
+                _tracks[i] = std::move(*old);
+                old->track = nullptr;
+            }
+            else if (!build_track_schedule(tracks[i], _tracks[i], error_status))
+            {
+                _tracks.clear();
+                return false;
+            }
+        }
+    }
+
+    _tracks_generation = stack->generation();
+    return true;
+}
+
+bool
+PlaybackSchedule::rebuild_track(size_t track_index, ErrorStatus* error_status)
+{
+    if (track_index >= _tracks.size())
+    {
+        if (error_status)
+        {
+            *error_status = ErrorStatus(
+                ErrorStatus::ILLEGAL_INDEX,
+                "track index out of range");
+        }
+        return false;
+    }
+
+    TrackSchedule& track_schedule = _tracks[track_index];
+    return build_track_schedule(
+        track_schedule.track,
+        track_schedule,
+        error_status);
+}
+
+size_t
+PlaybackSchedule::_segment_index_at(
+    TrackSchedule const& track_schedule,
+    double               seconds)
+{
+    auto const& start_times = track_schedule.start_times;
+    size_t      index       = size_t(
+        std::upper_bound(start_times.begin(), start_times.end(), seconds)
+        - start_times.begin());
+    if (index == 0 || seconds >= track_schedule.end_times[index - 1])
+    {
+        return start_times.size();
+    }
+    return index - 1;
+}
+
+PlaybackSchedule::Segment const*
+PlaybackSchedule::segment_at(size_t track_index, RationalTime time) const
+{
+    TrackSchedule const& track_schedule = _tracks[track_index];
+    size_t index = _segment_index_at(track_schedule, time.to_seconds());
+    return index < track_schedule.segments.size()
+               ? &track_schedule.segments[index]
+               : nullptr;
+}
+
+PlaybackSchedule::Cursor::Cursor(
+    PlaybackSchedule const& schedule,
+    size_t                  track_index)
+    : _track(&schedule._tracks[track_index])
+    , _index(0)
+{}
+
+PlaybackSchedule::Segment const*
+PlaybackSchedule::Cursor::segment_at(RationalTime time)
+{
+    double const seconds = time.to_seconds();
+    size_t const count   = _track->segments.size();
+
+    // during playback the time is almost always in the segment we are in,
+    // the gap after it or the segment after that; check those before
+    // searching.
+    if (_index < count && seconds >= _track->start_times[_index])
+    {
+        if (seconds < _track->end_times[_index])
+        {
+            return &_track->segments[_index];
+        }
+
+        size_t const next = _index + 1;
+        if (next == count || seconds < _track->start_times[next])
+        {
+            return nullptr;
+        }
+        if (seconds < _track->end_times[next])
+        {
+            _index = next;
+            return &_track->segments[next];
+        }
+    }
+
+    size_t index = _segment_index_at(*_track, seconds);
+    if (index == count)
+    {
+        return nullptr;
+    }
+    _index = index;
+    return &_track->segments[index];
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentimelineio/clip.h"
+#include "opentimelineio/timeline.h"
+#include "opentimelineio/track.h"
+#include "opentimelineio/transition.h"
+#include "opentimelineio/version.h"
+
+#include <vector>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+/// A flat, precomputed schedule of what plays when in a timeline.
+///
+/// For each track of the timeline, the schedule holds the visible items
+/// of that track as segments sorted by time, so that finding the segment
+/// at a given time is a binary search that does not allocate or touch the
+/// timeline. Gaps and disabled items are left out, so times that fall in
+/// them have no segment.
+///
+/// Items are scheduled as they sit in their track; nested compositions
+/// appear as single segments, and time effects are not applied (see
+/// TimeWarpEvaluator for that).
+///
+/// The schedule holds plain pointers into the timeline, and is only valid
+/// while the timeline is alive. When the timeline is modified, call
+/// update() to rebuild the tracks that changed, or rebuild_track() to
+/// rebuild a track known to have changed.
+class PlaybackSchedule
+{
+public:
+    struct Segment
+    {
+        /// The range of the segment in the track; transitions are not
+        /// included.
+        TimeRange range;
+
+        Item const* item;
+
+        /// The item as a clip, and the clip's active media reference; both
+        /// are null if the item is not a clip.
+        Clip const*           clip;
+        MediaReference const* media_reference;
+
+        /// Add to a track time within range to get the item's own time,
+        /// i.e. the time within its trimmed range.
+        RationalTime source_offset;
+
+        /// The transitions immediately before and after the item in its
+        /// track, if there are any.
+        Transition const* in_transition;
+        Transition const* out_transition;
+    };
+
+    struct TrackSchedule
+    {
+        Track const*         track;
+        std::vector<Segment> segments;
+
+        /// The generation of the track when the segments were built.
+        uint64_t generation;
+
+        /// The start and end of each segment in seconds, kept apart from
+        /// the segments so that searching them stays in cache.
+        std::vector<double> start_times;
+        std::vector<double> end_times;
+    };
+
+    /// Plays the segments of one track in order, remembering where the
+    /// last lookup landed so that looking up successive times costs O(1)
+    /// instead of a binary search each time. A cursor stays usable across
+    /// rebuild_track(), and across update() unless tracks were added,
+    /// removed or reordered.
+    class Cursor
+    {
+    public:
+        Cursor(PlaybackSchedule const& schedule, size_t track_index);
+
+        /// The segment at time, or null if nothing plays at time.
+        Segment const* segment_at(RationalTime time);
+
+    private:
+        TrackSchedule const* _track;
+        size_t               _index;
+    };
+
+    /// Build the schedule of every track in the timeline's stack. If the
+    /// operation fails, the schedule is empty and error_status is set
+    /// appropriately.
+    PlaybackSchedule(
+        Timeline const* timeline,
+        ErrorStatus*    error_status = nullptr);
+
+    size_t track_count() const noexcept { return _tracks.size(); }
+
+    TrackSchedule const& track(size_t track_index) const
+    {
+        return _tracks[track_index];
+    }
+
+    /// The segment of the given track at time, or null if nothing plays
+    /// there.
+    Segment const* segment_at(size_t track_index, RationalTime time) const;
+
+    /// Rebuild the segments of one track after the track has changed.
+    bool rebuild_track(size_t track_index, ErrorStatus* error_status = nullptr);
+
+    /// Bring the schedule up to date with the timeline, using generations
+    /// to rebuild only the tracks that changed since they were last built.
+    /// This is cheap when nothing has changed.
+    bool update(ErrorStatus* error_status = nullptr);
+
+private:
+    static size_t
+    _segment_index_at(TrackSchedule const& track_schedule, double seconds);
+
+    Timeline const*            _timeline;
+    uint64_t                   _tracks_generation;
+    std::vector<TrackSchedule> _tracks;
+};
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -3,6 +3,8 @@
 
 #include "opentimelineio/safely_typed_any.h"
 
+#include <utility>
+
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
 
 std::any
@@ -185,4 +187,49 @@ temp_safely_cast_any_dictionary_any(std::any const& a)
     return const_cast<AnyDictionary&>(std::any_cast<AnyDictionary const&>(a));
 }
 
+AnyKind
+any_kind(std::any const& a)
+{
+    // most frequent first: metadata is mostly strings and numbers
+    static std::pair<std::type_info const*, AnyKind> const kinds[] = {
+        { &typeid(std::string), AnyKind::string },
+        { &typeid(double), AnyKind::double_value },
+        { &typeid(int64_t), AnyKind::int64_value },
+        { &typeid(bool), AnyKind::bool_value },
+        { &typeid(AnyDictionary), AnyKind::any_dictionary },
+        { &typeid(AnyVector), AnyKind::any_vector },
+        { &typeid(SerializableObject::Retainer<>), AnyKind::retainer },
+        { &typeid(void), AnyKind::empty },
+        { &typeid(RationalTime), AnyKind::rational_time },
+        { &typeid(TimeRange), AnyKind::time_range },
+        { &typeid(TimeTransform), AnyKind::time_transform },
+        { &typeid(IMATH_NAMESPACE::V2d), AnyKind::point },
+        { &typeid(IMATH_NAMESPACE::Box2d), AnyKind::box },
+        { &typeid(int), AnyKind::int_value },
+        { &typeid(uint64_t), AnyKind::uint64_value },
+        { &typeid(char const*), AnyKind::c_string },
+        { &typeid(SerializableObject::ReferenceId), AnyKind::reference_id },
+    };
+
+    std::type_info const& type = a.type();
+    for (auto const& kind: kinds)
+    {
+        if (kind.first == &type)
+        {
+            return kind.second;
+        }
+    }
+
+    // an any made in another library may carry its own type_info object
+    // for the same type, which only compares equal by name
+    for (auto const& kind: kinds)
+    {
+        if (*kind.first == type)
+        {
+            return kind.second;
+        }
+    }
+    return AnyKind::other;
+}
+
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
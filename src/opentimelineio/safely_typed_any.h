@@ -63,4 +63,35 @@ AnyVector     safely_cast_any_vector_any(std::any const& a);
 AnyDictionary& temp_safely_cast_any_dictionary_any(std::any const& a);
 AnyVector&     temp_safely_cast_any_vector_any(std::any const& a);
 
+/**
+ * The closed set of types that OTIO reads from and writes to a serialized
+ * value, so that code handling an any can switch on its kind rather than
+ * look its type_info up in a table.
+ */
+enum class AnyKind : uint8_t
+{
+    empty,
+    bool_value,
+    int_value,
+    int64_value,
+    uint64_value,
+    double_value,
+    string,
+    c_string,
+    rational_time,
+    time_range,
+    time_transform,
+    point,
+    box,
+    retainer,
+    reference_id,
+    any_dictionary,
+    any_vector,
+    other
+};
+
+// The kind of a, which is AnyKind::other for any type not listed above.
+// Like the casts above, this is safe against type aliasing.
+AnyKind any_kind(std::any const& a);
+
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
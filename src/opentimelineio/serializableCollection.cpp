@@ -22,6 +22,7 @@ void
 SerializableCollection::clear_children()
 {
     _children.clear();
+    _changed();
 }
 
 void
@@ -29,6 +30,7 @@ SerializableCollection::set_children(
     std::vector<SerializableObject*> const& children)
 {
     _children = decltype(_children)(children.begin(), children.end());
+    _changed();
 }
 
 void
@@ -43,6 +45,7 @@ SerializableCollection::insert_child(int index, SerializableObject* child)
     {
         _children.insert(_children.begin() + std::max(index, 0), child);
     }
+    _changed();
 }
 
 bool
@@ -62,6 +65,7 @@ SerializableCollection::set_child(
     }
 
     _children[index] = child;
+    _changed();
     return true;
 }
 
@@ -88,6 +92,7 @@ SerializableCollection::remove_child(int index, ErrorStatus* error_status)
         _children.erase(_children.begin() + std::max(index, 0));
     }
 
+    _changed();
     return true;
 }
 
@@ -7,14 +7,41 @@
 #include "stringUtils.h"
 #include "typeRegistry.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
 
-SerializableObject::SerializableObject()
-    : _cached_type_record(nullptr)
+namespace {
+
+std::atomic<uint64_t> last_generation{ 0 };
+
+uint64_t
+next_generation() noexcept
+{
+    return last_generation.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+// Held while settling, which readers on several threads may set off at
+// once; recursive, since settling an object settles what it holds.
+std::recursive_mutex&
+settle_mutex()
 {
-    _managed_ref_count = 0;
+    static std::recursive_mutex mutex;
+    return mutex;
 }
 
+} // namespace
+
+SerializableObject::SerializableObject()
+    : _cached_type_record(nullptr)
+    , _managed_ref_count(0)
+    , _has_keepalive_monitor(false)
+    , _generation(next_generation())
+    , _unsettled(false)
+{}
+
 SerializableObject::~SerializableObject()
 {}
 
@@ -40,28 +67,54 @@ SerializableObject::Reader::fwd_type_name_for_error_message(
 TypeRegistry::_TypeRecord const*
 SerializableObject::_type_record() const
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-    if (!_cached_type_record)
+    auto type_record = _cached_type_record.load(std::memory_order_acquire);
+    if (!type_record || type_record == _unregistered_type_record())
     {
-        _cached_type_record =
+        // Threads racing here all find the same record, so whichever store
+        // lands last is as good as any other.
+        type_record =
             TypeRegistry::instance()._lookup_type_record(typeid(*this));
-        if (!_cached_type_record)
+        if (!type_record)
         {
             fatal_error(string_printf(
                 "Code for C++ type %s has not been registered via "
                 "TypeRegistry::register_type<T>()",
                 type_name_for_error_message(typeid(*this)).c_str()));
         }
+        _cached_type_record.store(type_record, std::memory_order_release);
+    }
+
+    return type_record;
+}
+
+uint32_t
+SerializableObject::_lookup_type_tags() const
+{
+    // Unlike _type_record(), an unregistered type is not an error here:
+    // fast_cast() falls back on dynamic_cast for its objects. That is
+    // remembered too, so that the registry is not locked again; if the
+    // type is registered later, the object keeps testing with dynamic_cast.
+    TypeRegistry::_TypeRecord const* type_record =
+        TypeRegistry::instance()._lookup_type_record(typeid(*this));
+    if (!type_record)
+    {
+        type_record = _unregistered_type_record();
     }
+    _cached_type_record.store(type_record, std::memory_order_release);
+    return type_record->type_tags;
+}
 
-    return _cached_type_record;
+TypeRegistry::_TypeRecord const*
+SerializableObject::_unregistered_type_record()
+{
+    static TypeRegistry::_TypeRecord const record("", 0, "", nullptr, 0);
+    return &record;
 }
 
 bool
 SerializableObject::_is_deletable()
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-    return _managed_ref_count == 0;
+    return _managed_ref_count.load(std::memory_order_acquire) == 0;
 }
 
 bool
@@ -75,23 +128,57 @@ SerializableObject::possibly_delete()
     return true;
 }
 
+namespace {
+
+// A clone is handed the dynamic fields of the original as a whole, under
+// this key; nothing read from a file can hold a SharedAnyDictionary.
+std::string const shared_dynamic_fields_key = "__dynamic_fields__";
+
+} // namespace
+
 bool
 SerializableObject::read_from(Reader& reader)
 {
+    auto shared = reader._dict.find(shared_dynamic_fields_key);
+    if (shared != reader._dict.end()
+        && shared->second.type() == typeid(SharedAnyDictionary))
+    {
+        SharedAnyDictionary fields =
+            std::move(std::any_cast<SharedAnyDictionary&>(shared->second));
+        reader._dict.erase(shared);
+        if (_dynamic_fields.get().empty())
+        {
+            _dynamic_fields = std::move(fields);
+        }
+        else
+        {
+            for (auto const& e: fields.get())
+            {
+                _dynamic_fields.detach()[e.first] = e.second;
+            }
+        }
+    }
+
+    if (reader._dict.empty())
+    {
+        return true;
+    }
+
     /*
      * Want to move everything from reader._dict into
      * _dynamic_fields, overwriting as we go.
      */
+    AnyDictionary& dynamic_fields = _dynamic_fields.detach();
     for (auto& e: reader._dict)
     {
-        auto it = _dynamic_fields.find(e.first);
-        if (it != _dynamic_fields.end())
+        auto it = dynamic_fields.find(e.first);
+        if (it != dynamic_fields.end())
         {
             it->second.swap(e.second);
         }
         else
         {
-            _dynamic_fields.emplace(e.first, std::move(e.second));
+            dynamic_fields.emplace(e.first, std::move(e.second));
         }
     }
     return true;
@@ -100,7 +187,13 @@ SerializableObject::read_from(Reader& reader)
 void
 SerializableObject::write_to(Writer& writer) const
 {
-    for (auto e: _dynamic_fields)
+    if (_dynamic_fields.get().empty()
+        || writer._write_shared(shared_dynamic_fields_key, _dynamic_fields))
+    {
+        return;
+    }
+
+    for (auto const& e: _dynamic_fields.get())
     {
         writer.write(e.first, e.second);
     }
@@ -205,11 +298,9 @@ SerializableObject::_schema_name_for_reference() const
 void
 SerializableObject::_managed_retain()
 {
-    {
-        std::lock_guard<std::mutex> lock(_mutex);
-        if (_managed_ref_count++ != 1 || !_external_keepalive_monitor)
-            return;
-    }
+    if (_managed_ref_count.fetch_add(1, std::memory_order_relaxed) != 1
+        || !_has_keepalive_monitor.load(std::memory_order_acquire))
+        return;
 
     // We just changed from unique (old ref count was 1) to non-unique
     // and we know we have a monitor.
@@ -219,25 +310,20 @@ SerializableObject::_managed_retain()
 void
 SerializableObject::_managed_release()
 {
-    _mutex.lock();
-
-    if (--_managed_ref_count == 0)
+    int old_count = _managed_ref_count.fetch_sub(1, std::memory_order_acq_rel);
+    if (old_count == 1)
     {
-        _mutex.unlock();
         delete this;
         return;
     }
 
-    if (_managed_ref_count != 1 || !_external_keepalive_monitor)
-    {
-        _mutex.unlock();
+    if (old_count != 2
+        || !_has_keepalive_monitor.load(std::memory_order_acquire))
         return;
-    }
 
     // We just changed back to unique (new ref count is 1)
-    // and we know we have a monitor.
-
-    _mutex.unlock();
+    // and we know we have a monitor. The monitor reads the count again
+    // itself, so it copes with other threads changing it meanwhile.
     _external_keepalive_monitor();
 }
 
@@ -251,6 +337,7 @@ SerializableObject::install_external_keepalive_monitor(
         if (!_external_keepalive_monitor)
         {
             _external_keepalive_monitor = monitor;
+            _has_keepalive_monitor.store(true, std::memory_order_release);
         }
     }
 
@@ -263,8 +350,158 @@ SerializableObject::install_external_keepalive_monitor(
 int
 SerializableObject::current_ref_count() const
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-    return _managed_ref_count;
+    return _managed_ref_count.load(std::memory_order_acquire);
+}
+
+int
+SerializableObject::add_change_observer(ChangeObserver observer)
+{
+    if (!_change_observers)
+    {
+        _change_observers.reset(new _ChangeObservers);
+    }
+    int id = _change_observers->next_id++;
+    _change_observers->observers.emplace_back(
+        new _ChangeObserver{ id, std::move(observer) });
+    return id;
+}
+
+void
+SerializableObject::remove_change_observer(int observer_id)
+{
+    if (!_change_observers)
+    {
+        return;
+    }
+
+    auto& observers = _change_observers->observers;
+    if (_change_observers->notifying)
+    {
+        for (auto const& e: observers)
+        {
+            if (e->id == observer_id)
+            {
+                e->removed                  = true;
+                _change_observers->removed = true;
+            }
+        }
+        return;
+    }
+
+    observers.erase(
+        std::remove_if(
+            observers.begin(),
+            observers.end(),
+            [observer_id](std::unique_ptr<_ChangeObserver> const& e) {
+                return e->id == observer_id;
+            }),
+        observers.end());
+}
+
+void
+SerializableObject::_changed(SerializableObject* changed)
+{
+    _generation = next_generation();
+
+    if (_change_observers && !_change_observers->observers.empty())
+    {
+        auto&        change_observers = *_change_observers;
+        size_t const count            = change_observers.observers.size();
+        ++change_observers.notifying;
+        for (size_t i = 0; i < count; ++i)
+        {
+            _ChangeObserver const& e = *change_observers.observers[i];
+            if (!e.removed)
+            {
+                e.observer(changed);
+            }
+        }
+        if (--change_observers.notifying == 0 && change_observers.removed)
+        {
+            auto& observers = change_observers.observers;
+            observers.erase(
+                std::remove_if(
+                    observers.begin(),
+                    observers.end(),
+                    [](std::unique_ptr<_ChangeObserver> const& e) {
+                        return e->removed;
+                    }),
+                observers.end());
+            change_observers.removed = false;
+        }
+    }
+
+    if (auto parent = _change_parent())
+    {
+        parent->_changed(changed);
+    }
+}
+
+SerializableObject*
+SerializableObject::_change_parent() const
+{
+    return _held_by;
+}
+
+void
+SerializableObject::_set_holder(
+    SerializableObject* held,
+    SerializableObject* holder)
+{
+    held->_held_by = holder;
+    if (holder && held->_unsettled.load(std::memory_order_relaxed))
+    {
+        holder->_unsettle();
+    }
+}
+
+void
+SerializableObject::_release_held(
+    SerializableObject* held,
+    SerializableObject* holder)
+{
+    if (held && held->_held_by == holder)
+    {
+        held->_held_by = nullptr;
+    }
+}
+
+void
+SerializableObject::_unsettle()
+{
+    // Whatever contains an unsettled object is unsettled too, so the walk
+    // can stop at the first object that already is.
+    for (SerializableObject* object = this;
+         object && !object->_unsettled.load(std::memory_order_relaxed);
+         object = object->_change_parent())
+    {
+        object->_unsettled.store(true, std::memory_order_release);
+    }
+}
+
+void
+SerializableObject::_settle_held()
+{}
+
+void
+SerializableObject::_settle() const
+{
+    std::lock_guard<std::recursive_mutex> lock(settle_mutex());
+    if (!_unsettled.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    // Settling records modifications that were already made, so it does
+    // not change what this instance is.
+    const_cast<SerializableObject*>(this)->_settle_held();
+    _unsettled.store(false, std::memory_order_release);
+}
+
+void
+AnyDictionary::_owner_modified(SerializableObject* owner)
+{
+    owner->_changed();
 }
 
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -9,15 +9,21 @@
 #include "opentimelineio/anyDictionary.h"
 #include "opentimelineio/anyVector.h"
 #include "opentimelineio/errorStatus.h"
+#include "opentimelineio/instrumentation.h"
+#include "opentimelineio/sharedAnyDictionary.h"
 #include "opentimelineio/typeRegistry.h"
 #include "opentimelineio/version.h"
 
 #include "Imath/ImathBox.h"
 #include "serialization.h"
 
+#include <atomic>
+#include <cstdint>
 #include <list>
+#include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
 
@@ -74,7 +80,58 @@ public:
 
     // Allow external system (e.g. Python, Swift) to add serializable fields
     // on the fly.  C++ implementations should have no need for this functionality.
-    AnyDictionary& dynamic_fields() { return _dynamic_fields; }
+    AnyDictionary& dynamic_fields()
+    {
+        return _dynamic_fields.mutable_get(this);
+    }
+
+    // As SerializableObjectWithMetadata::lend_metadata(), for the dynamic
+    // fields.
+    AnyDictionary::MutationStamp* lend_dynamic_fields()
+    {
+        return _dynamic_fields.lend(this);
+    }
+
+    // A number that increases whenever this instance is modified, or, for
+    // instances that contain others (such as compositions, clips and their
+    // media references, markers and effects, and timelines and their
+    // tracks), whenever anything they contain is modified.
+    //
+    // Generations are drawn from a single process wide counter, so a
+    // generation identifies one state of one object: a cache can hold on to
+    // the generation it was computed from and compare it later.
+    //
+    // Modifications are counted when made through setters, and through the
+    // dictionaries returned by metadata() and dynamic_fields() (see
+    // AnyDictionary).  Markers and effects added to or removed from the
+    // vectors returned by Item::markers() and Item::effects() are counted
+    // when the generation of the item, or of something containing it, is
+    // next read; calling those accessors again is needed to make later
+    // changes to the vectors count.
+    uint64_t generation() const
+    {
+        if (_unsettled.load(std::memory_order_acquire))
+        {
+            _settle();
+        }
+        return _generation;
+    }
+
+    // A function called whenever this instance is modified, with the
+    // object that was modified: either this instance, or something it
+    // contains.
+    //
+    // Observers are called synchronously on the thread making the
+    // modification, after it has been made, or, for changes to the marker
+    // and effect vectors of items, on the thread that notices them (see
+    // generation()).  Observers must not throw, and may add and remove
+    // observers; those added are first called for the next modification.
+    using ChangeObserver = std::function<void(SerializableObject* changed)>;
+
+    // Adds an observer and returns an id for removing it again.
+    int add_change_observer(ChangeObserver observer);
+
+    void remove_change_observer(int observer_id);
 
     template <typename T = SerializableObject>
     struct Retainer;
@@ -101,6 +158,7 @@ public:
         bool read(std::string const& key, IMATH_NAMESPACE::Box2d* value);
         bool read(std::string const& key, AnyVector* dest);
         bool read(std::string const& key, AnyDictionary* dest);
+        bool read(std::string const& key, SharedAnyDictionary* dest);
         bool read(std::string const& key, std::any* dest);
 
         bool read(std::string const& key, std::optional<bool>* dest);
@@ -189,6 +247,8 @@ public:
 
             void finalize(error_function_t error_function)
             {
+                OTIO_TRACE_SCOPE("Reader::_Resolver::finalize");
+
                 for (auto e: data_for_object)
                 {
                     int line_number = line_number_for_object[e.first];
@@ -432,6 +492,7 @@ public:
             write(key, (SerializableObject const*) (value));
         }
         void write(std::string const& key, AnyDictionary const& value);
+        void write(std::string const& key, SharedAnyDictionary const& value);
         void write(std::string const& key, AnyVector const& value);
         void write(std::string const& key, std::any const& value);
 
@@ -525,18 +586,17 @@ public:
             const schema_version_map* downgrade_version_manifest)
             : _encoder(encoder)
             , _downgrade_version_manifest(downgrade_version_manifest)
-
-        {
-            _build_dispatch_tables();
-        }
+        {}
 
         ~Writer();
 
         Writer(Writer const&)           = delete;
         Writer operator=(Writer const&) = delete;
 
-        void _build_dispatch_tables();
         void _write(std::string const& key, std::any const& value);
+        bool _write_shared(
+            std::string const&         key,
+            SharedAnyDictionary const& value);
         void _encoder_write_key(std::string const& key);
 
         bool _any_dict_equals(std::any const& lhs, std::any const& rhs);
@@ -544,17 +604,6 @@ public:
         bool _any_equals(std::any const& lhs, std::any const& rhs);
 
         std::string _no_key;
-        std::unordered_map<
-            std::type_info const*,
-            std::function<void(std::any const&)>>
-            _write_dispatch_table;
-        std::unordered_map<
-            std::type_info const*,
-            std::function<bool(std::any const&, std::any const&)>>
-            _equality_dispatch_table;
-
-        std::unordered_map<std::string, std::function<void(std::any const&)>>
-            _write_dispatch_table_by_name;
         std::unordered_map<SerializableObject const*, std::string>
                                              _id_for_object;
         std::unordered_map<std::string, int> _next_id_for_type;
@@ -562,9 +611,14 @@ public:
         Writer*         _child_writer          = nullptr;
         CloningEncoder* _child_cloning_encoder = nullptr;
 
+        // If set, this object's children are written as an empty list
+        // (see Composition::clone_without_children()).
+        SerializableObject const* _omit_children_of = nullptr;
+
         class Encoder&            _encoder;
         const schema_version_map* _downgrade_version_manifest;
         friend class SerializableObject;
+        friend class Composition;
     };
 
     virtual bool read_from(Reader&);
@@ -576,6 +630,14 @@ public:
 
     int schema_version() const { return _type_record()->schema_version; }
 
+    /// The TypeTag bits of the core classes this object is or derives from,
+    /// including TypeTag::KNOWN; zero if its type did not register them.
+    uint32_t type_tags() const
+    {
+        auto type_record = _cached_type_record.load(std::memory_order_acquire);
+        return type_record ? type_record->type_tags : _lookup_type_tags();
+    }
+
     template <typename T>
     struct Retainer
     {
@@ -622,7 +684,7 @@ public:
 
             T* ptr = value;
             value  = nullptr;
-            ptr->_managed_ref_count--;
+            ptr->_managed_ref_count.fetch_sub(1, std::memory_order_acq_rel);
             return ptr;
         }
 
@@ -632,10 +694,56 @@ public:
 protected:
     virtual ~SerializableObject();
 
+    // Clone this instance as clone() does, but if omit_children_of is set,
+    // the children of that composition are not written or cloned.
+    SerializableObject* _clone(
+        ErrorStatus*              error_status,
+        SerializableObject const* omit_children_of) const;
+
     virtual bool _is_deletable();
 
     virtual std::string _schema_name_for_reference() const;
 
+    // Record that this instance was modified: bump its generation, notify
+    // its observers, and pass the change on to whatever contains it.
+    void _changed() { _changed(this); }
+
+    // Record that changed, which is this instance or something contained
+    // in it, was modified.
+    void _changed(SerializableObject* changed);
+
+    // The object containing this instance, if any, which is told about its
+    // modifications: by default, the holder set by _set_holder().
+    virtual SerializableObject* _change_parent() const;
+
+    // Make holder (which may be null) the object that held is passed on
+    // to by _change_parent(), for objects held other than as children of
+    // a composition, such as markers and effects.
+    static void
+    _set_holder(SerializableObject* held, SerializableObject* holder);
+
+    // Clear the holder of held (which may be null) if it is holder.
+    static void
+    _release_held(SerializableObject* held, SerializableObject* holder);
+
+    SerializableObject* _holder() const noexcept { return _held_by; }
+
+    // Record that this instance handed out something it holds by
+    // reference (see Item::markers()), so that the next generation() of
+    // this instance, or of anything containing it, calls _settle_held()
+    // first.
+    void _unsettle();
+
+    bool _is_unsettled() const noexcept
+    {
+        return _unsettled.load(std::memory_order_relaxed);
+    }
+
+    // Look for modifications made through what this instance handed out,
+    // and settle the objects it holds that need it (by reading their
+    // generations), recording what changed with _changed().
+    virtual void _settle_held();
+
 private:
     SerializableObject(SerializableObject const&)            = delete;
     SerializableObject& operator=(SerializableObject const&) = delete;
@@ -669,19 +777,71 @@ public:
 private:
     void _set_type_record(TypeRegistry::_TypeRecord const* type_record)
     {
-        _cached_type_record = type_record;
+        _cached_type_record.store(type_record, std::memory_order_release);
     }
 
     TypeRegistry::_TypeRecord const* _type_record() const;
+    uint32_t                         _lookup_type_tags() const;
+
+    // Cached by objects whose type is not registered, so that type_tags()
+    // only looks them up once; it has no tags.
+    static TypeRegistry::_TypeRecord const* _unregistered_type_record();
+
+    // Readers on several threads may look up the type record and retain
+    // and release the same object at once, so these are atomic rather than
+    // guarded by _mutex; see the thread safety notes in docs/cxx/cxx.rst.
+    mutable std::atomic<TypeRegistry::_TypeRecord const*> _cached_type_record;
+    std::atomic<int>                                      _managed_ref_count;
+
+    // Set once, under _mutex; _has_keepalive_monitor is set after it so
+    // that a thread seeing the flag may call the monitor without locking.
+    std::function<void()> _external_keepalive_monitor;
+    std::atomic<bool>     _has_keepalive_monitor;
+
+    void _settle() const;
+
+    // Changed only while _unsettled is set, or by a modification; see
+    // generation().
+    uint64_t                  _generation;
+    mutable std::atomic<bool> _unsettled;
+    SerializableObject*       _held_by = nullptr;
+
+    // Allocated on demand, since most objects are never observed.  Each
+    // observer is allocated on its own so that it stays put while called,
+    // whatever it adds; those removed while observers are being called
+    // are only marked, and erased once the outermost call returns.
+    struct _ChangeObserver
+    {
+        int            id;
+        ChangeObserver observer;
+        bool           removed = false;
+    };
+    struct _ChangeObservers
+    {
+        std::vector<std::unique_ptr<_ChangeObserver>> observers;
+        int                                           next_id   = 0;
+        int                                           notifying = 0;
+        bool                                          removed   = false;
+    };
+    std::unique_ptr<_ChangeObservers> _change_observers;
 
-    mutable TypeRegistry::_TypeRecord const* _cached_type_record;
-    int                                      _managed_ref_count;
-    std::function<void()>                    _external_keepalive_monitor;
+    // The content hash last computed for this instance, and the generation
+    // it was computed at; see content_hash(). Allocated on demand, and
+    // guarded by _mutex since several threads may hash the same object.
+    struct _ContentHashMemo
+    {
+        uint64_t generation;
+        uint64_t high;
+        uint64_t low;
+    };
+    mutable std::unique_ptr<_ContentHashMemo> _content_hash_memo;
 
     mutable std::mutex _mutex;
 
-    AnyDictionary _dynamic_fields;
+    SharedAnyDictionary _dynamic_fields;
     friend class TypeRegistry;
+    friend class HashEncoder;
+    friend class AnyDictionary;
 };
 
 template <class T, class U>
@@ -691,4 +851,41 @@ dynamic_retainer_cast(SerializableObject::Retainer<U> const& retainer)
     return dynamic_cast<T*>(retainer.value);
 }
 
+/// Cast so to T* as dynamic_cast does. When T is one of the core classes
+/// with a TypeTag and the tags of so are known, this is a test of the tags
+/// rather than a dynamic_cast.
+template <class T>
+inline T*
+fast_cast(SerializableObject* so)
+{
+    constexpr uint32_t tag = TypeTagOf<T>::value;
+    if constexpr (tag != 0)
+    {
+        if (!so)
+        {
+            return nullptr;
+        }
+        uint32_t tags = so->type_tags();
+        if (tags & TypeTag::KNOWN)
+        {
+            return (tags & tag) ? static_cast<T*>(so) : nullptr;
+        }
+    }
+    return dynamic_cast<T*>(so);
+}
+
+template <class T>
+inline T const*
+fast_cast(SerializableObject const* so)
+{
+    return fast_cast<T>(const_cast<SerializableObject*>(so));
+}
+
+template <class T, class U>
+SerializableObject::Retainer<T>
+fast_retainer_cast(SerializableObject::Retainer<U> const& retainer)
+{
+    return fast_cast<T>(retainer.value);
+}
+
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -25,11 +25,33 @@ public:
 
     std::string name() const noexcept { return _name; }
 
-    void set_name(std::string const& name) { _name = name; }
+    void set_name(std::string const& name)
+    {
+        _name = name;
+        _changed();
+    }
+
+    // Clones share their metadata until one of them asks for it here, at
+    // which point it is copied if need be.  Writes made through the
+    // dictionary returned count as modifications of this object.
+    AnyDictionary& metadata() { return _metadata.mutable_get(this); }
 
-    AnyDictionary& metadata() noexcept { return _metadata; }
+    // For callers that hold on to the metadata through a mutation stamp
+    // rather than a reference, such as Python: unlike metadata(), this
+    // only keeps it from being shared with clones while the stamp lives.
+    AnyDictionary::MutationStamp* lend_metadata()
+    {
+        return _metadata.lend(this);
+    }
 
-    AnyDictionary metadata() const noexcept { return _metadata; }
+    AnyDictionary metadata() const noexcept { return _metadata.get(); }
+
+    // The metadata, read in place rather than copied, and without marking
+    // it as handed out for modification.
+    AnyDictionary const& metadata_ref() const noexcept
+    {
+        return _metadata.get();
+    }
 
 protected:
     virtual ~SerializableObjectWithMetadata();
@@ -38,8 +60,8 @@ protected:
     void write_to(Writer&) const override;
 
 private:
-    std::string   _name;
-    AnyDictionary _metadata;
+    std::string         _name;
+    SharedAnyDictionary _metadata;
 };
 
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -4,11 +4,23 @@
 #include "opentimelineio/serialization.h"
 #include "errorStatus.h"
 #include "opentimelineio/anyDictionary.h"
+#include "opentimelineio/contentHash.h"
+#include "opentimelineio/instrumentation.h"
+#include "opentimelineio/memoryFootprint.h"
+#include "opentimelineio/safely_typed_any.h"
 #include "opentimelineio/serializableObject.h"
 #include "opentimelineio/unknownSchema.h"
 #include "stringUtils.h"
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 
 #define RAPIDJSON_NAMESPACE OTIO_rapidjson
 #include <rapidjson/ostreamwrapper.h>
@@ -58,6 +70,21 @@ public:
 
     virtual bool encoding_to_anydict() { return false; }
 
+    // Encoders that build values in memory may share dictionaries with the
+    // objects they encode, rather than be walked through copies of them.
+    virtual bool shares_dictionaries() { return false; }
+    virtual void write_value(SharedAnyDictionary const&) {}
+
+    // Called before an object is written: encoders that keep what they
+    // found for objects they were given before may write that instead, and
+    // return true to have the object skipped.
+    virtual bool write_known(SerializableObject const*) { return false; }
+
+    // Called before an optional field of an object is written, with the
+    // size of the field, which the value (or null) that follows does not
+    // tell.
+    virtual void write_optional(size_t) {}
+
     virtual void start_object() = 0;
     virtual void end_object()   = 0;
 
@@ -157,12 +184,12 @@ public:
             auto& top = _stack.back();
             if (top.is_dict)
             {
-                top.dict.emplace(top.cur_key, a);
+                top.dict.emplace(top.cur_key, std::move(a));
             }
             else
             {
                 std::any newstack(std::move(a));
-                top.array.emplace_back(newstack);
+                top.array.emplace_back(std::move(newstack));
             }
         }
     }
@@ -183,15 +210,26 @@ public:
             auto& top = _stack.back();
             if (top.is_dict)
             {
-                top.dict.emplace(_stack.back().cur_key, a);
+                top.dict.emplace(_stack.back().cur_key, std::move(a));
             }
             else
             {
-                top.array.emplace_back(a);
+                top.array.emplace_back(std::move(a));
             }
         }
     }
 
+    bool shares_dictionaries() override
+    {
+        return _result_object_policy
+               == ResultObjectPolicy::CloneBackToSerializableObject;
+    }
+
+    void write_value(SharedAnyDictionary const& value) override
+    {
+        _store(std::any(value));
+    }
+
     void write_null_value() override { _store(std::any()); }
     void write_value(bool value) override { _store(std::any(value)); }
     void write_value(int value) override { _store(std::any(value)); }
@@ -474,15 +512,15 @@ private:
 
         const int target_version = static_cast<int>(dg_version_it->second);
 
-        const auto& type_rec =
-            (TypeRegistry::instance()._find_type_record(schema_name));
+        auto& type_registry = TypeRegistry::instance();
 
         while (current_version > target_version)
         {
-            const auto& next_dg_fn =
-                (type_rec->downgrade_functions.find(current_version));
+            const auto next_dg_fn = type_registry._lookup_downgrade_function(
+                schema_name,
+                current_version);
 
-            if (next_dg_fn == type_rec->downgrade_functions.end())
+            if (!next_dg_fn)
             {
                 _internal_error(string_printf(
                     "No downgrader function available for "
@@ -493,7 +531,8 @@ private:
             }
 
             // apply it
-            next_dg_fn->second(&m);
+            next_dg_fn(&m);
+            OTIO_COUNT("downgrade functions applied", 1);
 
             current_version--;
         }
@@ -636,129 +675,828 @@ private:
     RapidJSONWriterType& _writer;
 };
 
-template <typename T>
-bool
-_simple_any_comparison(std::any const& lhs, std::any const& rhs)
-{
-    return lhs.type() == typeid(T) && rhs.type() == typeid(T)
-           && std::any_cast<T const&>(lhs) == std::any_cast<T const&>(rhs);
-}
+// The largest value an std::any keeps in place rather than on the heap:
+// what is left of it after its manager pointer in libstdc++ and libc++, and
+// after one more pointer's worth of bookkeeping in MSVC.
+#if defined(_MSC_VER) && !defined(_LIBCPP_VERSION)
+constexpr size_t any_in_place_bytes = sizeof(std::any) - 2 * sizeof(void*);
+#else
+constexpr size_t any_in_place_bytes = sizeof(std::any) - sizeof(void*);
+#endif
 
-template <>
-bool
-_simple_any_comparison<void>(std::any const& lhs, std::any const& rhs)
+#ifndef OTIO_FLAT_ANY_DICTIONARY
+// An allocator that records the size of what it allocates, which for the
+// allocator of a std::map is the size of a node.
+template <class T>
+struct NodeSizeAllocator
 {
-    return lhs.type() == typeid(void) && rhs.type() == typeid(void);
-}
+    using value_type = T;
 
-template <>
-bool
-_simple_any_comparison<char const*>(std::any const& lhs, std::any const& rhs)
+    explicit NodeSizeAllocator(size_t* in_size)
+        : size(in_size)
+    {}
+
+    template <class U>
+    NodeSizeAllocator(NodeSizeAllocator<U> const& other)
+        : size(other.size)
+    {}
+
+    T* allocate(size_t n)
+    {
+        *size = sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) { std::allocator<T>().deallocate(p, n); }
+
+    template <class U>
+    bool operator==(NodeSizeAllocator<U> const& other) const
+    {
+        return size == other.size;
+    }
+
+    template <class U>
+    bool operator!=(NodeSizeAllocator<U> const& other) const
+    {
+        return size != other.size;
+    }
+
+    size_t* size;
+};
+#endif
+
+// What a dictionary entry costs besides its key and value: a tree node,
+// unless the entries are stored flat.
+static size_t
+dictionary_entry_bytes()
 {
-    return lhs.type() == typeid(char const*)
-           && rhs.type() == typeid(char const*)
-           && !strcmp(
-               std::any_cast<char const*>(lhs),
-               std::any_cast<char const*>(rhs));
+#ifdef OTIO_FLAT_ANY_DICTIONARY
+    return 0;
+#else
+    using Entry = AnyDictionary::value_type;
+    static size_t const bytes = [] {
+        size_t node_size = 0;
+        std::map<
+            std::string,
+            std::any,
+            std::less<std::string>,
+            NodeSizeAllocator<Entry>>
+            map{ NodeSizeAllocator<Entry>(&node_size) };
+        map.emplace();
+        return node_size - sizeof(Entry);
+    }();
+    return bytes;
+#endif
 }
 
-void
-SerializableObject::Writer::_build_dispatch_tables()
+/**
+ * This encoder adds up the memory held by what it is given, rather than
+ * recording it, for memory_footprint().  The Writer hands it the fields
+ * of objects, not the objects themselves, so the size of each value is
+ * estimated from its type and from where it is stored: in a field of an
+ * object, or in an std::any inside a dictionary or an array.
+ */
+class FootprintEncoder : public Encoder
 {
-    /*
-     * These are basically atomic writes to the encoder:
-     */
+public:
+    FootprintEncoder(MemoryFootprint& footprint)
+        : _footprint(footprint)
+    {}
 
-    auto& wt          = _write_dispatch_table;
-    wt[&typeid(void)] = [this](std::any const&) {
-        _encoder.write_null_value();
-    };
-    wt[&typeid(bool)] = [this](std::any const& value) {
-        _encoder.write_value(std::any_cast<bool>(value));
-    };
-    wt[&typeid(int64_t)] = [this](std::any const& value) {
-        _encoder.write_value(std::any_cast<int64_t>(value));
-    };
-    wt[&typeid(double)] = [this](std::any const& value) {
-        _encoder.write_value(std::any_cast<double>(value));
-    };
-    wt[&typeid(std::string)] = [this](std::any const& value) {
-        _encoder.write_value(std::any_cast<std::string const&>(value));
-    };
-    wt[&typeid(char const*)] = [this](std::any const& value) {
-        _encoder.write_value(std::string(std::any_cast<char const*>(value)));
-    };
-    wt[&typeid(RationalTime)] = [this](std::any const& value) {
-        _encoder.write_value(std::any_cast<RationalTime const&>(value));
-    };
-    wt[&typeid(TimeRange)] = [this](std::any const& value) {
-        _encoder.write_value(std::any_cast<TimeRange const&>(value));
-    };
-    wt[&typeid(TimeTransform)] = [this](std::any const& value) {
-        _encoder.write_value(std::any_cast<TimeTransform const&>(value));
+    virtual ~FootprintEncoder() {}
+
+    // Shared dictionaries are counted directly, and only once.
+    bool shares_dictionaries() override { return true; }
+
+    void write_value(SharedAnyDictionary const& value) override
+    {
+        size_t               bytes      = sizeof(SharedAnyDictionary);
+        AnyDictionary const& dictionary = value.get();
+        if (!dictionary.empty() && _dictionaries.insert(&dictionary).second)
+        {
+            bytes += _shared_block_bytes + _dictionary_bytes(dictionary);
+        }
+        _value(bytes);
+    }
+
+    void start_object() override { _start(_Frame::dictionary); }
+
+    void end_object() override
+    {
+        _Frame frame = std::move(_stack.back());
+        _stack.pop_back();
+
+        if (frame.kind == _Frame::dictionary)
+        {
+            _end_container(frame, sizeof(AnyDictionary));
+            return;
+        }
+
+        size_t const bytes = sizeof(SerializableObject) + frame.bytes;
+        auto&        schema = _footprint.schemas[frame.schema];
+        ++schema.objects;
+        schema.bytes += bytes;
+        ++_footprint.object_count;
+        _footprint.total_bytes += bytes;
+
+        // the parent holds the object by a Retainer
+        _value(_storage(sizeof(SerializableObject::Retainer<>)));
+    }
+
+    void start_array(size_t) override { _start(_Frame::array); }
+
+    void end_array() override
+    {
+        _Frame frame = std::move(_stack.back());
+        _stack.pop_back();
+        _end_container(frame, sizeof(AnyVector));
+    }
+
+    void write_key(std::string const& key) override
+    {
+        _Frame& frame = _stack.back();
+        if (frame.kind == _Frame::dictionary && frame.entries == 0
+            && (key == "OTIO_SCHEMA" || key == "OTIO_REF_ID"))
+        {
+            frame.kind = _Frame::object;
+        }
+
+        if (frame.kind == _Frame::object)
+        {
+            // The names of fields are not stored with the objects.
+            _schema_next   = key == "OTIO_SCHEMA";
+            _ignore_next   = _schema_next || key == "OTIO_REF_ID";
+            _metadata_next = key == "metadata";
+            return;
+        }
+
+        ++frame.entries;
+        frame.bytes += dictionary_entry_bytes() + sizeof(std::string)
+                       + _string_heap_bytes(key);
+    }
+
+    void write_optional(size_t size) override { _optional_next = size; }
+
+    void write_null_value() override { _value(_storage(0)); }
+    void write_value(bool) override { _value(_storage(sizeof(bool))); }
+    void write_value(int) override { _value(_storage(sizeof(int))); }
+    void write_value(int64_t) override { _value(_storage(sizeof(int64_t))); }
+
+    void write_value(uint64_t) override
+    {
+        _value(_storage(sizeof(uint64_t)));
+    }
+
+    void write_value(double) override { _value(_storage(sizeof(double))); }
+
+    void write_value(std::string const& value) override
+    {
+        if (_schema_next)
+        {
+            // strip the version from "Schema.version"
+            _stack.back().schema = value.substr(0, value.rfind('.'));
+        }
+        if (_ignore_next)
+        {
+            _schema_next = _ignore_next = false;
+            return;
+        }
+        _value(_storage(sizeof(std::string)) + _string_heap_bytes(value));
+    }
+
+    void write_value(RationalTime const&) override
+    {
+        _value(_storage(sizeof(RationalTime)));
+    }
+
+    void write_value(TimeRange const&) override
+    {
+        _value(_storage(sizeof(TimeRange)));
+    }
+
+    void write_value(TimeTransform const&) override
+    {
+        _value(_storage(sizeof(TimeTransform)));
+    }
+
+    void write_value(SerializableObject::ReferenceId) override
+    {
+        // an object already counted, held once more
+        _value(_storage(sizeof(SerializableObject::Retainer<>)));
+    }
+
+    void write_value(IMATH_NAMESPACE::V2d const&) override
+    {
+        _value(_storage(sizeof(IMATH_NAMESPACE::V2d)));
+    }
+
+    void write_value(IMATH_NAMESPACE::Box2d const&) override
+    {
+        _value(_storage(sizeof(IMATH_NAMESPACE::Box2d)));
+    }
+
+private:
+    struct _Frame
+    {
+        enum Kind
+        {
+            object,
+            dictionary,
+            array
+        };
+
+        Kind        kind;
+        bool        in_object;
+        bool        metadata;
+        size_t      entries = 0;
+        size_t      bytes   = 0;
+        std::string schema;
     };
-    wt[&typeid(IMATH_NAMESPACE::V2d)] = [this](std::any const& value) {
-        _encoder.write_value(std::any_cast<IMATH_NAMESPACE::V2d const&>(value));
+
+    // The bytes to store a value of the given size where the next value
+    // goes: in place in a field of an object (or in an array of children),
+    // or in an std::any, which keeps only small values in place. An
+    // optional field takes the same room whether it holds a value or not.
+    size_t _storage(size_t size)
+    {
+        if (_optional_next)
+        {
+            size           = _optional_next;
+            _optional_next = 0;
+        }
+        if (_stack.empty())
+        {
+            return 0;
+        }
+        _Frame const& frame = _stack.back();
+        if (frame.kind == _Frame::object
+            || (frame.kind == _Frame::array && frame.in_object))
+        {
+            return size;
+        }
+        return _any_bytes(size);
+    }
+
+    static size_t _any_bytes(size_t size)
+    {
+        return sizeof(std::any) + (size > any_in_place_bytes ? size : 0);
+    }
+
+    // Strings short enough to be stored in place hold nothing on the heap.
+    size_t _string_heap_bytes(std::string const& s)
+    {
+        static size_t const in_place_capacity = std::string().capacity();
+        size_t const bytes =
+            s.capacity() > in_place_capacity ? s.capacity() + 1 : 0;
+        _footprint.string_bytes += bytes;
+        return bytes;
+    }
+
+    size_t _value_bytes(std::any const& value)
+    {
+        switch (any_kind(value))
+        {
+            case AnyKind::bool_value:
+                return _any_bytes(sizeof(bool));
+            case AnyKind::int64_value:
+                return _any_bytes(sizeof(int64_t));
+            case AnyKind::double_value:
+                return _any_bytes(sizeof(double));
+            case AnyKind::string:
+                return _any_bytes(sizeof(std::string))
+                       + _string_heap_bytes(
+                           std::any_cast<std::string const&>(value));
+            case AnyKind::c_string:
+                return _any_bytes(sizeof(char const*));
+            case AnyKind::rational_time:
+                return _any_bytes(sizeof(RationalTime));
+            case AnyKind::time_range:
+                return _any_bytes(sizeof(TimeRange));
+            case AnyKind::time_transform:
+                return _any_bytes(sizeof(TimeTransform));
+            case AnyKind::point:
+                return _any_bytes(sizeof(IMATH_NAMESPACE::V2d));
+            case AnyKind::box:
+                return _any_bytes(sizeof(IMATH_NAMESPACE::Box2d));
+            case AnyKind::any_dictionary:
+                return _any_bytes(sizeof(AnyDictionary))
+                       + _dictionary_bytes(
+                           std::any_cast<AnyDictionary const&>(value));
+            case AnyKind::any_vector: {
+                auto const& vector = std::any_cast<AnyVector const&>(value);
+                size_t      bytes  = _any_bytes(sizeof(AnyVector));
+                for (auto const& e: vector)
+                {
+                    bytes += _value_bytes(e);
+                }
+                return bytes;
+            }
+            default:
+                return sizeof(std::any);
+        }
+    }
+
+    size_t _dictionary_bytes(AnyDictionary const& dictionary)
+    {
+        size_t bytes = 0;
+        for (auto const& e: dictionary)
+        {
+            bytes += dictionary_entry_bytes() + sizeof(std::string)
+                     + _string_heap_bytes(e.first) + _value_bytes(e.second);
+        }
+#ifdef OTIO_FLAT_ANY_DICTIONARY
+        // the room reserved for entries yet to be added
+        bytes += (dictionary.capacity() - dictionary.size())
+                 * sizeof(AnyDictionary::value_type);
+#endif
+        return bytes;
+    }
+
+    void _start(_Frame::Kind kind)
+    {
+        bool const in_object =
+            !_stack.empty() && _stack.back().kind == _Frame::object;
+        _stack.push_back({ kind, in_object, _metadata_next, 0, 0, {} });
+        _metadata_next = false;
+    }
+
+    void _end_container(_Frame const& frame, size_t container_size)
+    {
+        size_t const bytes = _storage(container_size) + frame.bytes;
+        if (frame.metadata)
+        {
+            _footprint.metadata_bytes += bytes;
+        }
+        if (!_stack.empty())
+        {
+            _stack.back().bytes += bytes;
+        }
+    }
+
+    void _value(size_t bytes)
+    {
+        if (_metadata_next)
+        {
+            _footprint.metadata_bytes += bytes;
+            _metadata_next = false;
+        }
+        if (!_stack.empty())
+        {
+            _stack.back().bytes += bytes;
+        }
+    }
+
+    // What a shared dictionary costs besides its entries: the block that
+    // holds the dictionary and its share count.
+    static constexpr size_t _shared_block_bytes =
+        SharedAnyDictionary::block_bytes();
+
+    MemoryFootprint&                _footprint;
+    std::vector<_Frame>             _stack;
+    std::unordered_set<void const*> _dictionaries;
+    bool                            _schema_next   = false;
+    bool                            _ignore_next   = false;
+    bool                            _metadata_next = false;
+    size_t                          _optional_next = 0;
+};
+
+/**
+ * This encoder hashes what it is given, for content_hash().  Each object,
+ * dictionary and array is hashed on its own, from a compact binary form of
+ * its values in which what it holds appears as their hashes, so that the
+ * hash of an object that has not changed can be kept with it and used in
+ * place of walking it again.
+ *
+ * The hash kept with an object is only trusted while its generation stays
+ * the same, which needs everything it holds to pass changes on to it: such
+ * objects are "sealed".  An object is sealed if each object it holds is
+ * sealed and counts that object's changes as its own.
+ */
+class HashEncoder : public Encoder
+{
+public:
+    HashEncoder() {}
+
+    virtual ~HashEncoder() {}
+
+    ContentHash result;
+
+    bool write_known(SerializableObject const* object) override
+    {
+        ContentHash hash;
+        {
+            std::lock_guard<std::mutex> lock(object->_mutex);
+            auto const& memo = object->_content_hash_memo;
+            if (!memo || memo->generation != object->generation())
+            {
+                _next_object = object;
+                return false;
+            }
+            hash = { memo->high, memo->low };
+        }
+        _hashed(object, hash, true);
+        return true;
+    }
+
+    void start_object() override
+    {
+        _start(_next_object ? _Tag::object : _Tag::dictionary);
+    }
+
+    void end_object() override { _end(); }
+
+    void start_array(size_t) override { _start(_Tag::array); }
+
+    void end_array() override { _end(); }
+
+    void write_key(std::string const& key) override
+    {
+        _Frame& frame = _frames[_depth - 1];
+        if (frame.object && key == "OTIO_REF_ID")
+        {
+            // where the object was written, not what it holds
+            _skip_next = true;
+            return;
+        }
+        frame.keys.push_back(frame.bytes.size());
+        _append_string(frame.bytes, key);
+    }
+
+    void write_null_value() override { _tag(_Tag::null); }
+
+    void write_value(bool value) override
+    {
+        _tag(_Tag::boolean).push_back(value ? 1 : 0);
+    }
+
+    // Integers hash alike whatever type holds them, as they serialize alike.
+    void write_value(int value) override { write_value(int64_t(value)); }
+
+    void write_value(int64_t value) override
+    {
+        _append_word(_tag(_Tag::integer), uint64_t(value));
+    }
+
+    void write_value(uint64_t value) override
+    {
+        if (value <= uint64_t(std::numeric_limits<int64_t>::max()))
+        {
+            write_value(int64_t(value));
+            return;
+        }
+        _append_word(_tag(_Tag::unsigned_integer), value);
+    }
+
+    void write_value(double value) override
+    {
+        _append_double(_tag(_Tag::real), value);
+    }
+
+    void write_value(std::string const& value) override
+    {
+        if (_skip_next)
+        {
+            _skip_next = false;
+            return;
+        }
+        _append_string(_tag(_Tag::string), value);
+    }
+
+    void write_value(RationalTime const& value) override
+    {
+        _append_time(_tag(_Tag::rational_time), value);
+    }
+
+    void write_value(TimeRange const& value) override
+    {
+        std::string& bytes = _tag(_Tag::time_range);
+        _append_time(bytes, value.start_time());
+        _append_time(bytes, value.duration());
+    }
+
+    void write_value(TimeTransform const& value) override
+    {
+        std::string& bytes = _tag(_Tag::time_transform);
+        _append_time(bytes, value.offset());
+        _append_double(bytes, value.scale());
+        _append_double(bytes, value.rate());
+    }
+
+    void write_value(SerializableObject::ReferenceId value) override
+    {
+        // The id depends on the order objects are written in, so the
+        // objects holding it cannot keep their hashes.
+        _append_string(_tag(_Tag::reference_id), value.id);
+        for (size_t i = 0; i < _depth; ++i)
+        {
+            _frames[i].sealed = false;
+        }
+    }
+
+    void write_value(IMATH_NAMESPACE::V2d const& value) override
+    {
+        std::string& bytes = _tag(_Tag::v2d);
+        _append_double(bytes, value.x);
+        _append_double(bytes, value.y);
+    }
+
+    void write_value(IMATH_NAMESPACE::Box2d const& value) override
+    {
+        std::string& bytes = _tag(_Tag::box2d);
+        _append_double(bytes, value.min.x);
+        _append_double(bytes, value.min.y);
+        _append_double(bytes, value.max.x);
+        _append_double(bytes, value.max.y);
+    }
+
+private:
+    enum class _Tag : char
+    {
+        null,
+        boolean,
+        integer,
+        unsigned_integer,
+        real,
+        string,
+        rational_time,
+        time_range,
+        time_transform,
+        reference_id,
+        v2d,
+        box2d,
+        object,
+        dictionary,
+        array
     };
-    wt[&typeid(IMATH_NAMESPACE::Box2d)] = [this](std::any const& value) {
-        _encoder.write_value(
-            std::any_cast<IMATH_NAMESPACE::Box2d const&>(value));
+
+    // An object, dictionary or array being hashed. Frames are kept once
+    // popped, so that their buffers are reused.
+    struct _Frame
+    {
+        SerializableObject const* object = nullptr;
+        bool                      sealed = true;
+
+        // The tag, then each value; in objects and dictionaries, each value
+        // follows its key, and keys holds where each key starts.
+        std::string         bytes;
+        std::vector<size_t> keys;
     };
 
-    /*
-     * These next recurse back through the Writer itself:
-     */
-    wt[&typeid(SerializableObject::Retainer<>)] =
-        [this](std::any const& value) {
-            this->write(
-                _no_key,
-                std::any_cast<SerializableObject::Retainer<>>(value));
+    std::string& _tag(_Tag tag)
+    {
+        std::string& bytes = _frames[_depth - 1].bytes;
+        bytes.push_back(char(tag));
+        return bytes;
+    }
+
+    void _start(_Tag tag)
+    {
+        if (_depth == _frames.size())
+        {
+            _frames.emplace_back();
+        }
+        _Frame& frame = _frames[_depth++];
+        frame.object  = _next_object;
+        frame.sealed  = true;
+        frame.bytes.clear();
+        frame.keys.clear();
+        frame.bytes.push_back(char(tag));
+        _next_object = nullptr;
+    }
+
+    void _end()
+    {
+        _Frame&           frame = _frames[--_depth];
+        ContentHash const hash  = _hash_entries(frame);
+        if (frame.object && frame.sealed && !has_errored())
+        {
+            std::lock_guard<std::mutex> lock(frame.object->_mutex);
+            auto& memo = frame.object->_content_hash_memo;
+            if (!memo)
+            {
+                memo.reset(new SerializableObject::_ContentHashMemo);
+            }
+            *memo = { frame.object->generation(), hash.high, hash.low };
+        }
+        _hashed(frame.object, hash, frame.sealed);
+    }
+
+    // Pass the hash of what was just hashed on to what holds it.
+    void _hashed(
+        SerializableObject const* object,
+        ContentHash               hash,
+        bool                      sealed)
+    {
+        if (_depth == 0)
+        {
+            result = hash;
+            return;
+        }
+
+        _Frame& parent = _frames[_depth - 1];
+        _append_word(parent.bytes, hash.high);
+        _append_word(parent.bytes, hash.low);
+
+        if (object && sealed)
+        {
+            // the object holding this one, through any dictionaries and
+            // arrays in between
+            SerializableObject const* holder = nullptr;
+            for (size_t i = _depth; i > 0 && !holder; --i)
+            {
+                holder = _frames[i - 1].object;
+            }
+            sealed = object->_change_parent() == holder;
+        }
+        parent.sealed = parent.sealed && sealed;
+    }
+
+    // Hash the entries of a dictionary in the order of their keys, whatever
+    // order they were written in; the fields of an object are always
+    // written in the same order.
+    static ContentHash _hash_entries(_Frame const& frame)
+    {
+        if (frame.object)
+        {
+            return _hash(frame.bytes);
+        }
+
+        auto const key = [&frame](size_t index) {
+            size_t const start = frame.keys[index];
+            size_t       size  = 0;
+            for (int i = 0; i < 8; ++i)
+            {
+                size |= size_t(uint8_t(frame.bytes[start + i])) << (8 * i);
+            }
+            return std::pair<size_t, size_t>(start + 8, size);
+        };
+        auto const less = [&frame, &key](size_t a, size_t b) {
+            auto const ka = key(a);
+            auto const kb = key(b);
+            return frame.bytes.compare(
+                       ka.first,
+                       ka.second,
+                       frame.bytes,
+                       kb.first,
+                       kb.second)
+                   < 0;
         };
 
-    wt[&typeid(AnyDictionary)] = [this](std::any const& value) {
-        this->write(_no_key, std::any_cast<AnyDictionary const&>(value));
-    };
+        bool in_order = true;
+        for (size_t i = 1; i < frame.keys.size() && in_order; ++i)
+        {
+            in_order = !less(i, i - 1);
+        }
+        if (in_order)
+        {
+            return _hash(frame.bytes);
+        }
 
-    wt[&typeid(AnyVector)] = [this](std::any const& value) {
-        this->write(_no_key, std::any_cast<AnyVector const&>(value));
-    };
+        std::vector<size_t> order(frame.keys.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), less);
+        std::string sorted(frame.bytes, 0, frame.keys[0]);
+        for (size_t index: order)
+        {
+            size_t const end = index + 1 < frame.keys.size()
+                                   ? frame.keys[index + 1]
+                                   : frame.bytes.size();
+            sorted.append(
+                frame.bytes,
+                frame.keys[index],
+                end - frame.keys[index]);
+        }
+        return _hash(sorted);
+    }
 
-    /*
-     * Install a backup table, using the actual type name as a key.
-     * This is to deal with type aliasing across compilation units.
-     */
-    for (const auto& e: wt)
-    {
-        _write_dispatch_table_by_name[e.first->name()] = e.second;
-    }
-
-    auto& et                   = _equality_dispatch_table;
-    et[&typeid(void)]          = &_simple_any_comparison<void>;
-    et[&typeid(bool)]          = &_simple_any_comparison<bool>;
-    et[&typeid(int64_t)]       = &_simple_any_comparison<int64_t>;
-    et[&typeid(double)]        = &_simple_any_comparison<double>;
-    et[&typeid(std::string)]   = &_simple_any_comparison<std::string>;
-    et[&typeid(char const*)]   = &_simple_any_comparison<char const*>;
-    et[&typeid(RationalTime)]  = &_simple_any_comparison<RationalTime>;
-    et[&typeid(TimeRange)]     = &_simple_any_comparison<TimeRange>;
-    et[&typeid(TimeTransform)] = &_simple_any_comparison<TimeTransform>;
-    et[&typeid(SerializableObject::ReferenceId)] =
-        &_simple_any_comparison<SerializableObject::ReferenceId>;
-    et[&typeid(IMATH_NAMESPACE::V2d)] =
-        &_simple_any_comparison<IMATH_NAMESPACE::V2d>;
-    et[&typeid(IMATH_NAMESPACE::Box2d)] =
-        &_simple_any_comparison<IMATH_NAMESPACE::Box2d>;
-
-    /*
-     * These next recurse back through the Writer itself:
-     */
-    et[&typeid(AnyDictionary)] =
-        [this](std::any const& lhs, std::any const& rhs) {
-            return _any_dict_equals(lhs, rhs);
+    // Values are appended in little endian order, so that hashes are the
+    // same on every platform.
+    static void _append_word(std::string& bytes, uint64_t word)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            bytes.push_back(char(uint8_t(word >> (8 * i))));
+        }
+    }
+
+    static void _append_double(std::string& bytes, double value)
+    {
+        if (std::isnan(value))
+        {
+            value = std::numeric_limits<double>::quiet_NaN();
+        }
+        uint64_t word;
+        std::memcpy(&word, &value, sizeof(word));
+        _append_word(bytes, word);
+    }
+
+    static void _append_time(std::string& bytes, RationalTime value)
+    {
+        _append_double(bytes, value.value());
+        _append_double(bytes, value.rate());
+    }
+
+    static void _append_string(std::string& bytes, std::string const& value)
+    {
+        _append_word(bytes, value.size());
+        bytes.append(value);
+    }
+
+    // MurmurHash3 (x64, 128 bit variant), which is public domain.
+    static ContentHash _hash(std::string const& bytes)
+    {
+        uint64_t const c1 = 0x87c37b91114253d5ULL;
+        uint64_t const c2 = 0x4cf5ad432745937fULL;
+
+        auto const rotl = [](uint64_t x, int r) {
+            return (x << r) | (x >> (64 - r));
         };
-    et[&typeid(AnyVector)] = [this](std::any const& lhs, std::any const& rhs) {
-        return _any_array_equals(lhs, rhs);
-    };
+        auto const fmix = [](uint64_t k) {
+            k ^= k >> 33;
+            k *= 0xff51afd7ed558ccdULL;
+            k ^= k >> 33;
+            k *= 0xc4ceb9fe1a85ec53ULL;
+            k ^= k >> 33;
+            return k;
+        };
+        auto const word = [&bytes](size_t start, size_t count) {
+            uint64_t k = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                k |= uint64_t(uint8_t(bytes[start + i])) << (8 * i);
+            }
+            return k;
+        };
+
+        size_t const length = bytes.size();
+        size_t const blocks = length / 16;
+        uint64_t     h1     = 0;
+        uint64_t     h2     = 0;
+        for (size_t i = 0; i < blocks; ++i)
+        {
+            uint64_t k1 = word(16 * i, 8);
+            uint64_t k2 = word(16 * i + 8, 8);
+
+            k1 *= c1;
+            k1 = rotl(k1, 31);
+            k1 *= c2;
+            h1 ^= k1;
+            h1 = rotl(h1, 27);
+            h1 += h2;
+            h1 = h1 * 5 + 0x52dce729;
+
+            k2 *= c2;
+            k2 = rotl(k2, 33);
+            k2 *= c1;
+            h2 ^= k2;
+            h2 = rotl(h2, 31);
+            h2 += h1;
+            h2 = h2 * 5 + 0x38495ab5;
+        }
+
+        size_t const tail = length & 15;
+        if (tail > 8)
+        {
+            uint64_t k2 = word(16 * blocks + 8, tail - 8);
+            k2 *= c2;
+            k2 = rotl(k2, 33);
+            k2 *= c1;
+            h2 ^= k2;
+        }
+        if (tail > 0)
+        {
+            uint64_t k1 = word(16 * blocks, std::min(tail, size_t(8)));
+            k1 *= c1;
+            k1 = rotl(k1, 31);
+            k1 *= c2;
+            h1 ^= k1;
+        }
+
+        h1 ^= length;
+        h2 ^= length;
+        h1 += h2;
+        h2 += h1;
+        h1 = fmix(h1);
+        h2 = fmix(h2);
+        h1 += h2;
+        h2 += h1;
+        return { h1, h2 };
+    }
+
+    std::vector<_Frame>       _frames;
+    size_t                    _depth       = 0;
+    SerializableObject const* _next_object = nullptr;
+    bool                      _skip_next   = false;
+};
+
+template <typename T>
+bool
+_simple_any_comparison(std::any const& lhs, std::any const& rhs)
+{
+    return std::any_cast<T const&>(lhs) == std::any_cast<T const&>(rhs);
 }
 
 bool
@@ -828,8 +1566,53 @@ SerializableObject::Writer::_any_equals(
     std::any const& lhs,
     std::any const& rhs)
 {
-    auto e = _equality_dispatch_table.find(&lhs.type());
-    return (e != _equality_dispatch_table.end()) && e->second(lhs, rhs);
+    AnyKind const kind = any_kind(lhs);
+    if (kind != any_kind(rhs))
+    {
+        return false;
+    }
+
+    switch (kind)
+    {
+        case AnyKind::empty:
+            return true;
+        case AnyKind::bool_value:
+            return _simple_any_comparison<bool>(lhs, rhs);
+        case AnyKind::int64_value:
+            return _simple_any_comparison<int64_t>(lhs, rhs);
+        case AnyKind::double_value:
+            return _simple_any_comparison<double>(lhs, rhs);
+        case AnyKind::string:
+            return _simple_any_comparison<std::string>(lhs, rhs);
+        case AnyKind::c_string:
+            return !strcmp(
+                std::any_cast<char const*>(lhs),
+                std::any_cast<char const*>(rhs));
+        case AnyKind::rational_time:
+            return _simple_any_comparison<RationalTime>(lhs, rhs);
+        case AnyKind::time_range:
+            return _simple_any_comparison<TimeRange>(lhs, rhs);
+        case AnyKind::time_transform:
+            return _simple_any_comparison<TimeTransform>(lhs, rhs);
+        case AnyKind::point:
+            return _simple_any_comparison<IMATH_NAMESPACE::V2d>(lhs, rhs);
+        case AnyKind::box:
+            return _simple_any_comparison<IMATH_NAMESPACE::Box2d>(lhs, rhs);
+        case AnyKind::reference_id:
+            return _simple_any_comparison<SerializableObject::ReferenceId>(
+                lhs,
+                rhs);
+
+        /*
+         * These next recurse back through the Writer itself:
+         */
+        case AnyKind::any_dictionary:
+            return _any_dict_equals(lhs, rhs);
+        case AnyKind::any_vector:
+            return _any_array_equals(lhs, rhs);
+        default:
+            return false;
+    }
 }
 
 bool
@@ -903,6 +1686,7 @@ SerializableObject::Writer::write(
     std::optional<RationalTime> value)
 {
     _encoder_write_key(key);
+    _encoder.write_optional(sizeof(value));
     value ? _encoder.write_value(*value) : _encoder.write_null_value();
 }
 
@@ -912,6 +1696,7 @@ SerializableObject::Writer::write(
     std::optional<TimeRange> value)
 {
     _encoder_write_key(key);
+    _encoder.write_optional(sizeof(value));
     value ? _encoder.write_value(*value) : _encoder.write_null_value();
 }
 
@@ -921,6 +1706,7 @@ SerializableObject::Writer::write(
     std::optional<IMATH_NAMESPACE::Box2d> value)
 {
     _encoder_write_key(key);
+    _encoder.write_optional(sizeof(value));
     value ? _encoder.write_value(*value) : _encoder.write_null_value();
 }
 
@@ -966,6 +1752,11 @@ SerializableObject::Writer::write(
         return;
     }
 
+    if (_encoder.write_known(value))
+    {
+        return;
+    }
+
     std::string const& schema_type_name = value->_schema_name_for_reference();
     if (_next_id_for_type.find(schema_type_name) == _next_id_for_type.end())
     {
@@ -1001,6 +1792,8 @@ SerializableObject::Writer::write(
             // and the current_version is greater than the target version
             if (schema_version > target_version)
             {
+                OTIO_TRACE_SCOPE("Writer::write downgrade");
+
                 if (_child_writer == nullptr)
                 {
                     _child_cloning_encoder = new CloningEncoder(
@@ -1112,6 +1905,105 @@ SerializableObject::Writer::write(
     _encoder.end_object();
 }
 
+namespace {
+
+// Whether value holds no objects, nor anything else the Writer would not
+// copy as it is.
+bool
+holds_only_data(std::any const& value)
+{
+    switch (any_kind(value))
+    {
+        case AnyKind::retainer:
+        case AnyKind::reference_id:
+        case AnyKind::other:
+            return false;
+        case AnyKind::any_dictionary:
+            for (auto const& e: std::any_cast<AnyDictionary const&>(value))
+            {
+                if (!holds_only_data(e.second))
+                {
+                    return false;
+                }
+            }
+            return true;
+        case AnyKind::any_vector:
+            for (auto const& e: std::any_cast<AnyVector const&>(value))
+            {
+                if (!holds_only_data(e))
+                {
+                    return false;
+                }
+            }
+            return true;
+        default:
+            return true;
+    }
+}
+
+bool
+holds_only_data(AnyDictionary const& dictionary)
+{
+    for (auto const& e: dictionary)
+    {
+        if (!holds_only_data(e.second))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool
+SharedAnyDictionary::holds_only_data() const
+{
+    if (!_block)
+    {
+        return true;
+    }
+
+    // several threads may clone the same object at once, and work this out
+    // together; they all store the same answer
+    signed char only_data = _block->only_data.load(std::memory_order_relaxed);
+    if (only_data == _Block::unknown)
+    {
+        only_data = OPENTIMELINEIO_VERSION::holds_only_data(_block->dictionary);
+        _block->only_data.store(only_data, std::memory_order_relaxed);
+    }
+    return only_data;
+}
+
+void
+SerializableObject::Writer::write(
+    std::string const&         key,
+    SharedAnyDictionary const& value)
+{
+    if (!_write_shared(key, value))
+    {
+        write(key, value.get());
+        value.end_hand_out();
+    }
+}
+
+bool
+SerializableObject::Writer::_write_shared(
+    std::string const&         key,
+    SharedAnyDictionary const& value)
+{
+    // A clone must get clones of any objects in the dictionary, so only
+    // plain data is shared.
+    if (!_encoder.shares_dictionaries() || !value.is_shareable()
+        || !value.holds_only_data())
+    {
+        return false;
+    }
+    _encoder_write_key(key);
+    _encoder.write_value(value);
+    return true;
+}
+
 void
 SerializableObject::Writer::write(
     std::string const& key,
@@ -1132,60 +2024,92 @@ SerializableObject::Writer::write(
 void
 SerializableObject::Writer::write(std::string const& key, std::any const& value)
 {
-    std::type_info const& type = value.type();
-
     _encoder_write_key(key);
 
-    auto e = _write_dispatch_table.find(&type);
-    if (e == _write_dispatch_table.end())
+    switch (any_kind(value))
     {
         /*
-         * Using the address of a type_info suffers from aliasing across
-         * compilation units. If we fail on a lookup, we fallback on the
-         * by_name table, but that's slow because we have to keep making a
-         * string each time.
-         *
-         * So when we fail, we insert the address of the type_info that failed
-         * to be found, so that we'll catch it the next time.  This ensures we
-         * fail exactly once per alias per type while using this writer.
+         * These are basically atomic writes to the encoder:
          */
-        const auto& backup_e = _write_dispatch_table_by_name.find(type.name());
-        if (backup_e != _write_dispatch_table_by_name.end())
-        {
-            e = _write_dispatch_table.insert({ &type, backup_e->second }).first;
-        }
+        case AnyKind::empty:
+            _encoder.write_null_value();
+            return;
+        case AnyKind::bool_value:
+            _encoder.write_value(std::any_cast<bool>(value));
+            return;
+        case AnyKind::int64_value:
+            _encoder.write_value(std::any_cast<int64_t>(value));
+            return;
+        case AnyKind::double_value:
+            _encoder.write_value(std::any_cast<double>(value));
+            return;
+        case AnyKind::string:
+            _encoder.write_value(std::any_cast<std::string const&>(value));
+            return;
+        case AnyKind::c_string:
+            _encoder.write_value(
+                std::string(std::any_cast<char const*>(value)));
+            return;
+        case AnyKind::rational_time:
+            _encoder.write_value(std::any_cast<RationalTime const&>(value));
+            return;
+        case AnyKind::time_range:
+            _encoder.write_value(std::any_cast<TimeRange const&>(value));
+            return;
+        case AnyKind::time_transform:
+            _encoder.write_value(std::any_cast<TimeTransform const&>(value));
+            return;
+        case AnyKind::point:
+            _encoder.write_value(
+                std::any_cast<IMATH_NAMESPACE::V2d const&>(value));
+            return;
+        case AnyKind::box:
+            _encoder.write_value(
+                std::any_cast<IMATH_NAMESPACE::Box2d const&>(value));
+            return;
+
+        /*
+         * These next recurse back through the Writer itself:
+         */
+        case AnyKind::retainer:
+            this->write(
+                _no_key,
+                std::any_cast<SerializableObject::Retainer<>>(value));
+            return;
+        case AnyKind::any_dictionary:
+            this->write(_no_key, std::any_cast<AnyDictionary const&>(value));
+            return;
+        case AnyKind::any_vector:
+            this->write(_no_key, std::any_cast<AnyVector const&>(value));
+            return;
+        default:
+            break;
     }
 
-    if (e != _write_dispatch_table.end())
+    std::type_info const& type = value.type();
+    std::string           s;
+    std::string           bad_type_name =
+        (type == typeid(UnknownType))
+            ? type_name_for_error_message(
+                  std::any_cast<UnknownType>(value).type_name)
+            : type_name_for_error_message(type);
+
+    if (&key != &_no_key)
     {
-        e->second(value);
+        s = string_printf(
+            "Encountered object of unknown type '%s' under key '%s'",
+            bad_type_name.c_str(),
+            key.c_str());
     }
     else
     {
-        std::string s;
-        std::string bad_type_name =
-            (type == typeid(UnknownType))
-                ? type_name_for_error_message(
-                      std::any_cast<UnknownType>(value).type_name)
-                : type_name_for_error_message(type);
-
-        if (&key != &_no_key)
-        {
-            s = string_printf(
-                "Encountered object of unknown type '%s' under key '%s'",
-                bad_type_name.c_str(),
-                key.c_str());
-        }
-        else
-        {
-            s = string_printf(
-                "Encountered object of unknown type '%s'",
-                bad_type_name.c_str());
-        }
-
-        _encoder._error(ErrorStatus(ErrorStatus::TYPE_MISMATCH, s));
-        _encoder.write_null_value();
+        s = string_printf(
+            "Encountered object of unknown type '%s'",
+            bad_type_name.c_str());
     }
+
+    _encoder._error(ErrorStatus(ErrorStatus::TYPE_MISMATCH, s));
+    _encoder.write_null_value();
 }
 
 bool
@@ -1214,9 +2138,20 @@ SerializableObject::is_equivalent_to(SerializableObject const& other) const
 SerializableObject*
 SerializableObject::clone(ErrorStatus* error_status) const
 {
+    return _clone(error_status, nullptr);
+}
+
+SerializableObject*
+SerializableObject::_clone(
+    ErrorStatus*              error_status,
+    SerializableObject const* omit_children_of) const
+{
+    OTIO_TRACE_SCOPE("SerializableObject::clone");
+
     CloningEncoder e(
         CloningEncoder::ResultObjectPolicy::CloneBackToSerializableObject);
     SerializableObject::Writer w(e, {});
+    w._omit_children_of = omit_children_of;
 
     w.write(w._no_key, std::any(Retainer<>(this)));
     if (e.has_errored(error_status))
@@ -1240,6 +2175,43 @@ SerializableObject::clone(ErrorStatus* error_status) const
                : nullptr;
 }
 
+ContentHash
+content_hash(SerializableObject const* root, ErrorStatus* error_status)
+{
+    if (!root)
+    {
+        return ContentHash();
+    }
+
+    OTIO_TRACE_SCOPE("content_hash");
+    HashEncoder e;
+    if (!SerializableObject::Writer::write_root(
+            std::any(SerializableObject::Retainer<>(root)),
+            e,
+            nullptr,
+            error_status))
+    {
+        return ContentHash();
+    }
+    return e.result;
+}
+
+MemoryFootprint
+memory_footprint(SerializableObject const* root, ErrorStatus* error_status)
+{
+    MemoryFootprint footprint;
+    if (root)
+    {
+        FootprintEncoder e(footprint);
+        SerializableObject::Writer::write_root(
+            std::any(SerializableObject::Retainer<>(root)),
+            e,
+            nullptr,
+            error_status);
+    }
+    return footprint;
+}
+
 // to json_string
 std::string
 serialize_json_to_string_pretty(
@@ -1313,6 +2285,8 @@ serialize_json_to_string(
     ErrorStatus*              error_status,
     int                       indent)
 {
+    OTIO_TRACE_SCOPE("serialize_json_to_string");
+
     if (indent > 0)
     {
         return serialize_json_to_string_pretty(
@@ -1335,6 +2309,7 @@ serialize_json_to_file(
     ErrorStatus*              error_status,
     int                       indent)
 {
+    OTIO_TRACE_SCOPE("serialize_json_to_file");
 
 #if defined(_WINDOWS)
     const int wlen =
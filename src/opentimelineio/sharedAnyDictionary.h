@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentimelineio/anyDictionary.h"
+#include "opentimelineio/version.h"
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+/**
+ * A SharedAnyDictionary holds an AnyDictionary that its copies share until
+ * one of them is modified.  Objects keep their metadata in one, so that
+ * cloning an object (as flattening and trimming tracks do for every item)
+ * does not copy metadata that neither the original nor the clone goes on
+ * to change.
+ *
+ * get() reads the dictionary.  detach() returns it for modification,
+ * copying it first if it is shared.  mutable_get() does the same for
+ * callers that may hold on to the reference it returns, which may be
+ * written through until the holder is next copied or serialized (as
+ * cloning does): that copy gets a dictionary of its own, so that writes
+ * made through the reference do not reach it, and later copies share the
+ * dictionary again.  lend() is for callers that hold on to a mutation
+ * stamp instead (as Python does): the dictionary is kept from being
+ * shared for as long as the stamp lives.
+ *
+ * Holders count the holders sharing their dictionary themselves, rather
+ * than through a shared_ptr, so that whether a dictionary is shared can
+ * be read with the ordering that modifying it in place needs.
+ *
+ * An empty holder allocates nothing.
+ */
+class SharedAnyDictionary
+{
+public:
+    SharedAnyDictionary() noexcept = default;
+
+    SharedAnyDictionary(AnyDictionary const& dictionary)
+        : _block{ dictionary.empty() ? nullptr : new _Block(dictionary) }
+    {}
+
+    SharedAnyDictionary(AnyDictionary&& dictionary)
+        : _block{ dictionary.empty() ? nullptr
+                                     : new _Block(std::move(dictionary)) }
+    {}
+
+    SharedAnyDictionary(SharedAnyDictionary const& other)
+        : _block{ other._block_for_copy() }
+    {}
+
+    SharedAnyDictionary(SharedAnyDictionary&& other) noexcept
+        : _block{ std::exchange(other._block, nullptr) }
+    {}
+
+    ~SharedAnyDictionary() { _release(_block); }
+
+    SharedAnyDictionary& operator=(SharedAnyDictionary const& other)
+    {
+        _Block* const block = other._block_for_copy();
+        _release(_block);
+        _block = block;
+        return *this;
+    }
+
+    SharedAnyDictionary& operator=(SharedAnyDictionary&& other) noexcept
+    {
+        std::swap(_block, other._block);
+        return *this;
+    }
+
+    AnyDictionary const& get() const noexcept
+    {
+        return _block ? _block->dictionary : _empty();
+    }
+
+    AnyDictionary& detach()
+    {
+        if (!_block)
+        {
+            _block = new _Block(AnyDictionary());
+        }
+        else if (_block->shares.load(std::memory_order_acquire) != 1)
+        {
+            // Any other holder may copy or drop its share at once, but
+            // none can add a share to a block this holder alone holds.
+            _Block* const block = new _Block(_block->dictionary);
+            _release(_block);
+            _block = block;
+        }
+        _block->only_data.store(_Block::unknown, std::memory_order_relaxed);
+        return _block->dictionary;
+    }
+
+    // owner is told about writes made through the dictionary returned;
+    // see AnyDictionary::set_owner().
+    AnyDictionary& mutable_get(SerializableObject* owner)
+    {
+        AnyDictionary& dictionary = detach();
+        _block->handed_out.store(true, std::memory_order_relaxed);
+        dictionary.set_owner(owner);
+        return dictionary;
+    }
+
+    AnyDictionary::MutationStamp* lend(SerializableObject* owner)
+    {
+        AnyDictionary& dictionary = detach();
+        dictionary.set_owner(owner);
+        return dictionary.get_or_create_mutation_stamp();
+    }
+
+    // Whether copies of this holder share its dictionary; if not, the
+    // dictionary may be modified without going through this holder.
+    bool is_shareable() const noexcept
+    {
+        return !_block
+               || (!_block->handed_out.load(std::memory_order_relaxed)
+                   && !_block->dictionary.has_mutation_stamp());
+    }
+
+    // Record that the dictionary was serialized, which ends its being
+    // handed out by mutable_get().
+    void end_hand_out() const noexcept
+    {
+        if (_block)
+        {
+            _block->handed_out.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    // Whether the dictionary holds no objects, nor anything else that a
+    // copy of it would not share (see holds_only_data() in
+    // serialization.cpp). Kept until the dictionary is next detached, so
+    // only meaningful while it is shareable.
+    bool holds_only_data() const;
+
+    // Whether this holder and other share a (non-empty) dictionary.
+    bool shares_with(SharedAnyDictionary const& other) const noexcept
+    {
+        return _block && _block == other._block;
+    }
+
+    // The bytes allocated for a (non-empty) dictionary, besides those of
+    // its entries.
+    static constexpr size_t block_bytes() noexcept { return sizeof(_Block); }
+
+private:
+    struct _Block
+    {
+        explicit _Block(AnyDictionary const& d)
+            : dictionary(d)
+        {}
+
+        explicit _Block(AnyDictionary&& d)
+            : dictionary(std::move(d))
+        {}
+
+        // only_data, once worked out
+        enum : signed char
+        {
+            unknown = -1
+        };
+
+        AnyDictionary                    dictionary;
+        std::atomic<long>                shares{ 1 };
+        std::atomic<bool>                handed_out{ false };
+        mutable std::atomic<signed char> only_data{ unknown };
+    };
+
+    _Block* _block_for_copy() const
+    {
+        if (!_block)
+        {
+            return nullptr;
+        }
+        if (_block->handed_out.exchange(false, std::memory_order_relaxed)
+            || _block->dictionary.has_mutation_stamp())
+        {
+            return _block->dictionary.empty()
+                       ? nullptr
+                       : new _Block(_block->dictionary);
+        }
+
+        // writes made for one holder are no longer the owner's alone
+        if (_block->dictionary.owner())
+        {
+            _block->dictionary.set_owner(nullptr);
+        }
+        _block->shares.fetch_add(1, std::memory_order_relaxed);
+        return _block;
+    }
+
+    static void _release(_Block* block) noexcept
+    {
+        if (block && block->shares.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete block;
+        }
+    }
+
+    static AnyDictionary const& _empty() noexcept
+    {
+        static AnyDictionary const empty;
+        return empty;
+    }
+
+    _Block* _block = nullptr;
+};
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -3,6 +3,7 @@
 
 #include "opentimelineio/stack.h"
 #include "opentimelineio/clip.h"
+#include "opentimelineio/instrumentation.h"
 #include "opentimelineio/vectorIndexing.h"
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
@@ -41,6 +42,8 @@ Stack::write_to(Writer& writer) const
 TimeRange
 Stack::range_of_child_at_index(int index, ErrorStatus* error_status) const
 {
+    OTIO_TRACE_SCOPE("Stack::range_of_child_at_index");
+
     index = adjusted_vector_index(index, children());
     if (index < 0 || index >= int(children().size()))
     {
@@ -64,6 +67,8 @@ Stack::range_of_child_at_index(int index, ErrorStatus* error_status) const
 std::map<Composable*, TimeRange>
 Stack::range_of_all_children(ErrorStatus* error_status) const
 {
+    OTIO_TRACE_SCOPE("Stack::range_of_all_children");
+
     std::map<Composable*, TimeRange> result;
     auto                             kids = children();
 
@@ -84,10 +89,12 @@ Stack::children_in_range(
     TimeRange const& search_range,
     ErrorStatus* error_status) const
 {
+    OTIO_TRACE_SCOPE("Stack::children_in_range");
+
     std::vector<SerializableObject::Retainer<Composable>> children;
     for (const auto& child : this->children())
     {
-        if (const auto& item = dynamic_retainer_cast<Item>(child))
+        if (const auto& item = fast_retainer_cast<Item>(child))
         {
             const auto range = item->trimmed_range_in_parent(error_status);
             if (range.has_value() && range.value().intersects(search_range))
@@ -103,6 +110,8 @@ TimeRange
 Stack::trimmed_range_of_child_at_index(int index, ErrorStatus* error_status)
     const
 {
+    OTIO_TRACE_SCOPE("Stack::trimmed_range_of_child_at_index");
+
     auto range = range_of_child_at_index(index, error_status);
     if (is_error(error_status) || !source_range())
     {
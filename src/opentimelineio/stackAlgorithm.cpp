@@ -3,6 +3,7 @@
 
 #include "opentimelineio/stackAlgorithm.h"
 #include "opentimelineio/gap.h"
+#include "opentimelineio/threadPool.h"
 #include "opentimelineio/track.h"
 #include "opentimelineio/trackAlgorithm.h"
 #include "opentimelineio/transition.h"
@@ -63,10 +64,10 @@ _flatten_next_item(
     }
     for (auto child: track->children())
     {
-        auto item = dynamic_retainer_cast<Item>(child);
+        auto item = fast_retainer_cast<Item>(child);
         if (!item)
         {
-            if (!dynamic_retainer_cast<Transition>(child))
+            if (!fast_retainer_cast<Transition>(child))
             {
                 if (error_status)
                 {
@@ -171,48 +172,92 @@ _normalize_tracks_lengths(
     }
 }
 
-Track*
-flatten_stack(Stack* in_stack, ErrorStatus* error_status)
+// Computing the range maps is only worth spreading over the pool once the
+// tracks hold enough children to amortize the cost of scheduling.
+static const size_t _parallel_range_map_child_count = 1024;
+
+// compute range_of_all_children() for every track up front, in parallel
+// when the tracks are large enough, so that _flatten_next_item only has to
+// compute maps for the trimmed tracks it creates itself. Without a
+// thread_pool, ThreadPool::global() is only started once the work is split.
+static void
+_precompute_range_track_map(
+    std::vector<Track*> const& tracks,
+    RangeTrackMap&             range_track_map,
+    ThreadPool*                thread_pool,
+    ErrorStatus*               error_status)
 {
-    std::vector<Track*> tracks;
-    // tracks are cloned if they need to be normalized
-    // they get added to this retainer so they can be
-    // freed when the algorithm is complete
-    TrackRetainerVector tracks_retainer;
-    tracks.reserve(in_stack->children().size());
+    size_t child_count = 0;
+    for (auto track: tracks)
+    {
+        child_count += track->children().size();
+    }
 
-    for (auto c: in_stack->children())
+    std::vector<std::map<Composable*, TimeRange>> track_maps(tracks.size());
+    std::vector<ErrorStatus>                      track_errors(tracks.size());
+    auto compute_track_map = [&](size_t i) {
+        track_maps[i] = tracks[i]->range_of_all_children(&track_errors[i]);
+    };
+
+    if (tracks.size() > 1 && child_count >= _parallel_range_map_child_count)
+    {
+        parallel_for(
+            thread_pool ? *thread_pool : ThreadPool::global(),
+            tracks.size(),
+            compute_track_map);
+    }
+    else
     {
-        if (auto track = dynamic_retainer_cast<Track>(c))
+        for (size_t i = 0; i < tracks.size(); ++i)
         {
-            if (track->enabled())
-            {
-                tracks.push_back(track);
-            }
+            compute_track_map(i);
         }
-        else
+    }
+
+    for (size_t i = 0; i < tracks.size(); ++i)
+    {
+        if (is_error(track_errors[i]))
         {
             if (error_status)
             {
-                *error_status = ErrorStatus(
-                    ErrorStatus::TYPE_MISMATCH,
-                    "expected item of type Track*",
-                    c);
+                *error_status = track_errors[i];
             }
-            return nullptr;
+            return;
         }
+        range_track_map.emplace(tracks[i], std::move(track_maps[i]));
     }
+}
 
+static Track*
+_flatten_tracks(
+    std::vector<Track*>& tracks,
+    ThreadPool*          thread_pool,
+    ErrorStatus*         error_status)
+{
+    // tracks are cloned if they need to be normalized
+    // they get added to this retainer so they can be
+    // freed when the algorithm is complete
+    TrackRetainerVector tracks_retainer;
     _normalize_tracks_lengths(tracks, tracks_retainer, error_status);
     if (is_error(error_status))
     {
         return nullptr;
     }
 
+    RangeTrackMap range_track_map;
+    _precompute_range_track_map(
+        tracks,
+        range_track_map,
+        thread_pool,
+        error_status);
+    if (is_error(error_status))
+    {
+        return nullptr;
+    }
+
     Track* flat_track = new Track;
     flat_track->set_name("Flattened");
 
-    RangeTrackMap range_track_map;
     _flatten_next_item(
         range_track_map,
         flat_track,
@@ -223,37 +268,102 @@ flatten_stack(Stack* in_stack, ErrorStatus* error_status)
     return flat_track;
 }
 
+static Track*
+_flatten_stack(
+    Stack*       in_stack,
+    ThreadPool*  thread_pool,
+    ErrorStatus* error_status)
+{
+    std::vector<Track*> tracks;
+    tracks.reserve(in_stack->children().size());
+
+    for (auto c: in_stack->children())
+    {
+        if (auto track = fast_retainer_cast<Track>(c))
+        {
+            if (track->enabled())
+            {
+                tracks.push_back(track);
+            }
+        }
+        else
+        {
+            if (error_status)
+            {
+                *error_status = ErrorStatus(
+                    ErrorStatus::TYPE_MISMATCH,
+                    "expected item of type Track*",
+                    c);
+            }
+            return nullptr;
+        }
+    }
+
+    return _flatten_tracks(tracks, thread_pool, error_status);
+}
+
+Track*
+flatten_stack(Stack* in_stack, ErrorStatus* error_status)
+{
+    return _flatten_stack(in_stack, nullptr, error_status);
+}
+
 Track*
 flatten_stack(std::vector<Track*> const& tracks, ErrorStatus* error_status)
 {
-    std::vector<Track*> flat_tracks;
-    // tracks are cloned if they need to be normalized
-    // they get added to this retainer so they can be
-    // freed when the algorithm is complete
-    TrackRetainerVector tracks_retainer;
-    flat_tracks.reserve(tracks.size());
-    for (auto track: tracks)
+    std::vector<Track*> flat_tracks(tracks.begin(), tracks.end());
+    return _flatten_tracks(flat_tracks, nullptr, error_status);
+}
+
+std::vector<Track*>
+flatten_stacks(
+    std::vector<Stack*> const& in_stacks,
+    ErrorStatus*               error_status,
+    ThreadPool*                thread_pool)
+{
+    std::vector<Track*>      flat_tracks(in_stacks.size(), nullptr);
+    std::vector<ErrorStatus> stack_errors(in_stacks.size());
+
+    auto flatten = [&](size_t i) {
+        Track* flat_track =
+            _flatten_stack(in_stacks[i], thread_pool, &stack_errors[i]);
+        if (is_error(stack_errors[i]))
+        {
+            if (flat_track)
+            {
+                flat_track->possibly_delete();
+            }
+            flat_track = nullptr;
+        }
+        flat_tracks[i] = flat_track;
+    };
+
+    // a single stack is flattened on this thread, leaving any splitting to
+    // _precompute_range_track_map
+    if (in_stacks.size() > 1)
     {
-        flat_tracks.push_back(track);
+        parallel_for(
+            thread_pool ? *thread_pool : ThreadPool::global(),
+            in_stacks.size(),
+            flatten);
     }
-
-    _normalize_tracks_lengths(flat_tracks, tracks_retainer, error_status);
-    if (is_error(error_status))
+    else if (!in_stacks.empty())
     {
-        return nullptr;
+        flatten(0);
     }
 
-    Track* flat_track = new Track;
-    flat_track->set_name("Flattened");
-
-    RangeTrackMap range_track_map;
-    _flatten_next_item(
-        range_track_map,
-        flat_track,
-        flat_tracks,
-        -1,
-        std::nullopt,
-        error_status);
-    return flat_track;
+    if (error_status)
+    {
+        for (auto const& stack_error: stack_errors)
+        {
+            if (is_error(stack_error))
+            {
+                *error_status = stack_error;
+                break;
+            }
+        }
+    }
+    return flat_tracks;
 }
+
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -9,9 +9,22 @@
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
 
+class ThreadPool;
+
 Track* flatten_stack(Stack* in_stack, ErrorStatus* error_status = nullptr);
 Track* flatten_stack(
     std::vector<Track*> const& tracks,
     ErrorStatus*               error_status = nullptr);
 
+/// Flatten each stack in in_stacks, running the stacks concurrently on
+/// thread_pool (or ThreadPool::global() if none is given).
+///
+/// The result is parallel to in_stacks. If a stack cannot be flattened its
+/// entry is nullptr and error_status receives the error of the first such
+/// stack. The stacks must not be modified while this runs.
+std::vector<Track*> flatten_stacks(
+    std::vector<Stack*> const& in_stacks,
+    ErrorStatus*               error_status = nullptr,
+    ThreadPool*                thread_pool  = nullptr);
+
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "opentimelineio/threadPool.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+namespace {
+
+// Identifies the pool and queue owned by the current thread, if the
+// current thread is a pool worker.
+struct WorkerIdentity
+{
+    ThreadPool const* pool        = nullptr;
+    size_t            queue_index = 0;
+};
+
+thread_local WorkerIdentity current_worker;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t thread_count)
+    : _pending_count(0)
+    , _next_queue(0)
+    , _stopping(false)
+{
+    if (thread_count == 0)
+    {
+        thread_count =
+            std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+    }
+
+    _queues.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+        _queues.emplace_back(new _Queue);
+    }
+
+    _threads.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+        _threads.emplace_back(&ThreadPool::_worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleep_mutex);
+        _stopping = true;
+    }
+    _wake_condition.notify_all();
+
+    for (auto& thread: _threads)
+    {
+        thread.join();
+    }
+}
+
+ThreadPool&
+ThreadPool::global()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void
+ThreadPool::submit(std::function<void()> task)
+{
+    // count the task before it becomes visible so that a worker never
+    // decrements the count below zero.
+    ++_pending_count;
+
+    if (current_worker.pool == this)
+    {
+        _Queue& queue = *_queues[current_worker.queue_index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_front(std::move(task));
+    }
+    else
+    {
+        _Queue& queue = *_queues[_next_queue++ % _queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_sleep_mutex);
+    }
+    _wake_condition.notify_one();
+}
+
+bool
+ThreadPool::run_pending_task()
+{
+    std::function<void()> task;
+    if (current_worker.pool == this)
+    {
+        size_t index = current_worker.queue_index;
+        if (!_pop_task(index, task) && !_steal_task(index + 1, task))
+        {
+            return false;
+        }
+    }
+    else if (!_steal_task(_next_queue.load(), task))
+    {
+        return false;
+    }
+
+    task();
+    return true;
+}
+
+bool
+ThreadPool::_pop_task(size_t queue_index, std::function<void()>& task)
+{
+    _Queue&                     queue = *_queues[queue_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+    {
+        return false;
+    }
+
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    --_pending_count;
+    return true;
+}
+
+bool
+ThreadPool::_steal_task(size_t thief_index, std::function<void()>& task)
+{
+    size_t const queue_count = _queues.size();
+    for (size_t i = 0; i < queue_count; ++i)
+    {
+        _Queue& queue = *_queues[(thief_index + i) % queue_count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            --_pending_count;
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+ThreadPool::_worker_loop(size_t queue_index)
+{
+    current_worker.pool        = this;
+    current_worker.queue_index = queue_index;
+
+    std::function<void()> task;
+    while (true)
+    {
+        if (_pop_task(queue_index, task)
+            || _steal_task(queue_index + 1, task))
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleep_mutex);
+        if (_pending_count.load() > 0)
+        {
+            continue;
+        }
+        if (_stopping)
+        {
+            return;
+        }
+        _wake_condition.wait(lock, [this]() {
+            return _stopping || _pending_count.load() > 0;
+        });
+    }
+}
+
+void
+TaskGroup::run(std::function<void()> task)
+{
+    ++_outstanding_count;
+    _pool.submit([this, task = std::move(task)]() {
+        task();
+
+        // the decrement happens under the lock so that wait() cannot
+        // return, and the group be destroyed, while we still touch it.
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (--_outstanding_count == 0)
+        {
+            _done_condition.notify_all();
+        }
+    });
+}
+
+void
+TaskGroup::wait()
+{
+    while (_outstanding_count.load() > 0)
+    {
+        if (!_pool.run_pending_task())
+        {
+            // our remaining tasks are running elsewhere; sleep briefly, but
+            // wake up now and then in case new work shows up that we can
+            // help with.
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done_condition.wait_for(
+                lock,
+                std::chrono::milliseconds(1),
+                [this]() { return _outstanding_count.load() == 0; });
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentimelineio/version.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+/// A work-stealing thread pool used by the batch algorithms.
+///
+/// Each worker owns a task queue. Tasks submitted from a worker go to the
+/// front of that worker's own queue and are run most-recent-first, which
+/// keeps nested work local; idle workers steal from the back of the other
+/// queues. Tasks submitted from outside the pool are spread round-robin.
+///
+/// Tasks must not throw.
+class ThreadPool
+{
+public:
+    /// Create a pool with the given number of worker threads. A count of
+    /// zero uses std::thread::hardware_concurrency().
+    explicit ThreadPool(size_t thread_count = 0);
+    ~ThreadPool();
+
+    size_t thread_count() const noexcept { return _threads.size(); }
+
+    void submit(std::function<void()> task);
+
+    /// Run a single pending task on the calling thread, if one is
+    /// available. Returns false if there was nothing to run.
+    bool run_pending_task();
+
+    /// The shared pool used when an algorithm is not given one explicitly.
+    static ThreadPool& global();
+
+private:
+    ThreadPool(ThreadPool const&)            = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    struct _Queue
+    {
+        std::mutex                        mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    bool _pop_task(size_t queue_index, std::function<void()>& task);
+    bool _steal_task(size_t thief_index, std::function<void()>& task);
+    void _worker_loop(size_t queue_index);
+
+    std::vector<std::unique_ptr<_Queue>> _queues;
+    std::vector<std::thread>             _threads;
+
+    std::mutex              _sleep_mutex;
+    std::condition_variable _wake_condition;
+    std::atomic<int64_t>    _pending_count;
+    std::atomic<size_t>     _next_queue;
+    bool                    _stopping;
+};
+
+/// Tracks a set of tasks submitted to a ThreadPool so that they can be
+/// waited on together. While waiting, the calling thread runs pending
+/// tasks itself, so groups may be nested inside tasks without starving
+/// the pool.
+class TaskGroup
+{
+public:
+    explicit TaskGroup(ThreadPool& pool)
+        : _pool(pool)
+        , _outstanding_count(0)
+    {}
+
+    ~TaskGroup() { wait(); }
+
+    void run(std::function<void()> task);
+    void wait();
+
+private:
+    TaskGroup(TaskGroup const&)            = delete;
+    TaskGroup& operator=(TaskGroup const&) = delete;
+
+    ThreadPool&             _pool;
+    std::atomic<size_t>     _outstanding_count;
+    std::mutex              _mutex;
+    std::condition_variable _done_condition;
+};
+
+/// Call function(i) for every i in [0, count), spread across the pool.
+/// Returns once every call has completed.
+template <typename FUNCTION>
+void
+parallel_for(ThreadPool& pool, size_t count, FUNCTION const& function)
+{
+    if (count < 2 || pool.thread_count() == 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            function(i);
+        }
+        return;
+    }
+
+    TaskGroup group(pool);
+    for (size_t i = 0; i < count; ++i)
+    {
+        group.run([&function, i]() { function(i); });
+    }
+    group.wait();
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
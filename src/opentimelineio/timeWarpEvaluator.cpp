@@ -0,0 +1,262 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "opentimelineio/timeWarpEvaluator.h"
+#include "opentimelineio/linearTimeWarp.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+namespace {
+
+// The product of the time scalars of the time effects on item. Linear time
+// warps about the same point compose by multiplying their scalars, so the
+// order of the effects does not matter.
+bool
+item_time_scalar(Item const* item, double& scalar, ErrorStatus* error_status)
+{
+    scalar = 1;
+    for (auto const& effect: item->effects())
+    {
+        if (auto time_warp = dynamic_cast<LinearTimeWarp*>(effect.value))
+        {
+            scalar *= time_warp->time_scalar();
+        }
+        else if (fast_cast<TimeEffect>(effect.value))
+        {
+            if (error_status)
+            {
+                *error_status = ErrorStatus(
+                    ErrorStatus::NOT_IMPLEMENTED,
+                    "cannot evaluate time effect",
+                    effect.value);
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TimeWarpEvaluator::TimeWarpEvaluator(
+    Composition const* root,
+    ErrorStatus*       error_status)
+{
+    if (!root)
+    {
+        if (error_status)
+        {
+            *error_status = ErrorStatus(
+                ErrorStatus::INTERNAL_ERROR,
+                "cannot evaluate a null composition");
+        }
+        return;
+    }
+
+    double const infinity = std::numeric_limits<double>::infinity();
+    if (!_add_children(
+            root,
+            _Affine{ 0, 1 },
+            -infinity,
+            infinity,
+            error_status))
+    {
+        _mappings.clear();
+        _mapping_indices.clear();
+    }
+}
+
+TimeWarpEvaluator::TimeWarpEvaluator(
+    Timeline const* timeline,
+    ErrorStatus*    error_status)
+    : TimeWarpEvaluator(timeline ? timeline->tracks() : nullptr, error_status)
+{}
+
+bool
+TimeWarpEvaluator::_add_children(
+    Composition const* composition,
+    _Affine            to_composition,
+    double             window_start,
+    double             window_end,
+    ErrorStatus*       error_status)
+{
+    auto const& children = composition->children();
+    if (children.empty())
+    {
+        return true;
+    }
+
+    ErrorStatus                      ranges_error;
+    std::map<Composable*, TimeRange> ranges =
+        composition->range_of_all_children(&ranges_error);
+    bool const have_ranges = !is_error(ranges_error);
+    if (!have_ranges && ranges_error.outcome != ErrorStatus::NOT_IMPLEMENTED)
+    {
+        if (error_status)
+        {
+            *error_status = ranges_error;
+        }
+        return false;
+    }
+
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        auto item = fast_cast<Item>(children[i].value);
+        if (!item)
+        {
+            // transitions don't map time
+            continue;
+        }
+
+        TimeRange range_in_parent =
+            have_ranges
+                ? ranges[children[i]]
+                : composition->range_of_child_at_index(int(i), error_status);
+        TimeRange trimmed_range = item->trimmed_range(error_status);
+        double    scalar        = 1;
+        if (is_error(error_status)
+            || !item_time_scalar(item, scalar, error_status))
+        {
+            return false;
+        }
+
+        // the root times that land inside the child's range in its parent,
+        // narrowed by the window of the parent itself.
+        double const range_start = range_in_parent.start_time().to_seconds();
+        double const range_end =
+            range_in_parent.end_time_exclusive().to_seconds();
+        double child_start = window_start;
+        double child_end   = window_end;
+        if (to_composition.scale > 0)
+        {
+            child_start = std::max(
+                child_start,
+                (range_start - to_composition.offset) / to_composition.scale);
+            child_end = std::min(
+                child_end,
+                (range_end - to_composition.offset) / to_composition.scale);
+        }
+        else if (to_composition.scale < 0)
+        {
+            child_start = std::max(
+                child_start,
+                (range_end - to_composition.offset) / to_composition.scale);
+            child_end = std::min(
+                child_end,
+                (range_start - to_composition.offset) / to_composition.scale);
+        }
+        else if (
+            to_composition.offset < range_start
+            || to_composition.offset >= range_end)
+        {
+            child_end = child_start;
+        }
+        child_end = std::max(child_start, child_end);
+
+        // parent time t maps to trimmed_start + (t - range_start) * scalar
+        // in the child.
+        _Affine const to_child{
+            trimmed_range.start_time().to_seconds()
+                + (to_composition.offset - range_start) * scalar,
+            to_composition.scale * scalar
+        };
+
+        if (auto clip = fast_cast<Clip>(item))
+        {
+            double const rate = trimmed_range.duration().rate();
+            _mapping_indices[clip] = _mappings.size();
+            _mappings.push_back(ClipMapping{
+                clip,
+                TimeRange(
+                    RationalTime::from_seconds(child_start, rate),
+                    RationalTime::from_seconds(child_end - child_start, rate)),
+                TimeTransform(
+                    RationalTime::from_seconds(to_child.offset, rate),
+                    to_child.scale,
+                    rate) });
+        }
+        else if (
+            auto child_composition = fast_cast<Composition>(item))
+        {
+            if (!_add_children(
+                    child_composition,
+                    to_child,
+                    child_start,
+                    child_end,
+                    error_status))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+TimeWarpEvaluator::ClipMapping const*
+TimeWarpEvaluator::mapping(Clip const* clip) const
+{
+    auto e = _mapping_indices.find(clip);
+    return e != _mapping_indices.end() ? &_mappings[e->second] : nullptr;
+}
+
+std::optional<RationalTime>
+TimeWarpEvaluator::source_time(Clip const* clip, RationalTime root_time) const
+{
+    auto clip_mapping = mapping(clip);
+    if (!clip_mapping || !clip_mapping->range_in_root.contains(root_time))
+    {
+        return std::nullopt;
+    }
+    return clip_mapping->transform.applied_to(root_time);
+}
+
+size_t
+TimeWarpEvaluator::source_frames(
+    Clip const*   clip,
+    double const* root_frames,
+    size_t        count,
+    double        root_rate,
+    double*       frames,
+    uint8_t*      valid) const
+{
+    auto clip_mapping = mapping(clip);
+    if (!clip_mapping)
+    {
+        if (valid)
+        {
+            std::fill(valid, valid + count, uint8_t(0));
+        }
+        std::fill(frames, frames + count, 0.0);
+        return 0;
+    }
+
+    // work in frames throughout: with rates folded into the transform,
+    // each frame is a multiply-add and a range check.
+    TimeRange const&     range       = clip_mapping->range_in_root;
+    TimeTransform const& xform       = clip_mapping->transform;
+    double const         source_rate = xform.rate();
+    double const start  = range.start_time().to_seconds() * root_rate;
+    double const end    = range.end_time_exclusive().to_seconds() * root_rate;
+    double const scale  = xform.scale() * source_rate / root_rate;
+    double const offset = xform.offset().to_seconds() * source_rate;
+
+    size_t valid_count = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        double const frame = root_frames[i];
+        frames[i]          = offset + frame * scale;
+        bool const visible = frame >= start && frame < end;
+        valid_count += visible;
+        if (valid)
+        {
+            valid[i] = visible;
+        }
+    }
+    return valid_count;
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentime/timeTransform.h"
+#include "opentimelineio/clip.h"
+#include "opentimelineio/composition.h"
+#include "opentimelineio/timeline.h"
+#include "opentimelineio/version.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+/// Maps times in a composition to media times of the clips beneath it.
+///
+/// On construction, the chain of parent offsets, trims and time effects
+/// between the root and each clip is folded into a single TimeTransform
+/// per clip, together with the range of root times in which that clip is
+/// visible through its ancestors. Looking up and evaluating a clip's
+/// transform afterwards does not touch the composition at all.
+///
+/// LinearTimeWarp (and so FreezeFrame) effects on the clip and on every
+/// composition above it are honored. A time warp is applied about the
+/// start of its item's trimmed range, so that a time_scalar of 2 plays the
+/// item's media twice as fast starting from its first frame, and a
+/// FreezeFrame holds that first frame. Other kinds of TimeEffect cannot be
+/// evaluated and cause construction to fail with NOT_IMPLEMENTED.
+///
+/// Times in the root are in the root's own coordinates, i.e. the times
+/// given to Item::transformed_time(); the root's own trim and effects are
+/// not applied.
+///
+/// The evaluator holds plain pointers to the clips it describes, and must
+/// be rebuilt if the composition is modified.
+class TimeWarpEvaluator
+{
+public:
+    struct ClipMapping
+    {
+        Clip const* clip;
+
+        /// The root times in which the clip is visible through all of its
+        /// ancestors; empty if the clip is trimmed away.
+        TimeRange range_in_root;
+
+        /// Maps a root time to the clip's media time, at the rate of the
+        /// clip's trimmed range.
+        TimeTransform transform;
+    };
+
+    TimeWarpEvaluator(
+        Composition const* root,
+        ErrorStatus*       error_status = nullptr);
+
+    /// Build an evaluator over the tracks of timeline.
+    TimeWarpEvaluator(
+        Timeline const* timeline,
+        ErrorStatus*    error_status = nullptr);
+
+    /// The mappings of every clip, in the same order as
+    /// Composition::find_clips().
+    std::vector<ClipMapping> const& mappings() const noexcept
+    {
+        return _mappings;
+    }
+
+    /// The mapping of clip, or null if clip is not beneath the root.
+    ClipMapping const* mapping(Clip const* clip) const;
+
+    /// Map root_time to the media time of clip. Returns nothing if the clip
+    /// is not visible at root_time.
+    std::optional<RationalTime>
+    source_time(Clip const* clip, RationalTime root_time) const;
+
+    /// Map an array of count root frame numbers at root_rate to media
+    /// frame numbers of clip, at the rate of the clip's trimmed range.
+    ///
+    /// Media frame numbers are not rounded, since time warps usually land
+    /// between frames. If valid is given, valid[i] is set to 1 when clip
+    /// is visible at root_frames[i] and to 0 otherwise; frames[i] is
+    /// computed either way. Returns the number of valid frames.
+    size_t source_frames(
+        Clip const*   clip,
+        double const* root_frames,
+        size_t        count,
+        double        root_rate,
+        double*       frames,
+        uint8_t*      valid = nullptr) const;
+
+private:
+    struct _Affine
+    {
+        double offset;
+        double scale;
+    };
+
+    bool _add_children(
+        Composition const* composition,
+        _Affine            to_composition,
+        double             window_start,
+        double             window_end,
+        ErrorStatus*       error_status);
+
+    std::vector<ClipMapping>                _mappings;
+    std::unordered_map<Clip const*, size_t> _mapping_indices;
+};
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
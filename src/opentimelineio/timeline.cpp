@@ -13,23 +13,43 @@ Timeline::Timeline(
     : SerializableObjectWithMetadata(name, metadata)
     , _global_start_time(global_start_time)
     , _tracks(new Stack("tracks"))
-{}
+{
+    _set_holder(_tracks, this);
+}
 
 Timeline::~Timeline()
-{}
+{
+    _release_held(_tracks, this);
+}
 
 void
 Timeline::set_tracks(Stack* stack)
 {
+    _release_held(_tracks, this);
     _tracks = stack ? stack : new Stack("tracks");
+    _set_holder(_tracks, this);
+    _changed();
+}
+
+Timeline*
+Timeline::clone_without_children(ErrorStatus* error_status) const
+{
+    return dynamic_cast<Timeline*>(_clone(error_status, _tracks.value));
 }
 
 bool
 Timeline::read_from(Reader& reader)
 {
-    return reader.read("tracks", &_tracks)
-           && reader.read_if_present("global_start_time", &_global_start_time)
-           && Parent::read_from(reader);
+    _release_held(_tracks, this);
+    bool result =
+        reader.read("tracks", &_tracks)
+        && reader.read_if_present("global_start_time", &_global_start_time)
+        && Parent::read_from(reader);
+    if (_tracks)
+    {
+        _set_holder(_tracks, this);
+    }
+    return result;
 }
 
 void
@@ -40,13 +60,23 @@ Timeline::write_to(Writer& writer) const
     writer.write("tracks", _tracks);
 }
 
+void
+Timeline::_settle_held()
+{
+    Parent::_settle_held();
+    if (_tracks)
+    {
+        _tracks.value->generation();
+    }
+}
+
 std::vector<Track*>
 Timeline::video_tracks() const
 {
     std::vector<Track*> result;
     for (auto c: _tracks->children())
     {
-        if (auto t = dynamic_retainer_cast<Track>(c))
+        if (auto t = fast_retainer_cast<Track>(c))
         {
             if (t->kind() == Track::Kind::video)
             {
@@ -63,7 +93,7 @@ Timeline::audio_tracks() const
     std::vector<Track*> result;
     for (auto c: _tracks->children())
     {
-        if (auto t = dynamic_retainer_cast<Track>(c))
+        if (auto t = fast_retainer_cast<Track>(c))
         {
             if (t->kind() == Track::Kind::audio)
             {
@@ -37,6 +37,14 @@ public:
 
     void set_tracks(Stack* stack);
 
+    // Makes a clone of this timeline whose tracks stack has no children.
+    //
+    // Everything else, including the metadata of the stack itself, is
+    // cloned as clone() would. If the operation fails, nullptr is returned
+    // and error_status is set appropriately.
+    Timeline*
+    clone_without_children(ErrorStatus* error_status = nullptr) const;
+
     std::optional<RationalTime> global_start_time() const noexcept
     {
         return _global_start_time;
@@ -46,6 +54,7 @@ public:
     set_global_start_time(std::optional<RationalTime> const& global_start_time)
     {
         _global_start_time = global_start_time;
+        _changed();
     }
 
     RationalTime duration(ErrorStatus* error_status = nullptr) const
@@ -96,6 +105,8 @@ protected:
     bool read_from(Reader&) override;
     void write_to(Writer&) const override;
 
+    void _settle_held() override;
+
 private:
     std::optional<RationalTime> _global_start_time;
     Retainer<Stack>             _tracks;
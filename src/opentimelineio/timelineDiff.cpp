@@ -0,0 +1,477 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "opentimelineio/timelineDiff.h"
+#include "opentimelineio/clip.h"
+#include "opentimelineio/externalReference.h"
+#include "opentimelineio/imageSequenceReference.h"
+#include "opentimelineio/linearTimeWarp.h"
+#include "opentimelineio/stack.h"
+#include "opentimelineio/threadPool.h"
+#include "opentimelineio/timeline.h"
+#include "opentimelineio/transition.h"
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+namespace {
+
+using ChildVector = std::vector<SerializableObject::Retainer<Composable>>;
+
+// What aligns a child with its counterpart in the other version; the hash
+// makes comparing two that differ cheap.
+struct Identity
+{
+    size_t      hash;
+    std::string key;
+
+    friend bool operator==(Identity const& lhs, Identity const& rhs)
+    {
+        return lhs.hash == rhs.hash && lhs.key == rhs.key;
+    }
+};
+
+std::string
+media_url(Clip const* clip)
+{
+    MediaReference const* reference = clip->media_reference();
+    if (auto external = dynamic_cast<ExternalReference const*>(reference))
+    {
+        return external->target_url();
+    }
+    if (auto sequence = dynamic_cast<ImageSequenceReference const*>(reference))
+    {
+        return sequence->target_url_base() + sequence->name_prefix()
+               + sequence->name_suffix();
+    }
+    return reference ? reference->schema_name() : std::string();
+}
+
+Identity
+identity(Composable const* child)
+{
+    std::string key = child->schema_name();
+    key += '\0';
+    key += child->name();
+    if (auto clip = fast_cast<Clip>(child))
+    {
+        key += '\0';
+        key += media_url(clip);
+    }
+    size_t const hash = std::hash<std::string>()(key);
+    return { hash, std::move(key) };
+}
+
+bool
+is_trimmed(Composable const* old_child, Composable const* new_child)
+{
+    if (auto old_item = fast_cast<Item>(old_child))
+    {
+        auto new_item = fast_cast<Item>(new_child);
+        return new_item && old_item->source_range() != new_item->source_range();
+    }
+    if (auto old_transition = fast_cast<Transition>(old_child))
+    {
+        auto new_transition = fast_cast<Transition>(new_child);
+        return new_transition
+               && (old_transition->in_offset() != new_transition->in_offset()
+                   || old_transition->out_offset()
+                          != new_transition->out_offset());
+    }
+    return false;
+}
+
+// The time effects of child, as the kind and rate of each.
+std::vector<std::pair<std::string, double>>
+time_effects(Composable const* child)
+{
+    std::vector<std::pair<std::string, double>> result;
+    if (auto item = fast_cast<Item>(child))
+    {
+        for (auto const& effect: item->effects())
+        {
+            if (!fast_cast<TimeEffect>(effect.value))
+            {
+                continue;
+            }
+            auto warp = dynamic_cast<LinearTimeWarp const*>(effect.value);
+            result.emplace_back(
+                effect->schema_name() + "." + effect->effect_name(),
+                warp ? warp->time_scalar() : 1.0);
+        }
+    }
+    return result;
+}
+
+void
+compare(ChildDifference& difference)
+{
+    difference.trimmed =
+        is_trimmed(difference.old_child, difference.new_child);
+    difference.retimed = time_effects(difference.old_child)
+                         != time_effects(difference.new_child);
+}
+
+// Finds a longest common subsequence of two sequences of identities with
+// the linear space variant of Myers' O(ND) algorithm: common prefixes and
+// suffixes are matched directly, and what lies between is split where a
+// forward and a backward search for the shortest edit script meet.
+class Aligner
+{
+public:
+    Aligner(std::vector<Identity> const& a, std::vector<Identity> const& b)
+        : _a(a)
+        , _b(b)
+    {}
+
+    // The indices of the matched elements, in order.
+    std::vector<std::pair<size_t, size_t>> align()
+    {
+        _align(0, _a.size(), 0, _b.size());
+        return std::move(_matches);
+    }
+
+private:
+    void _align(size_t a0, size_t a1, size_t b0, size_t b1)
+    {
+        while (a0 < a1 && b0 < b1 && _a[a0] == _b[b0])
+        {
+            _matches.emplace_back(a0++, b0++);
+        }
+        size_t suffix = 0;
+        while (a0 < a1 - suffix && b0 < b1 - suffix
+               && _a[a1 - 1 - suffix] == _b[b1 - 1 - suffix])
+        {
+            ++suffix;
+        }
+        a1 -= suffix;
+        b1 -= suffix;
+
+        std::pair<size_t, size_t> split;
+        if (a0 < a1 && b0 < b1 && _bisect(a0, a1, b0, b1, split))
+        {
+            _align(a0, a0 + split.first, b0, b0 + split.second);
+            _align(a0 + split.first, a1, b0 + split.second, b1);
+        }
+
+        for (size_t i = 0; i < suffix; ++i)
+        {
+            _matches.emplace_back(a1 + i, b1 + i);
+        }
+    }
+
+    // Find where the middle of a shortest edit script of the two ranges
+    // lies, relative to their starts; false if they have nothing in common.
+    bool _bisect(
+        size_t                     a0,
+        size_t                     a1,
+        size_t                     b0,
+        size_t                     b1,
+        std::pair<size_t, size_t>& split)
+    {
+        int64_t const n        = int64_t(a1 - a0);
+        int64_t const m        = int64_t(b1 - b0);
+        int64_t const max_d    = (n + m + 1) / 2;
+        int64_t const offset   = max_d;
+        int64_t const length   = 2 * max_d + 2;
+        int64_t const delta    = n - m;
+        bool const    front    = (delta % 2) != 0;
+        int64_t       k1_start = 0;
+        int64_t       k1_end   = 0;
+        int64_t       k2_start = 0;
+        int64_t       k2_end   = 0;
+
+        std::vector<int64_t> v1(length, -1);
+        std::vector<int64_t> v2(length, -1);
+        v1[offset + 1] = 0;
+        v2[offset + 1] = 0;
+
+        auto same = [&](int64_t x, int64_t y) {
+            return _a[a0 + x] == _b[b0 + y];
+        };
+        auto same_from_end = [&](int64_t x, int64_t y) {
+            return _a[a1 - 1 - x] == _b[b1 - 1 - y];
+        };
+
+        for (int64_t d = 0; d < max_d; ++d)
+        {
+            // forward
+            for (int64_t k1 = -d + k1_start; k1 <= d - k1_end; k1 += 2)
+            {
+                int64_t const k1_offset = offset + k1;
+                int64_t       x1 =
+                    (k1 == -d
+                     || (k1 != d && v1[k1_offset - 1] < v1[k1_offset + 1]))
+                              ? v1[k1_offset + 1]
+                              : v1[k1_offset - 1] + 1;
+                int64_t y1 = x1 - k1;
+                while (x1 < n && y1 < m && same(x1, y1))
+                {
+                    ++x1;
+                    ++y1;
+                }
+                v1[k1_offset] = x1;
+                if (x1 > n)
+                {
+                    k1_end += 2;
+                }
+                else if (y1 > m)
+                {
+                    k1_start += 2;
+                }
+                else if (front)
+                {
+                    int64_t const k2_offset = offset + delta - k1;
+                    if (k2_offset >= 0 && k2_offset < length
+                        && v2[k2_offset] != -1 && x1 >= n - v2[k2_offset])
+                    {
+                        split = { size_t(x1), size_t(y1) };
+                        return true;
+                    }
+                }
+            }
+
+            // backward
+            for (int64_t k2 = -d + k2_start; k2 <= d - k2_end; k2 += 2)
+            {
+                int64_t const k2_offset = offset + k2;
+                int64_t       x2 =
+                    (k2 == -d
+                     || (k2 != d && v2[k2_offset - 1] < v2[k2_offset + 1]))
+                              ? v2[k2_offset + 1]
+                              : v2[k2_offset - 1] + 1;
+                int64_t y2 = x2 - k2;
+                while (x2 < n && y2 < m && same_from_end(x2, y2))
+                {
+                    ++x2;
+                    ++y2;
+                }
+                v2[k2_offset] = x2;
+                if (x2 > n)
+                {
+                    k2_end += 2;
+                }
+                else if (y2 > m)
+                {
+                    k2_start += 2;
+                }
+                else if (!front)
+                {
+                    int64_t const k1_offset = offset + delta - k2;
+                    if (k1_offset >= 0 && k1_offset < length
+                        && v1[k1_offset] != -1)
+                    {
+                        int64_t const x1 = v1[k1_offset];
+                        int64_t const y1 = offset + x1 - k1_offset;
+                        if (x1 >= n - x2)
+                        {
+                            split = { size_t(x1), size_t(y1) };
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    std::vector<Identity> const&           _a;
+    std::vector<Identity> const&           _b;
+    std::vector<std::pair<size_t, size_t>> _matches;
+};
+
+ChildVector const&
+children_of(Composition const* track)
+{
+    static ChildVector const empty;
+    return track ? track->children() : empty;
+}
+
+// The differences between two versions of a track, without looking for
+// moves.
+std::vector<ChildDifference>
+diff_children(
+    Composition const* old_track,
+    Composition const* new_track,
+    int                track_index)
+{
+    ChildVector const& old_children = children_of(old_track);
+    ChildVector const& new_children = children_of(new_track);
+
+    std::vector<Identity> old_identities;
+    std::vector<Identity> new_identities;
+    old_identities.reserve(old_children.size());
+    new_identities.reserve(new_children.size());
+    for (auto const& child: old_children)
+    {
+        old_identities.push_back(identity(child));
+    }
+    for (auto const& child: new_children)
+    {
+        new_identities.push_back(identity(child));
+    }
+
+    auto matches = Aligner(old_identities, new_identities).align();
+    matches.emplace_back(old_children.size(), new_children.size());
+
+    std::vector<ChildDifference> result;
+    size_t                       i = 0;
+    size_t                       j = 0;
+    for (auto const& match: matches)
+    {
+        for (; i < match.first; ++i)
+        {
+            ChildDifference difference;
+            difference.kind      = ChildDifference::Kind::deleted;
+            difference.old_child = old_children[i];
+            difference.old_track = track_index;
+            difference.old_index = int(i);
+            result.push_back(std::move(difference));
+        }
+        for (; j < match.second; ++j)
+        {
+            ChildDifference difference;
+            difference.kind      = ChildDifference::Kind::inserted;
+            difference.new_child = new_children[j];
+            difference.new_track = track_index;
+            difference.new_index = int(j);
+            result.push_back(std::move(difference));
+        }
+        if (i == old_children.size() && j == new_children.size())
+        {
+            break;
+        }
+
+        ChildDifference difference;
+        difference.kind      = ChildDifference::Kind::changed;
+        difference.old_child = old_children[i];
+        difference.new_child = new_children[j];
+        compare(difference);
+        if (difference.trimmed || difference.retimed)
+        {
+            difference.old_track = difference.new_track = track_index;
+            difference.old_index = int(i);
+            difference.new_index = int(j);
+            result.push_back(std::move(difference));
+        }
+        ++i;
+        ++j;
+    }
+    return result;
+}
+
+// Turn each insertion of a child that was deleted elsewhere into a move,
+// pairing them in order.
+void
+find_moves(std::vector<ChildDifference>& differences)
+{
+    std::unordered_map<std::string, std::deque<size_t>> deleted;
+    for (size_t i = 0; i < differences.size(); ++i)
+    {
+        if (differences[i].kind == ChildDifference::Kind::deleted)
+        {
+            deleted[identity(differences[i].old_child).key].push_back(i);
+        }
+    }
+    if (deleted.empty())
+    {
+        return;
+    }
+
+    std::vector<bool> moved(differences.size(), false);
+    for (auto& difference: differences)
+    {
+        if (difference.kind != ChildDifference::Kind::inserted)
+        {
+            continue;
+        }
+        auto e = deleted.find(identity(difference.new_child).key);
+        if (e == deleted.end() || e->second.empty())
+        {
+            continue;
+        }
+
+        size_t const           index = e->second.front();
+        ChildDifference const& from  = differences[index];
+        e->second.pop_front();
+        moved[index] = true;
+
+        difference.kind      = ChildDifference::Kind::moved;
+        difference.old_child = from.old_child;
+        difference.old_track = from.old_track;
+        difference.old_index = from.old_index;
+        compare(difference);
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < differences.size(); ++i)
+    {
+        if (!moved[i])
+        {
+            differences[kept++] = std::move(differences[i]);
+        }
+    }
+    differences.resize(kept);
+}
+
+Composition const*
+track_at(Timeline const* timeline, size_t index)
+{
+    if (!timeline || index >= timeline->tracks()->children().size())
+    {
+        return nullptr;
+    }
+    return fast_cast<Composition>(
+        timeline->tracks()->children()[index].value);
+}
+
+} // namespace
+
+std::vector<ChildDifference>
+diff_tracks(Composition const* old_track, Composition const* new_track)
+{
+    auto result = diff_children(old_track, new_track, 0);
+    find_moves(result);
+    return result;
+}
+
+std::vector<ChildDifference>
+diff_timelines(
+    Timeline const* old_timeline,
+    Timeline const* new_timeline,
+    ThreadPool*     thread_pool)
+{
+    size_t const count = std::max(
+        old_timeline ? old_timeline->tracks()->children().size() : 0,
+        new_timeline ? new_timeline->tracks()->children().size() : 0);
+
+    std::vector<std::vector<ChildDifference>> per_track(count);
+    parallel_for(
+        thread_pool ? *thread_pool : ThreadPool::global(),
+        count,
+        [&](size_t i) {
+            per_track[i] = diff_children(
+                track_at(old_timeline, i),
+                track_at(new_timeline, i),
+                int(i));
+        });
+
+    std::vector<ChildDifference> result;
+    for (auto& differences: per_track)
+    {
+        std::move(
+            differences.begin(),
+            differences.end(),
+            std::back_inserter(result));
+    }
+    find_moves(result);
+    return result;
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
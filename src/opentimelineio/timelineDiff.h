@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentimelineio/composable.h"
+#include "opentimelineio/version.h"
+
+#include <vector>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+class Composition;
+class ThreadPool;
+class Timeline;
+
+/// One difference between the children of a track and those of another
+/// version of it.
+///
+/// The children of the two versions are aligned by identity: their schema,
+/// their name and, for clips, the URL of their media. Children of the new
+/// version that have no counterpart in the old one are inserted; those of
+/// the old version with none in the new one are deleted. A child that is
+/// left out of the alignment on one side but has a counterpart of the same
+/// identity on the other, in the same track or in another one, has moved.
+/// A child that is aligned with its counterpart in place is reported only
+/// if it has changed, that is, if it was trimmed or retimed.
+struct ChildDifference
+{
+    enum class Kind
+    {
+        inserted,
+        deleted,
+        moved,
+        changed
+    };
+
+    Kind kind = Kind::changed;
+
+    // Whether the source range (or, for transitions, the offsets) of a
+    // moved or changed child differs from that of its counterpart.
+    bool trimmed = false;
+
+    // Whether the time effects of a moved or changed child differ from
+    // those of its counterpart.
+    bool retimed = false;
+
+    // The child in the old and new versions, and where it sits in each:
+    // the index of its track in the stack and its index in the track. Null
+    // and -1 on the side a child is missing from.
+    SerializableObject::Retainer<Composable> old_child;
+    SerializableObject::Retainer<Composable> new_child;
+    int                                      old_track = -1;
+    int                                      old_index = -1;
+    int                                      new_track = -1;
+    int                                      new_index = -1;
+};
+
+/// The differences between the children of old_track and new_track, in the
+/// order of the children of new_track, with deleted children where they
+/// were. Either track may be null, for a track that was added or removed.
+///
+/// The alignment is a shortest edit script found with Myers' algorithm,
+/// which takes time proportional to the number of children times the
+/// number of differences, so long tracks with few differences are quick to
+/// compare.
+std::vector<ChildDifference> diff_tracks(
+    Composition const* old_track,
+    Composition const* new_track);
+
+/// The differences between the tracks of old_timeline and new_timeline,
+/// which are paired by their index in the stack. The pairs of tracks are
+/// compared concurrently on thread_pool (or ThreadPool::global() if none is
+/// given); a child moved from one track to another is reported as one move.
+///
+/// The timelines must not be modified while they are compared.
+std::vector<ChildDifference> diff_timelines(
+    Timeline const* old_timeline,
+    Timeline const* new_timeline,
+    ThreadPool*     thread_pool = nullptr);
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "opentimelineio/timelineSnapshotter.h"
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+TimelineSnapshotter::TimelineSnapshotter(Timeline const* timeline)
+    : _timeline(timeline)
+    , _snapshot_generation(0)
+{}
+
+SerializableObject::Retainer<Timeline>
+TimelineSnapshotter::snapshot(ErrorStatus* error_status)
+{
+    if (_snapshot && _timeline->generation() == _snapshot_generation)
+    {
+        return _snapshot;
+    }
+
+    // a clone keeps the fields of the timeline and of its stack, dynamic
+    // fields included.
+    SerializableObject::Retainer<Timeline> new_snapshot =
+        _timeline->clone_without_children(error_status);
+    if (is_error(error_status) || !new_snapshot)
+    {
+        return nullptr;
+    }
+    Stack const* stack     = _timeline->tracks();
+    Stack*       new_stack = new_snapshot->tracks();
+
+    // tracks are shared with the previous snapshot only if its stack has
+    // the same fields, since they keep the stack they were first cloned
+    // into as their parent.
+    std::string stack_fields = new_stack->to_json_string(error_status, 0);
+    if (is_error(error_status))
+    {
+        return nullptr;
+    }
+    std::vector<SerializableObject::Retainer<Composable>> old_children;
+    if (_snapshot && stack_fields == _stack_fields)
+    {
+        old_children = _snapshot->tracks()->children();
+    }
+
+    auto const&              children = stack->children();
+    std::vector<Composable*> new_children;
+    new_children.reserve(children.size());
+    decltype(_child_generations) child_generations;
+    bool                         cloned = true;
+    for (size_t i = 0; cloned && i < children.size(); ++i)
+    {
+        Composable const* child = children[i];
+        child_generations[child] = std::make_pair(child->generation(), i);
+
+        auto old = _child_generations.find(child);
+        if (old != _child_generations.end()
+            && old->second.first == child->generation()
+            && old->second.second < old_children.size())
+        {
+            new_children.push_back(old_children[old->second.second]);
+            continue;
+        }
+
+        auto new_child = child->clone(error_status);
+        if (is_error(error_status) || !new_child)
+        {
+            if (new_child)
+            {
+                new_child->possibly_delete();
+            }
+            cloned = false;
+            continue;
+        }
+        new_children.push_back(static_cast<Composable*>(new_child));
+    }
+
+    if (!cloned || !new_stack->_share_children(new_children, error_status))
+    {
+        for (auto new_child: new_children)
+        {
+            if (!new_child->parent())
+            {
+                new_child->possibly_delete();
+            }
+        }
+        _snapshot = nullptr;
+        _child_generations.clear();
+        return nullptr;
+    }
+
+    _snapshot            = new_snapshot;
+    _snapshot_generation = _timeline->generation();
+    _stack_fields.swap(stack_fields);
+    _child_generations.swap(child_generations);
+    return _snapshot;
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
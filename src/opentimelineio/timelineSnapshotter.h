@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentimelineio/timeline.h"
+#include "opentimelineio/version.h"
+
+#include <string>
+#include <unordered_map>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+/// Hands out read-only copies of a timeline that is being edited, so that
+/// other threads can read the timeline while it is modified.
+///
+/// Snapshots are cached against the timeline's generation: asking for a
+/// snapshot when nothing has changed since the last one returns that
+/// snapshot again without copying anything. When the timeline has
+/// changed, only the tracks that changed are cloned, along with the
+/// timeline and its stack; the new stack shares the tracks that did not
+/// change with the previous snapshot, whether or not that is still held.
+///
+/// Shared tracks are not re-parented, since readers may be walking them:
+/// each keeps as its parent the stack of the snapshot it was first cloned
+/// into, which the stacks sharing it keep alive. That stack has the same
+/// fields (the snapshotter clones every track again when they change),
+/// so the ranges of a track in either stack are the same; but walking up
+/// from a track leads to that stack, so transformed_time() between items
+/// of tracks first cloned into different snapshots reports
+/// NOT_DESCENDED_FROM. Tracks are cloned whole: the range of a child of a
+/// track depends on its siblings, so its parent must be the track it is
+/// read through.
+///
+/// snapshot() reads the timeline, so it must be called on the thread that
+/// edits it. The snapshots themselves may be handed to any number of
+/// threads, which must not modify them.
+class TimelineSnapshotter
+{
+public:
+    explicit TimelineSnapshotter(Timeline const* timeline);
+
+    /// A snapshot of the timeline as it is now. If the operation fails,
+    /// null is returned and error_status is set appropriately.
+    SerializableObject::Retainer<Timeline>
+    snapshot(ErrorStatus* error_status = nullptr);
+
+private:
+    Timeline const*                        _timeline;
+    SerializableObject::Retainer<Timeline> _snapshot;
+    uint64_t                               _snapshot_generation;
+
+    // The fields of the stack, besides its children, as of the last
+    // snapshot.
+    std::string _stack_fields;
+
+    // The generation, as of the last snapshot, of each child of the
+    // timeline's stack; the clone of the child sits at the same index in
+    // the snapshot's stack.
+    std::unordered_map<Composable const*, std::pair<uint64_t, size_t>>
+        _child_generations;
+};
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
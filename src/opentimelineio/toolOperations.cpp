@@ -0,0 +1,364 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "opentimelineio/toolOperations.h"
+#include "opentimelineio/clip.h"
+#include "opentimelineio/effect.h"
+#include "opentimelineio/externalReference.h"
+#include "opentimelineio/filterAlgorithm.h"
+#include "opentimelineio/marker.h"
+#include "opentimelineio/stackAlgorithm.h"
+#include "opentimelineio/trackAlgorithm.h"
+#include "opentimelineio/transition.h"
+
+#include <algorithm>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+// Replace the children of stack with tracks, which may include some of its
+// current children.
+static void
+_set_tracks(Stack* stack, std::vector<Track*> const& tracks)
+{
+    std::vector<SerializableObject::Retainer<Track>> retained(
+        tracks.begin(),
+        tracks.end());
+    stack->clear_children();
+    stack->set_children(
+        std::vector<Composable*>(tracks.begin(), tracks.end()));
+}
+
+// Run filter over a copy of timeline, which it must keep.
+static Timeline*
+_filtered_timeline(
+    Timeline const*       timeline,
+    FilterFunction const& filter,
+    ErrorStatus*          error_status)
+{
+    auto result = filtered_composition(timeline, filter, nullptr, error_status);
+    if (result.size() != 1)
+    {
+        return nullptr;
+    }
+    return static_cast<Timeline*>(result.front().take_value());
+}
+
+void
+keep_only_video_tracks(Timeline* timeline)
+{
+    _set_tracks(timeline->tracks(), timeline->video_tracks());
+}
+
+void
+keep_only_audio_tracks(Timeline* timeline)
+{
+    _set_tracks(timeline->tracks(), timeline->audio_tracks());
+}
+
+Timeline*
+filter_transitions(Timeline const* timeline, ErrorStatus* error_status)
+{
+    return _filtered_timeline(
+        timeline,
+        [](SerializableObject* object) {
+            if (fast_cast<Transition>(object))
+            {
+                return FilterResult();
+            }
+            return FilterResult{ object };
+        },
+        error_status);
+}
+
+Timeline*
+filter_tracks(
+    Timeline const*                 timeline,
+    std::vector<std::string> const& names,
+    std::vector<int> const&         indices,
+    ErrorStatus*                    error_status)
+{
+    int index = 0;
+    return _filtered_timeline(
+        timeline,
+        [&](SerializableObject* object) {
+            auto track = fast_cast<Track>(object);
+            if (!track)
+            {
+                return FilterResult{ object };
+            }
+
+            ++index;
+            if (!indices.empty()
+                && std::find(indices.begin(), indices.end(), index)
+                       == indices.end())
+            {
+                return FilterResult();
+            }
+            if (!names.empty()
+                && std::find(names.begin(), names.end(), track->name())
+                       == names.end())
+            {
+                return FilterResult();
+            }
+            return FilterResult{ object };
+        },
+        error_status);
+}
+
+Timeline*
+filter_clips(
+    Timeline const*                 timeline,
+    std::vector<std::string> const& names,
+    std::vector<std::regex> const&  patterns,
+    ErrorStatus*                    error_status)
+{
+    return _filtered_timeline(
+        timeline,
+        [&](SerializableObject* object) {
+            auto clip = fast_cast<Clip>(object);
+            if (!clip)
+            {
+                return FilterResult{ object };
+            }
+
+            std::string const& name = clip->name();
+            if (std::find(names.begin(), names.end(), name) != names.end())
+            {
+                return FilterResult{ object };
+            }
+            for (auto const& pattern: patterns)
+            {
+                if (std::regex_search(name, pattern))
+                {
+                    return FilterResult{ object };
+                }
+            }
+            return FilterResult();
+        },
+        error_status);
+}
+
+double
+trim_rate(Timeline const* timeline, ErrorStatus* error_status)
+{
+    if (auto global_start_time = timeline->global_start_time())
+    {
+        return global_start_time->rate();
+    }
+    return timeline->duration(error_status).rate();
+}
+
+bool
+trim_timeline(
+    Timeline*        timeline,
+    TimeRange const& trim_range,
+    ErrorStatus*     error_status)
+{
+    std::vector<Track*> trimmed_tracks;
+    for (auto const& child: timeline->tracks()->children())
+    {
+        auto track = fast_cast<Track>(child.value);
+        if (!track)
+        {
+            if (error_status)
+            {
+                *error_status = ErrorStatus(
+                    ErrorStatus::TYPE_MISMATCH,
+                    "only tracks can be trimmed",
+                    child.value);
+            }
+        }
+        else
+        {
+            trimmed_tracks.push_back(
+                track_trimmed_to_range(track, trim_range, error_status));
+        }
+
+        if (is_error(error_status))
+        {
+            for (auto trimmed_track: trimmed_tracks)
+            {
+                if (trimmed_track)
+                {
+                    trimmed_track->possibly_delete();
+                }
+            }
+            return false;
+        }
+    }
+
+    _set_tracks(timeline->tracks(), trimmed_tracks);
+    return true;
+}
+
+bool
+flatten_timeline(
+    Timeline*     timeline,
+    FlattenTracks which_tracks,
+    bool          keep,
+    ErrorStatus*  error_status)
+{
+    std::vector<Track*> tracks_to_flatten;
+    std::string         kind;
+    switch (which_tracks)
+    {
+        case FlattenTracks::video:
+            tracks_to_flatten = timeline->video_tracks();
+            kind              = Track::Kind::video;
+            break;
+        case FlattenTracks::audio:
+            tracks_to_flatten = timeline->audio_tracks();
+            kind              = Track::Kind::audio;
+            break;
+        case FlattenTracks::all:
+            for (auto const& child: timeline->tracks()->children())
+            {
+                if (auto track = fast_cast<Track>(child.value))
+                {
+                    tracks_to_flatten.push_back(track);
+                }
+            }
+            if (tracks_to_flatten.empty())
+            {
+                if (error_status)
+                {
+                    *error_status = ErrorStatus(
+                        ErrorStatus::NOT_A_CHILD,
+                        "the timeline has no tracks to flatten",
+                        timeline);
+                }
+                return false;
+            }
+            kind = tracks_to_flatten.front()->kind();
+            break;
+    }
+
+    SerializableObject::Retainer<Track> flat_track =
+        flatten_stack(tracks_to_flatten, error_status);
+    if (is_error(error_status) || !flat_track)
+    {
+        return false;
+    }
+    flat_track->set_kind(kind);
+
+    if (keep)
+    {
+        return timeline->tracks()->append_child(flat_track, error_status);
+    }
+
+    std::vector<Track*> other_tracks;
+    for (auto const& child: timeline->tracks()->children())
+    {
+        auto track = fast_cast<Track>(child.value);
+        if (track
+            && std::find(
+                   tracks_to_flatten.begin(),
+                   tracks_to_flatten.end(),
+                   track)
+                   == tracks_to_flatten.end())
+        {
+            other_tracks.push_back(track);
+        }
+    }
+    other_tracks.push_back(flat_track);
+    _set_tracks(timeline->tracks(), other_tracks);
+    return true;
+}
+
+// Call function for the tracks of timeline and everything beneath them,
+// and for the markers, effects and media reference of each.
+template <typename FUNCTION>
+static void
+_for_each_object(Timeline* timeline, FUNCTION const& function)
+{
+    auto visit = [&function](Composable* child) {
+        function(child);
+        if (auto item = fast_cast<Item>(child))
+        {
+            for (auto const& marker: item->markers())
+            {
+                function(marker.value);
+            }
+            for (auto const& effect: item->effects())
+            {
+                function(effect.value);
+            }
+        }
+        if (auto clip = fast_cast<Clip>(child))
+        {
+            if (auto media_reference = clip->media_reference())
+            {
+                function(media_reference);
+            }
+        }
+        return true;
+    };
+
+    visit(timeline->tracks());
+    timeline->tracks()->visit_children(visit);
+}
+
+void
+remove_metadata_key(Timeline* timeline, std::string const& key)
+{
+    timeline->metadata().erase(key);
+    _for_each_object(timeline, [&key](SerializableObjectWithMetadata* object) {
+        object->metadata().erase(key);
+    });
+}
+
+void
+redact_timeline(Timeline* timeline, RedactionCounters& counters)
+{
+    auto redact = [&counters](SerializableObjectWithMetadata* object) {
+        std::string const schema_name = object->schema_name();
+        int const         counter     = ++counters[schema_name];
+        object->set_name(schema_name + " #" + std::to_string(counter));
+        object->metadata().clear();
+
+        auto external_reference = dynamic_cast<ExternalReference*>(object);
+        if (external_reference && !external_reference->target_url().empty())
+        {
+            external_reference->set_target_url(
+                "URL #" + std::to_string(counter));
+        }
+    };
+
+    redact(timeline);
+    _for_each_object(timeline, redact);
+}
+
+std::string
+timeline_stats(Timeline const* timeline, ErrorStatus* error_status)
+{
+    TimeRange const trimmed_range =
+        timeline->tracks()->trimmed_range(error_status);
+    if (is_error(error_status))
+    {
+        return std::string();
+    }
+
+    opentime::ErrorStatus timecode_error;
+    auto timecode = [&timecode_error](RationalTime const& time) {
+        return time.to_timecode(&timecode_error);
+    };
+    std::string const text =
+        "Name: " + timeline->name() + "\nStart:    "
+        + timecode(trimmed_range.start_time()) + "\nEnd:      "
+        + timecode(trimmed_range.end_time_exclusive()) + "\nDuration: "
+        + timecode(trimmed_range.duration());
+    if (opentime::is_error(timecode_error))
+    {
+        if (error_status)
+        {
+            *error_status = ErrorStatus(
+                ErrorStatus::INTERNAL_ERROR,
+                timecode_error.details,
+                timeline);
+        }
+        return std::string();
+    }
+    return text;
+}
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
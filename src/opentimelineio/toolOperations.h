@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include "opentimelineio/timeline.h"
+#include "opentimelineio/version.h"
+
+#include <map>
+#include <regex>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+// The timeline operations of the otiotool command line tool, for callers
+// that process many timelines. Each behaves as the otiotool function of
+// the same name does on a single timeline.
+//
+// Operations that filter a timeline return a new timeline, as
+// filtered_composition() does; the others modify the timeline in place.
+// If an operation fails, nullptr or false is returned and error_status is
+// set appropriately.
+
+// Remove all tracks except for video tracks.
+void keep_only_video_tracks(Timeline* timeline);
+
+// Remove all tracks except for audio tracks.
+void keep_only_audio_tracks(Timeline* timeline);
+
+// Return a copy of the timeline with all transitions removed.
+Timeline* filter_transitions(
+    Timeline const* timeline,
+    ErrorStatus*    error_status = nullptr);
+
+// Return a copy of the timeline with only the tracks whose names are in
+// names, if any are given, and whose 1-based indices are in indices, if any
+// are given. Tracks are counted in the order of find_children().
+Timeline* filter_tracks(
+    Timeline const*                 timeline,
+    std::vector<std::string> const& names,
+    std::vector<int> const&         indices,
+    ErrorStatus*                    error_status = nullptr);
+
+// Return a copy of the timeline with only the clips whose names are in
+// names or match one of patterns (as std::regex_search()).
+Timeline* filter_clips(
+    Timeline const*                 timeline,
+    std::vector<std::string> const& names,
+    std::vector<std::regex> const&  patterns,
+    ErrorStatus*                    error_status = nullptr);
+
+// The rate that trim_timeline() times are given at: the rate of the global
+// start time if the timeline has one, and of its duration otherwise.
+double trim_rate(Timeline const* timeline, ErrorStatus* error_status = nullptr);
+
+// Replace each track of the timeline with the track trimmed to trim_range.
+bool trim_timeline(
+    Timeline*        timeline,
+    TimeRange const& trim_range,
+    ErrorStatus*     error_status = nullptr);
+
+// Which tracks flatten_timeline() flattens.
+enum class FlattenTracks
+{
+    video,
+    audio,
+    all
+};
+
+// Replace the tracks of the timeline with the flattened track, or add it
+// above them if keep is true.
+bool flatten_timeline(
+    Timeline*     timeline,
+    FlattenTracks which_tracks = FlattenTracks::video,
+    bool          keep         = false,
+    ErrorStatus*  error_status = nullptr);
+
+// Remove key from the metadata of the timeline and of everything in it.
+void remove_metadata_key(Timeline* timeline, std::string const& key);
+
+// Counts of the objects renamed by redact_timeline(), per schema name.
+// Sharing one between calls numbers objects across the timelines.
+using RedactionCounters = std::map<std::string, int>;
+
+// Remove all metadata, names and media URLs from the timeline, leaving only
+// its structure, schema and timing.
+void redact_timeline(Timeline* timeline, RedactionCounters& counters);
+
+// The text that otiotool --stats prints for the timeline: its name, and the
+// start, end and duration of its tracks as timecode.
+std::string
+timeline_stats(Timeline const* timeline, ErrorStatus* error_status = nullptr);
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -4,6 +4,7 @@
 #include "opentimelineio/track.h"
 #include "opentimelineio/clip.h"
 #include "opentimelineio/gap.h"
+#include "opentimelineio/instrumentation.h"
 #include "opentimelineio/transition.h"
 #include "opentimelineio/vectorIndexing.h"
 
@@ -44,6 +45,8 @@ Track::write_to(Writer& writer) const
 TimeRange
 Track::range_of_child_at_index(int index, ErrorStatus* error_status) const
 {
+    OTIO_TRACE_SCOPE("Track::range_of_child_at_index");
+
     index = adjusted_vector_index(index, children());
     if (index < 0 || index >= int(children().size()))
     {
@@ -76,7 +79,7 @@ Track::range_of_child_at_index(int index, ErrorStatus* error_status) const
         }
     }
 
-    if (auto transition = dynamic_cast<Transition*>(child))
+    if (auto transition = fast_cast<Transition>(child))
     {
         start_time -= transition->in_offset();
     }
@@ -88,6 +91,8 @@ TimeRange
 Track::trimmed_range_of_child_at_index(int index, ErrorStatus* error_status)
     const
 {
+    OTIO_TRACE_SCOPE("Track::trimmed_range_of_child_at_index");
+
     auto child_range = range_of_child_at_index(index, error_status);
     if (is_error(error_status))
     {
@@ -113,7 +118,7 @@ Track::available_range(ErrorStatus* error_status) const
     RationalTime duration;
     for (const auto& child: children())
     {
-        if (auto item = dynamic_retainer_cast<Item>(child))
+        if (auto item = fast_retainer_cast<Item>(child))
         {
             duration += item->duration(error_status);
             if (is_error(error_status))
@@ -126,12 +131,12 @@ Track::available_range(ErrorStatus* error_status) const
     if (!children().empty())
     {
         if (auto transition =
-                dynamic_retainer_cast<Transition>(children().front()))
+                fast_retainer_cast<Transition>(children().front()))
         {
             duration += transition->in_offset();
         }
         if (auto transition =
-                dynamic_retainer_cast<Transition>(children().back()))
+                fast_retainer_cast<Transition>(children().back()))
         {
             duration += transition->out_offset();
         }
@@ -146,11 +151,11 @@ Track::handles_of_child(Composable const* child, ErrorStatus* error_status)
 {
     std::optional<RationalTime> head, tail;
     auto                        neighbors = neighbors_of(child, error_status);
-    if (auto transition = dynamic_retainer_cast<Transition>(neighbors.first))
+    if (auto transition = fast_retainer_cast<Transition>(neighbors.first))
     {
         head = transition->in_offset();
     }
-    if (auto transition = dynamic_retainer_cast<Transition>(neighbors.second))
+    if (auto transition = fast_retainer_cast<Transition>(neighbors.second))
     {
         tail = transition->out_offset();
     }
@@ -176,7 +181,7 @@ Track::neighbors_of(
     {
         if (insert_gap == NeighborGapPolicy::around_transitions)
         {
-            if (auto transition = dynamic_cast<Transition const*>(item))
+            if (auto transition = fast_cast<Transition>(item))
             {
                 result.first = new Gap(TimeRange(
                     // fetch the rate from the offset on the transition
@@ -194,7 +199,7 @@ Track::neighbors_of(
     {
         if (insert_gap == NeighborGapPolicy::around_transitions)
         {
-            if (auto transition = dynamic_cast<Transition const*>(item))
+            if (auto transition = fast_cast<Transition>(item))
             {
                 result.second = new Gap(TimeRange(
                     // fetch the rate from the offset on the transition
@@ -214,6 +219,8 @@ Track::neighbors_of(
 std::map<Composable*, TimeRange>
 Track::range_of_all_children(ErrorStatus* error_status) const
 {
+    OTIO_TRACE_SCOPE("Track::range_of_all_children");
+
     std::map<Composable*, TimeRange> result;
     if (children().empty())
     {
@@ -223,11 +230,11 @@ Track::range_of_all_children(ErrorStatus* error_status) const
     auto   first_child = children().front();
     double rate        = 1;
 
-    if (auto transition = dynamic_retainer_cast<Transition>(first_child))
+    if (auto transition = fast_retainer_cast<Transition>(first_child))
     {
         rate = transition->in_offset().rate();
     }
-    else if (auto item = dynamic_retainer_cast<Item>(first_child))
+    else if (auto item = fast_retainer_cast<Item>(first_child))
     {
         rate = item->trimmed_range(error_status).duration().rate();
         if (is_error(error_status))
@@ -239,13 +246,13 @@ Track::range_of_all_children(ErrorStatus* error_status) const
     RationalTime last_end_time(0, rate);
     for (const auto& child: children())
     {
-        if (auto transition = dynamic_retainer_cast<Transition>(child))
+        if (auto transition = fast_retainer_cast<Transition>(child))
         {
             result[child] = TimeRange(
                 last_end_time - transition->in_offset(),
                 transition->out_offset() + transition->in_offset());
         }
-        else if (auto item = dynamic_retainer_cast<Item>(child))
+        else if (auto item = fast_retainer_cast<Item>(child))
         {
             auto last_range = TimeRange(
                 last_end_time,
@@ -279,7 +286,7 @@ Track::available_image_bounds(ErrorStatus* error_status) const
     bool                                  found_first_clip = false;
     for (const auto& child: children())
     {
-        if (auto clip = dynamic_cast<Clip*>(child.value))
+        if (auto clip = fast_cast<Clip>(child.value))
         {
             if (auto clip_box = clip->available_image_bounds(error_status))
             {
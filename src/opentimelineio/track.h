@@ -41,7 +41,11 @@ public:
 
     std::string kind() const noexcept { return _kind; }
 
-    void set_kind(std::string const& kind) { _kind = kind; }
+    void set_kind(std::string const& kind)
+    {
+        _kind = kind;
+        _changed();
+    }
 
     TimeRange range_of_child_at_index(
         int          index,
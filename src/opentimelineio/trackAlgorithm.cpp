@@ -4,35 +4,72 @@
 #include "opentimelineio/trackAlgorithm.h"
 #include "opentimelineio/transition.h"
 
+#include <algorithm>
+
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
 
-Track*
-track_trimmed_to_range(
-    Track*       in_track,
-    TimeRange    trim_range,
-    ErrorStatus* error_status)
+namespace {
+
+// The range of every child of a track, in child order, computed the same
+// way as Track::range_of_all_children() but as a running sum over a vector
+// so that it can be binary searched.
+//
+// Transitions overlap their neighbors, so the start and end times are not
+// strictly ordered; max_end_time[i] is the latest end of children [0, i]
+// and min_start_time[i] the earliest start of children [i, n), both in
+// seconds, which are ordered and bound the children that can intersect a
+// given range.
+struct ChildRangeIndex
 {
-    Track* new_track = dynamic_cast<Track*>(in_track->clone(error_status));
-    if (is_error(error_status) || !new_track)
+    std::vector<TimeRange> ranges;
+    std::vector<double>    max_end_time;
+    std::vector<double>    min_start_time;
+};
+
+bool
+build_child_range_index(
+    Track const*     track,
+    ChildRangeIndex& index,
+    ErrorStatus*     error_status)
+{
+    auto const& children = track->children();
+    if (children.empty())
     {
-        return nullptr;
+        return true;
     }
 
-    auto track_map = new_track->range_of_all_children(error_status);
-    if (is_error(error_status))
+    double rate = 1;
+    if (auto transition = fast_retainer_cast<Transition>(children.front()))
     {
-        return nullptr;
+        rate = transition->in_offset().rate();
+    }
+    else if (auto item = fast_retainer_cast<Item>(children.front()))
+    {
+        rate = item->trimmed_range(error_status).duration().rate();
+        if (is_error(error_status))
+        {
+            return false;
+        }
     }
 
-    std::vector<Composable*> children_copy(
-        new_track->children().begin(),
-        new_track->children().end());
-
-    for (size_t i = children_copy.size(); i--;)
+    index.ranges.reserve(children.size());
+    RationalTime last_end_time(0, rate);
+    for (const auto& child: children)
     {
-        Composable* child          = children_copy[i];
-        auto        child_range_it = track_map.find(child);
-        if (child_range_it == track_map.end())
+        if (auto transition = fast_retainer_cast<Transition>(child))
+        {
+            index.ranges.emplace_back(
+                last_end_time - transition->in_offset(),
+                transition->out_offset() + transition->in_offset());
+        }
+        else if (auto item = fast_retainer_cast<Item>(child))
+        {
+            index.ranges.emplace_back(
+                last_end_time,
+                item->trimmed_range(error_status).duration());
+            last_end_time = index.ranges.back().end_time_exclusive();
+        }
+        else
         {
             if (error_status)
             {
@@ -40,21 +77,87 @@ track_trimmed_to_range(
                     ErrorStatus::CANNOT_COMPUTE_AVAILABLE_RANGE,
                     "failed to find child in track_map map");
             }
-            return nullptr;
+            return false;
         }
 
-        auto child_range = child_range_it->second;
+        if (is_error(error_status))
+        {
+            return false;
+        }
+    }
+
+    size_t const count = index.ranges.size();
+    index.max_end_time.resize(count);
+    index.min_start_time.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        double end_time = index.ranges[i].end_time_exclusive().to_seconds();
+        index.max_end_time[i] =
+            i ? std::max(index.max_end_time[i - 1], end_time) : end_time;
+    }
+    for (size_t i = count; i--;)
+    {
+        double start_time = index.ranges[i].start_time().to_seconds();
+        index.min_start_time[i] =
+            i + 1 < count ? std::min(index.min_start_time[i + 1], start_time)
+                          : start_time;
+    }
+    return true;
+}
+
+} // namespace
+
+TrimmedTrackView
+track_trimmed_view(
+    Track const* in_track,
+    TimeRange    trim_range,
+    ErrorStatus* error_status)
+{
+    TrimmedTrackView view;
+    view.track      = in_track;
+    view.trim_range = trim_range;
+
+    ChildRangeIndex index;
+    if (!build_child_range_index(in_track, index, error_status))
+    {
+        return view;
+    }
+
+    // only children in [first, last) can intersect trim_range; anything
+    // that intersects must end after it starts and start before it ends.
+    double const trim_start = trim_range.start_time().to_seconds();
+    double const trim_end   = trim_range.end_time_exclusive().to_seconds();
+    size_t const first      = size_t(
+        std::upper_bound(
+            index.max_end_time.begin(),
+            index.max_end_time.end(),
+            trim_start)
+        - index.max_end_time.begin());
+    size_t const last = size_t(
+        std::lower_bound(
+            index.min_start_time.begin(),
+            index.min_start_time.end(),
+            trim_end)
+        - index.min_start_time.begin());
+
+    auto const& children = in_track->children();
+    for (size_t i = first; i < last; ++i)
+    {
+        Composable* child       = children[i];
+        auto const& child_range = index.ranges[i];
         if (!trim_range.intersects(child_range))
         {
-            new_track->remove_child(static_cast<int>(i), error_status);
-            if (is_error(error_status))
-            {
-                return nullptr;
-            }
+            continue;
         }
-        else if (!trim_range.contains(child_range))
+
+        TrimmedTrackView::Child view_child{ int(i),
+                                            child,
+                                            child_range,
+                                            std::nullopt };
+
+        if (!trim_range.contains(child_range))
         {
-            if (dynamic_cast<Transition*>(child))
+            if (fast_cast<Transition>(child))
             {
                 if (error_status)
                 {
@@ -62,10 +165,11 @@ track_trimmed_to_range(
                         ErrorStatus::CANNOT_TRIM_TRANSITION,
                         "Cannot trim in the middle of a transition");
                 }
-                return nullptr;
+                view.children.clear();
+                return view;
             }
 
-            Item* child_item = dynamic_cast<Item*>(child);
+            Item* child_item = fast_cast<Item>(child);
             if (!child_item)
             {
                 if (error_status)
@@ -75,12 +179,14 @@ track_trimmed_to_range(
                         "Expected child of type Item*",
                         child);
                 }
-                return nullptr;
+                view.children.clear();
+                return view;
             }
             auto child_source_range = child_item->trimmed_range(error_status);
             if (is_error(error_status))
             {
-                return nullptr;
+                view.children.clear();
+                return view;
             }
 
             if (trim_range.start_time() > child_range.start_time())
@@ -92,21 +198,88 @@ track_trimmed_to_range(
                     child_source_range.duration() - trim_amount);
             }
 
-            auto trim_end  = trim_range.end_time_exclusive();
-            auto child_end = child_range.end_time_exclusive();
-            if (trim_end < child_end)
+            auto trim_end_time  = trim_range.end_time_exclusive();
+            auto child_end_time = child_range.end_time_exclusive();
+            if (trim_end_time < child_end_time)
             {
-                auto trim_amount   = child_end - trim_end;
+                auto trim_amount   = child_end_time - trim_end_time;
                 child_source_range = TimeRange(
                     child_source_range.start_time(),
                     child_source_range.duration() - trim_amount);
             }
 
-            child_item->set_source_range(child_source_range);
+            view_child.trimmed_source_range = child_source_range;
+        }
+
+        view.children.push_back(view_child);
+    }
+
+    return view;
+}
+
+Track*
+track_trimmed_to_range(
+    Track*       in_track,
+    TimeRange    trim_range,
+    ErrorStatus* error_status)
+{
+    ErrorStatus view_error;
+    auto        view = track_trimmed_view(in_track, trim_range, &view_error);
+    if (is_error(view_error))
+    {
+        if (error_status)
+        {
+            *error_status = view_error;
         }
+        return nullptr;
+    }
+
+    // clone the track itself without its children, then clone only the
+    // children that survive the trim.
+    SerializableObject::Retainer<Track> new_track =
+        dynamic_cast<Track*>(in_track->clone_without_children(error_status));
+    if (is_error(error_status) || !new_track)
+    {
+        return nullptr;
+    }
+
+    std::vector<Composable*> new_children;
+    new_children.reserve(view.children.size());
+    for (auto const& view_child: view.children)
+    {
+        auto new_child = static_cast<Composable*>(
+            view_child.composable->clone(error_status));
+        if (is_error(error_status) || !new_child)
+        {
+            for (auto child: new_children)
+            {
+                child->possibly_delete();
+            }
+            if (new_child)
+            {
+                new_child->possibly_delete();
+            }
+            return nullptr;
+        }
+
+        if (view_child.trimmed_source_range)
+        {
+            static_cast<Item*>(new_child)->set_source_range(
+                view_child.trimmed_source_range);
+        }
+        new_children.push_back(new_child);
+    }
+
+    if (!new_track->set_children(new_children, error_status))
+    {
+        for (auto child: new_children)
+        {
+            child->possibly_delete();
+        }
+        return nullptr;
     }
 
-    return new_track;
+    return new_track.take_value();
 }
 
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
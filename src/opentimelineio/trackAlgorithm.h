@@ -13,4 +13,42 @@ Track* track_trimmed_to_range(
     TimeRange    trim_range,
     ErrorStatus* error_status = nullptr);
 
+/// A read-only view of a track trimmed to a range.
+///
+/// This describes what track_trimmed_to_range() would produce without
+/// cloning anything, for consumers that only need to read the result.
+/// The view does not retain the track or its children; it is only valid
+/// while the track is alive and unmodified.
+struct TrimmedTrackView
+{
+    struct Child
+    {
+        /// The index of the child in the track's children().
+        int index;
+
+        Composable* composable;
+
+        /// The untrimmed range of the child within the track.
+        TimeRange range_in_track;
+
+        /// For items that are cut by the trim range, the source range that
+        /// keeps only the part inside it. Unset for children that lie
+        /// entirely inside the trim range.
+        std::optional<TimeRange> trimmed_source_range;
+    };
+
+    Track const*       track = nullptr;
+    TimeRange          trim_range;
+    std::vector<Child> children;
+};
+
+/// Build a TrimmedTrackView of in_track trimmed to trim_range.
+///
+/// Fails in the same cases as track_trimmed_to_range(), e.g. when
+/// trim_range cuts through a transition.
+TrimmedTrackView track_trimmed_view(
+    Track const* in_track,
+    TimeRange    trim_range,
+    ErrorStatus* error_status = nullptr);
+
 }} // namespace opentimelineio::OPENTIMELINEIO_VERSION
@@ -39,20 +39,23 @@ public:
     void set_transition_type(std::string const& transition_type)
     {
         _transition_type = transition_type;
+        _changed();
     }
 
     RationalTime in_offset() const noexcept { return _in_offset; }
 
-    void set_in_offset(RationalTime const& in_offset) noexcept
+    void set_in_offset(RationalTime const& in_offset)
     {
         _in_offset = in_offset;
+        _changed();
     }
 
     RationalTime out_offset() const noexcept { return _out_offset; }
 
-    void set_out_offset(RationalTime const& out_offset) noexcept
+    void set_out_offset(RationalTime const& out_offset)
     {
         _out_offset = out_offset;
+        _changed();
     }
 
     RationalTime duration(ErrorStatus* error_status = nullptr) const override;
@@ -13,6 +13,7 @@
 #include "opentimelineio/gap.h"
 #include "opentimelineio/generatorReference.h"
 #include "opentimelineio/imageSequenceReference.h"
+#include "opentimelineio/instrumentation.h"
 #include "opentimelineio/item.h"
 #include "opentimelineio/linearTimeWarp.h"
 #include "opentimelineio/marker.h"
@@ -144,7 +145,8 @@ TypeRegistry::register_type(
     int                                  schema_version,
     std::type_info const*                type,
     std::function<SerializableObject*()> create,
-    std::string const&                   class_name)
+    std::string const&                   class_name,
+    uint32_t                             type_tags)
 {
     std::lock_guard<std::mutex> lock(_registry_mutex);
 
@@ -169,8 +171,9 @@ TypeRegistry::register_type(
 
     if (!_find_type_record(schema_name))
     {
-        _TypeRecord* r =
-            new _TypeRecord{ schema_name, schema_version, class_name, create };
+        _TypeRecord* r = new _TypeRecord{
+            schema_name, schema_version, class_name, create, type_tags
+        };
         _type_records[schema_name] = r;
         if (type)
         {
@@ -196,7 +199,8 @@ TypeRegistry::register_type_from_existing_type(
             _type_records[schema_name] = new _TypeRecord{ r->schema_name,
                                                           r->schema_version,
                                                           r->class_name,
-                                                          r->create };
+                                                          r->create,
+                                                          r->type_tags };
             return true;
         }
 
@@ -267,6 +271,10 @@ TypeRegistry::_instance_from_schema(
     _TypeRecord const* type_record;
     bool               create_unknown = false;
 
+    // the upgrade functions are copied out while the lock is held, since
+    // another thread may be registering new ones while we run them.
+    std::vector<std::function<void(AnyDictionary*)>> upgrade_functions;
+
     {
         std::lock_guard<std::mutex> lock(_registry_mutex);
         type_record = _find_type_record(schema_name);
@@ -277,6 +285,17 @@ TypeRegistry::_instance_from_schema(
             type_record    = _find_type_record(UnknownSchema::Schema::name);
             assert(type_record);
         }
+        else if (schema_version < type_record->schema_version)
+        {
+            for (const auto& e: type_record->upgrade_functions)
+            {
+                if (schema_version <= e.first
+                    && e.first <= type_record->schema_version)
+                {
+                    upgrade_functions.push_back(e.second);
+                }
+            }
+        }
     }
 
     SerializableObject* so;
@@ -306,16 +325,15 @@ TypeRegistry::_instance_from_schema(
         }
         return nullptr;
     }
-    else if (schema_version < type_record->schema_version)
+    else if (!upgrade_functions.empty())
     {
-        for (const auto& e: type_record->upgrade_functions)
+        OTIO_TRACE_SCOPE("TypeRegistry upgrade");
+
+        for (const auto& upgrade_function: upgrade_functions)
         {
-            if (schema_version <= e.first
-                && e.first <= type_record->schema_version)
-            {
-                e.second(&dict);
-            }
+            upgrade_function(&dict);
         }
+        OTIO_COUNT("upgrade functions applied", upgrade_functions.size());
     }
 
     if (internal_read)
@@ -344,6 +362,23 @@ TypeRegistry::_lookup_type_record(std::string const& schema_name)
     return e != _type_records.end() ? e->second : nullptr;
 }
 
+std::function<void(AnyDictionary*)>
+TypeRegistry::_lookup_downgrade_function(
+    std::string const& schema_name,
+    int                version_to_downgrade_from)
+{
+    std::lock_guard<std::mutex> lock(_registry_mutex);
+    if (auto r = _find_type_record(schema_name))
+    {
+        auto e = r->downgrade_functions.find(version_to_downgrade_from);
+        if (e != r->downgrade_functions.end())
+        {
+            return e->second;
+        }
+    }
+    return nullptr;
+}
+
 TypeRegistry::_TypeRecord*
 TypeRegistry::_lookup_type_record(std::type_info const& type)
 {
@@ -7,10 +7,12 @@
 #include "opentimelineio/version.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <mutex>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
@@ -19,6 +21,102 @@ class SerializableObject;
 class Encoder;
 class AnyDictionary;
 
+class Clip;
+class Composable;
+class Composition;
+class Effect;
+class Gap;
+class Item;
+class Marker;
+class MediaReference;
+class Stack;
+class TimeEffect;
+class Track;
+class Transition;
+
+/// Bits identifying the core classes that a registered type derives from.
+/// Each type record carries the tags of its type, which lets fast_cast()
+/// test an object's class without a dynamic_cast.
+struct TypeTag
+{
+    enum : uint32_t
+    {
+        COMPOSABLE      = 1 << 0,
+        ITEM            = 1 << 1,
+        COMPOSITION     = 1 << 2,
+        TRACK           = 1 << 3,
+        STACK           = 1 << 4,
+        CLIP            = 1 << 5,
+        GAP             = 1 << 6,
+        TRANSITION      = 1 << 7,
+        MEDIA_REFERENCE = 1 << 8,
+        EFFECT          = 1 << 9,
+        TIME_EFFECT     = 1 << 10,
+        MARKER          = 1 << 11,
+
+        /// Set when the rest of the tags are known. Types registered from
+        /// another language (e.g. Python) do not have it, and are tested
+        /// with dynamic_cast instead.
+        KNOWN = 1u << 31
+    };
+};
+
+/// The tag of each core class, or zero for any other class.
+template <typename T>
+struct TypeTagOf : std::integral_constant<uint32_t, 0>
+{};
+
+#define OTIO_TYPE_TAG(CLASS, TAG)                                              \
+    template <>                                                                \
+    struct TypeTagOf<CLASS> : std::integral_constant<uint32_t, TypeTag::TAG>   \
+    {};
+
+OTIO_TYPE_TAG(Composable, COMPOSABLE)
+OTIO_TYPE_TAG(Item, ITEM)
+OTIO_TYPE_TAG(Composition, COMPOSITION)
+OTIO_TYPE_TAG(Track, TRACK)
+OTIO_TYPE_TAG(Stack, STACK)
+OTIO_TYPE_TAG(Clip, CLIP)
+OTIO_TYPE_TAG(Gap, GAP)
+OTIO_TYPE_TAG(Transition, TRANSITION)
+OTIO_TYPE_TAG(MediaReference, MEDIA_REFERENCE)
+OTIO_TYPE_TAG(Effect, EFFECT)
+OTIO_TYPE_TAG(TimeEffect, TIME_EFFECT)
+OTIO_TYPE_TAG(Marker, MARKER)
+
+#undef OTIO_TYPE_TAG
+
+template <typename T, typename... CORE>
+constexpr uint32_t
+_type_tags_of_core()
+{
+    // std::is_base_of only needs T to be complete, so CORE may be declared
+    // but not defined.
+    return ((std::is_base_of<CORE, T>::value ? TypeTagOf<CORE>::value : 0u)
+            | ... | TypeTag::KNOWN);
+}
+
+/// The tags of every core class that T is or derives from.
+template <typename T>
+constexpr uint32_t
+type_tags_of()
+{
+    return _type_tags_of_core<
+        T,
+        Composable,
+        Item,
+        Composition,
+        Track,
+        Stack,
+        Clip,
+        Gap,
+        Transition,
+        MediaReference,
+        Effect,
+        TimeEffect,
+        Marker>();
+}
+
 // typedefs for the schema downgrading system
 // @TODO: should we make version an int64_t?  That would match what we can
 //        serialize natively, since we only serialize 64 bit signed ints.
@@ -42,12 +140,17 @@ public:
     /// the templated form of this call.
     ///
     /// If the specified schema_name has already been registered, this function does nothing and returns false.
+    ///
+    /// type_tags should be type_tags_of() the class that create() makes, if
+    /// it is known; objects of types registered without tags are tested
+    /// with dynamic_cast by fast_cast().
     bool register_type(
         std::string const&                   schema_name,
         int                                  schema_version,
         std::type_info const*                type,
         std::function<SerializableObject*()> create,
-        std::string const&                   class_name = "");
+        std::string const&                   class_name = "",
+        uint32_t                             type_tags  = 0);
 
     /// Register a new SerializableObject class
     ///
@@ -61,7 +164,8 @@ public:
             CLASS::Schema::version,
             &typeid(CLASS),
             []() -> SerializableObject* { return new CLASS; },
-            CLASS::Schema::name);
+            CLASS::Schema::name,
+            type_tags_of<CLASS>());
     }
 
     /// Register a new schema.
@@ -161,6 +265,7 @@ private:
         int                                  schema_version;
         std::string                          class_name;
         std::function<SerializableObject*()> create;
+        uint32_t                             type_tags;
 
         std::map<int, std::function<void(AnyDictionary*)>> upgrade_functions;
         std::map<int, std::function<void(AnyDictionary*)>> downgrade_functions;
@@ -169,12 +274,14 @@ private:
             std::string                          _schema_name,
             int                                  _schema_version,
             std::string                          _class_name,
-            std::function<SerializableObject*()> _create)
+            std::function<SerializableObject*()> _create,
+            uint32_t                             _type_tags)
         {
             this->schema_name    = _schema_name;
             this->schema_version = _schema_version;
             this->class_name     = _class_name;
             this->create         = _create;
+            this->type_tags      = _type_tags;
         }
 
         SerializableObject* create_object() const;
@@ -201,8 +308,15 @@ private:
     static std::pair<std::string, int>
                  _schema_and_version_from_label(std::string const& label);
     _TypeRecord* _lookup_type_record(std::string const& schema_name);
+
+    // Takes the registry lock, but SerializableObject caches the result, so
+    // this is only called the first time an object needs its type record.
     _TypeRecord* _lookup_type_record(std::type_info const& type);
 
+    std::function<void(AnyDictionary*)> _lookup_downgrade_function(
+        std::string const& schema_name,
+        int                version_to_downgrade_from);
+
     std::mutex                          _registry_mutex;
     std::map<std::string, _TypeRecord*> _type_records;
     std::map<std::string, _TypeRecord*> _type_records_by_type_name;
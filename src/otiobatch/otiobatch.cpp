@@ -0,0 +1,607 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// otiobatch runs the timeline operations of otiotool over many OTIO files at
+// once, one file per worker thread.
+//
+// Each input file is processed on its own, exactly as
+//
+//     otiotool -i INPUT [operations] -o OUTPUT
+//
+// would process it, and the text otiotool would print for it is written to
+// standard output as soon as the files before it are done, so the output
+// is the same as running otiotool over the files one after another.
+
+#include <opentimelineio/threadPool.h>
+#include <opentimelineio/toolOperations.h>
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
+
+namespace {
+
+struct Options
+{
+    std::vector<std::string> inputs;
+
+    bool                     video_only         = false;
+    bool                     audio_only         = false;
+    bool                     remove_transitions = false;
+    std::vector<std::string> only_tracks_with_name;
+    std::vector<int>         only_tracks_with_index;
+    std::vector<std::string> only_clips_with_name;
+    std::vector<std::string> only_clips_with_name_regex;
+    std::vector<std::string> trim;
+
+    std::optional<otio::FlattenTracks> flatten;
+    bool                               keep_flattened_tracks = false;
+
+    std::vector<std::string> remove_metadata_key;
+    bool                     redact = false;
+    bool                     stats  = false;
+
+    std::string output;
+    std::string output_dir;
+    int         jobs = 0;
+
+    std::vector<std::regex> clip_name_patterns;
+};
+
+// The text printed for one input, and whether it was processed.
+struct Result
+{
+    std::string out;
+    std::string err;
+    bool        ok = true;
+};
+
+const char* const usage = R"(usage: otiobatch [options] --input PATH [PATH ...]
+
+Run otiotool's timeline operations over many OTIO files concurrently. Each
+input is processed as "otiotool --input PATH [options]" would process it.
+
+Filter:
+  -v, --video-only                    Output only video tracks
+  -a, --audio-only                    Output only audio tracks
+  --only-tracks-with-name NAME ...    Output tracks with these name(s)
+  --only-tracks-with-index INDEX ...  Output tracks with these indexes
+  --only-clips-with-name NAME ...     Output only clips with these name(s)
+  --only-clips-with-name-regex REGEX ...
+                                      Output only clips with names matching
+                                      one of the regular expressions
+  --remove-transitions                Remove all transitions
+  -t, --trim START END                Trim from START to END, each given as
+                                      seconds or HH:MM:SS:FF timecode
+Combine:
+  -f, --flatten TYPE                  Flatten 'video', 'audio' or 'all'
+                                      tracks into one
+  --keep-flattened-tracks             Add the flat track above the others
+Remove/Redact:
+  --remove-metadata-key KEY ...       Remove these top-level metadata keys
+                                      from all objects
+  --redact                            Remove all metadata, names, etc.
+Inspect:
+  --stats                             List the start, end and duration
+Output:
+  -o, --output PATH                   Output file for a single input; use
+                                      '-' to write to standard output
+  --output-dir DIR                    Write each output to DIR, under the
+                                      name of its input; the inputs must
+                                      have distinct names
+  -j, --jobs N                        Number of worker threads (default: one
+                                      per core)
+
+Inputs must be .otio files; use '-' to read one from standard input. The
+--stack, --concat, relinking, --downgrade and listing options of otiotool
+are not supported.
+)";
+
+// As with argparse, '-' alone and negative numbers are values.
+bool
+is_option(std::string const& arg)
+{
+    return arg.size() > 1 && arg[0] == '-'
+           && !(std::isdigit(static_cast<unsigned char>(arg[1]))
+                || arg[1] == '.');
+}
+
+std::string
+output_path_for(std::string const& input, Options const& options)
+{
+    if (!options.output_dir.empty())
+    {
+        std::string name = input == "-" ? "stdin.otio" : input;
+        auto        slash = name.find_last_of("/\\");
+        if (slash != std::string::npos)
+        {
+            name = name.substr(slash + 1);
+        }
+        return options.output_dir + "/" + name;
+    }
+    return options.output;
+}
+
+// Parse the command line as otiotool's argparse parser would: an option
+// takes up to max_count values, stopping at the next option.
+bool
+parse_arguments(int argc, char* argv[], Options& options, std::string& error)
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    size_t                   i = 0;
+
+    auto values = [&](std::string const& option,
+                      size_t             min_count,
+                      size_t             max_count = SIZE_MAX) {
+        std::vector<std::string> result;
+        while (result.size() < max_count && i + 1 < args.size()
+               && !is_option(args[i + 1]))
+        {
+            result.push_back(args[++i]);
+        }
+        if (result.size() < min_count)
+        {
+            error = "expected at least " + std::to_string(min_count)
+                    + " argument(s) for " + option;
+        }
+        return result;
+    };
+
+    for (; i < args.size() && error.empty(); ++i)
+    {
+        std::string const& arg = args[i];
+        if (arg == "-h" || arg == "--help")
+        {
+            std::cout << usage;
+            std::exit(0);
+        }
+        else if (arg == "-i" || arg == "--input")
+        {
+            auto inputs = values(arg, 1);
+            options.inputs.insert(
+                options.inputs.end(),
+                inputs.begin(),
+                inputs.end());
+        }
+        else if (arg == "-v" || arg == "--video-only")
+        {
+            options.video_only = true;
+        }
+        else if (arg == "-a" || arg == "--audio-only")
+        {
+            options.audio_only = true;
+        }
+        else if (arg == "--only-tracks-with-name")
+        {
+            options.only_tracks_with_name = values(arg, 1);
+        }
+        else if (arg == "--only-tracks-with-index")
+        {
+            for (auto const& value: values(arg, 1))
+            {
+                char* end   = nullptr;
+                long  index = std::strtol(value.c_str(), &end, 10);
+                if (value.empty() || *end)
+                {
+                    error = "invalid int value: '" + value + "'";
+                }
+                options.only_tracks_with_index.push_back(int(index));
+            }
+        }
+        else if (arg == "--only-clips-with-name")
+        {
+            options.only_clips_with_name = values(arg, 1);
+        }
+        else if (arg == "--only-clips-with-name-regex")
+        {
+            options.only_clips_with_name_regex = values(arg, 1);
+        }
+        else if (arg == "--remove-transitions")
+        {
+            options.remove_transitions = true;
+        }
+        else if (arg == "-t" || arg == "--trim")
+        {
+            options.trim = values(arg, 2, 2);
+        }
+        else if (arg == "-f" || arg == "--flatten")
+        {
+            auto        which  = values(arg, 1, 1);
+            std::string choice = which.empty() ? std::string() : which[0];
+            if (choice == "video")
+            {
+                options.flatten = otio::FlattenTracks::video;
+            }
+            else if (choice == "audio")
+            {
+                options.flatten = otio::FlattenTracks::audio;
+            }
+            else if (choice == "all")
+            {
+                options.flatten = otio::FlattenTracks::all;
+            }
+            else if (!which.empty())
+            {
+                error = "invalid choice: '" + choice
+                        + "' (choose from 'video', 'audio', 'all')";
+            }
+        }
+        else if (arg == "--keep-flattened-tracks")
+        {
+            options.keep_flattened_tracks = true;
+        }
+        else if (arg == "--remove-metadata-key")
+        {
+            options.remove_metadata_key = values(arg, 1);
+        }
+        else if (arg == "--redact")
+        {
+            options.redact = true;
+        }
+        else if (arg == "--stats")
+        {
+            options.stats = true;
+        }
+        else if (arg == "-o" || arg == "--output")
+        {
+            auto output = values(arg, 1, 1);
+            options.output = output.empty() ? std::string() : output[0];
+        }
+        else if (arg == "--output-dir")
+        {
+            auto output_dir = values(arg, 1, 1);
+            options.output_dir =
+                output_dir.empty() ? std::string() : output_dir[0];
+        }
+        else if (arg == "-j" || arg == "--jobs")
+        {
+            for (auto const& value: values(arg, 1, 1))
+            {
+                char* end  = nullptr;
+                long  jobs = std::strtol(value.c_str(), &end, 10);
+                if (value.empty() || *end)
+                {
+                    error = "invalid int value: '" + value + "'";
+                }
+                else if (jobs < 1 || jobs > std::numeric_limits<int>::max())
+                {
+                    error = "argument " + arg + ": expected a positive number "
+                            "of jobs, not " + value;
+                }
+                options.jobs = int(jobs);
+            }
+        }
+        else
+        {
+            error = "unrecognized argument: " + arg;
+        }
+    }
+
+    if (!error.empty())
+    {
+        return false;
+    }
+
+    if (options.inputs.empty())
+    {
+        error = "must specify --input";
+    }
+    else if (options.video_only && options.audio_only)
+    {
+        error = "Cannot use --video-only and --audio-only at the same time.";
+    }
+    else if (options.keep_flattened_tracks && !options.flatten)
+    {
+        error = "Cannot use --keep-flattened-tracks without also using "
+                "--flatten.";
+    }
+    else if (!options.output.empty() && !options.output_dir.empty())
+    {
+        error = "Cannot use --output and --output-dir at the same time.";
+    }
+    else if (!options.output.empty() && options.inputs.size() > 1)
+    {
+        error = "Use --output-dir to write the output of several inputs.";
+    }
+    if (!error.empty())
+    {
+        return false;
+    }
+
+    // inputs of the same name in different folders would overwrite each
+    // other's output, in whatever order the workers finish
+    std::map<std::string, std::string> inputs_by_output;
+    for (size_t i = 0; !options.output_dir.empty() && i < options.inputs.size();
+         ++i)
+    {
+        std::string const& input       = options.inputs[i];
+        std::string const  output_path = output_path_for(input, options);
+        auto const inserted = inputs_by_output.emplace(output_path, input);
+        if (!inserted.second)
+        {
+            error = "Inputs '" + inserted.first->second + "' and '" + input
+                    + "' would both be written to '" + output_path + "'.";
+            return false;
+        }
+    }
+
+    // compile the patterns once, before any worker uses them
+    for (auto const& pattern: options.only_clips_with_name_regex)
+    {
+        try
+        {
+            options.clip_name_patterns.emplace_back(pattern);
+        }
+        catch (std::regex_error const& e)
+        {
+            error = "invalid regular expression '" + pattern + "': " + e.what();
+            return false;
+        }
+    }
+    return true;
+}
+
+// As otiotool's time_from_string().
+bool
+time_from_string(
+    std::string const&  text,
+    double              rate,
+    otio::RationalTime& time)
+{
+    opentime::ErrorStatus error_status;
+    if (text.find(':') != std::string::npos)
+    {
+        time = otio::RationalTime::from_timecode(text, rate, &error_status);
+        return !opentime::is_error(error_status);
+    }
+
+    char*  end     = nullptr;
+    double seconds = std::strtod(text.c_str(), &end);
+    if (text.empty() || *end)
+    {
+        return false;
+    }
+    time = otio::RationalTime::from_seconds(seconds, rate);
+    return true;
+}
+
+// Replace the retained timeline with the result of a filter operation.
+bool
+take_filtered(
+    otio::SerializableObject::Retainer<otio::Timeline>& timeline,
+    otio::Timeline*                                     filtered)
+{
+    if (!filtered)
+    {
+        return false;
+    }
+    timeline = filtered;
+    return true;
+}
+
+// Process one input, in the order of otiotool's phases.
+Result
+process_input(std::string const& input, Options const& options)
+{
+    Result            result;
+    otio::ErrorStatus error_status;
+    auto              fail = [&](std::string const& message) {
+        result.err = "ERROR: " + input + ": " + message + "\n";
+        result.ok  = false;
+        return result;
+    };
+
+    otio::SerializableObject::Retainer<otio::SerializableObject> object;
+    if (input == "-")
+    {
+        std::string text(
+            (std::istreambuf_iterator<char>(std::cin)),
+            std::istreambuf_iterator<char>());
+        object =
+            otio::SerializableObject::from_json_string(text, &error_status);
+    }
+    else
+    {
+        object = otio::SerializableObject::from_json_file(input, &error_status);
+    }
+    if (otio::is_error(error_status))
+    {
+        return fail(error_status.full_description);
+    }
+
+    otio::SerializableObject::Retainer<otio::Timeline> timeline(
+        dynamic_cast<otio::Timeline*>(object.value));
+    if (!timeline)
+    {
+        return fail("not a timeline");
+    }
+
+    // Phase 2: Filter
+    if (options.video_only)
+    {
+        otio::keep_only_video_tracks(timeline);
+    }
+    if (options.audio_only)
+    {
+        otio::keep_only_audio_tracks(timeline);
+    }
+    if (options.remove_transitions
+        && !take_filtered(
+            timeline,
+            otio::filter_transitions(timeline, &error_status)))
+    {
+        return fail(error_status.full_description);
+    }
+    if ((!options.only_tracks_with_name.empty()
+         || !options.only_tracks_with_index.empty())
+        && !take_filtered(
+            timeline,
+            otio::filter_tracks(
+                timeline,
+                options.only_tracks_with_name,
+                options.only_tracks_with_index,
+                &error_status)))
+    {
+        return fail(error_status.full_description);
+    }
+    if ((!options.only_clips_with_name.empty()
+         || !options.clip_name_patterns.empty())
+        && !take_filtered(
+            timeline,
+            otio::filter_clips(
+                timeline,
+                options.only_clips_with_name,
+                options.clip_name_patterns,
+                &error_status)))
+    {
+        return fail(error_status.full_description);
+    }
+    if (!options.trim.empty())
+    {
+        double const rate = otio::trim_rate(timeline, &error_status);
+        otio::RationalTime start_time;
+        otio::RationalTime end_time;
+        if (otio::is_error(error_status)
+            || !time_from_string(options.trim[0], rate, start_time)
+            || !time_from_string(options.trim[1], rate, end_time))
+        {
+            return fail(
+                "Start and end arguments to --trim must be either "
+                "HH:MM:SS:FF or a floating point number of seconds, not '"
+                + options.trim[0] + "' and '" + options.trim[1] + "'");
+        }
+        auto trim_range = otio::TimeRange::range_from_start_end_time(
+            start_time,
+            end_time);
+        if (!otio::trim_timeline(timeline, trim_range, &error_status))
+        {
+            return fail(error_status.full_description);
+        }
+    }
+
+    // Phase 4: Combine tracks
+    if (options.flatten
+        && !otio::flatten_timeline(
+            timeline,
+            *options.flatten,
+            options.keep_flattened_tracks,
+            &error_status))
+    {
+        return fail(error_status.full_description);
+    }
+
+    // Phase 6: Remove/Redact
+    for (auto const& key: options.remove_metadata_key)
+    {
+        otio::remove_metadata_key(timeline, key);
+    }
+    if (options.redact)
+    {
+        otio::RedactionCounters counters;
+        otio::redact_timeline(timeline, counters);
+    }
+
+    // Phase 7: Inspect
+    if (options.stats)
+    {
+        std::string stats = otio::timeline_stats(timeline, &error_status);
+        if (otio::is_error(error_status))
+        {
+            return fail(error_status.full_description);
+        }
+        result.out += stats + "\n";
+    }
+
+    // Final Phase: Output
+    std::string output_path = output_path_for(input, options);
+    if (output_path == "-")
+    {
+        std::string json = timeline->to_json_string(&error_status);
+        if (otio::is_error(error_status))
+        {
+            return fail(error_status.full_description);
+        }
+        result.out += json + "\n";
+    }
+    else if (
+        !output_path.empty()
+        && !timeline->to_json_file(output_path, &error_status))
+    {
+        return fail(error_status.full_description);
+    }
+    return result;
+}
+
+// Writes the results of the inputs in input order, each as soon as it and
+// every result before it are ready.
+class OrderedPrinter
+{
+public:
+    explicit OrderedPrinter(size_t count)
+        : _results(count)
+    {}
+
+    void finish(size_t index, Result&& result)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _results[index] = std::move(result);
+        for (; _next < _results.size() && _results[_next]; ++_next)
+        {
+            Result& next = *_results[_next];
+            std::cout << next.out << std::flush;
+            std::cerr << next.err << std::flush;
+            _failed = _failed || !next.ok;
+            _results[_next].reset();
+        }
+    }
+
+    bool failed() const { return _failed; }
+
+private:
+    std::mutex                         _mutex;
+    std::vector<std::optional<Result>> _results;
+    size_t                             _next   = 0;
+    bool                               _failed = false;
+};
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    Options     options;
+    std::string error;
+    if (!parse_arguments(argc, argv, options, error))
+    {
+        std::cerr << usage << "otiobatch: error: " << error << std::endl;
+        return 2;
+    }
+
+    OrderedPrinter   printer(options.inputs.size());
+    otio::ThreadPool pool(options.jobs);
+    otio::parallel_for(pool, options.inputs.size(), [&](size_t i) {
+        Result result;
+        try
+        {
+            result = process_input(options.inputs[i], options);
+        }
+        catch (std::exception const& e)
+        {
+            result.err = "ERROR: " + options.inputs[i] + ": " + e.what() + "\n";
+            result.ok  = false;
+        }
+        printer.finish(i, std::move(result));
+    });
+
+    return printer.failed() ? 1 : 0;
+}
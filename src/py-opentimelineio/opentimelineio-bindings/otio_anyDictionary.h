@@ -63,14 +63,9 @@ struct AnyDictionaryProxy : public AnyDictionary::MutationStamp {
     }
 
     void set_item(std::string const& key, PyAny* pyAny) {
+        // through operator[], which tells the owner of the dictionary
         AnyDictionary& m = fetch_any_dictionary();
-        auto it = m.find(key);
-        if (it != m.end()) {
-            std::swap(it->second, pyAny->a);
-        }
-        else {
-            m.emplace(key, std::move(pyAny->a));
-        }
+        std::swap(m[key], pyAny->a);
     }
     
     void del_item(std::string const& key) {
@@ -3,6 +3,7 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include "otio_anyDictionary.h"
 #include "otio_anyVector.h"
 #include "otio_bindings.h"
@@ -12,10 +13,24 @@
 #include "opentimelineio/deserialization.h"
 #include "opentimelineio/serializableObject.h"
 #include "opentimelineio/typeRegistry.h"
+#include "opentimelineio/clip.h"
+#include "opentimelineio/clipTable.h"
+#include "opentimelineio/contentHash.h"
+#include "opentimelineio/deltaSerializer.h"
+#include "opentimelineio/filterAlgorithm.h"
+#include "opentimelineio/gap.h"
+#include "opentimelineio/instrumentation.h"
+#include "opentimelineio/memoryFootprint.h"
 #include "opentimelineio/stackAlgorithm.h"
+#include "opentimelineio/timeWarpEvaluator.h"
+#include "opentimelineio/timelineDiff.h"
+#include "opentimelineio/timelineSnapshotter.h"
+#include "opentimelineio/transition.h"
 
 #include <Imath/ImathBox.h>
 
+#include <algorithm>
+
 namespace py = pybind11;
 using namespace pybind11::literals;
 
@@ -166,6 +181,136 @@ static SerializableObject* instance_from_schema(std::string schema_name,
     return result;
 }
 
+template<typename T>
+static bool is_instance_of(SerializableObject const* so) {
+    return fast_cast<T>(so) != nullptr;
+}
+
+// The C++ test for instances of one of the core schema classes, or null for
+// any other type, whose instances can only be recognized with isinstance().
+static bool (*core_instance_test(py::handle type))(SerializableObject const*) {
+    if (type.is(py::type::handle_of<Clip>())) return &is_instance_of<Clip>;
+    if (type.is(py::type::handle_of<Composable>())) return &is_instance_of<Composable>;
+    if (type.is(py::type::handle_of<Composition>())) return &is_instance_of<Composition>;
+    if (type.is(py::type::handle_of<Gap>())) return &is_instance_of<Gap>;
+    if (type.is(py::type::handle_of<Item>())) return &is_instance_of<Item>;
+    if (type.is(py::type::handle_of<Stack>())) return &is_instance_of<Stack>;
+    if (type.is(py::type::handle_of<Track>())) return &is_instance_of<Track>;
+    if (type.is(py::type::handle_of<Transition>())) return &is_instance_of<Transition>;
+    return nullptr;
+}
+
+// Run the C++ filter engine for algorithms.filtered_composition() and
+// filtered_with_sequence_context(). The GIL is only held while filter_fn (or,
+// for types_to_prune that are not core schema classes, isinstance()) runs.
+static py::object filtered(SerializableObject* root, py::object filter_fn,
+                           py::tuple types_to_prune, bool with_sequence_context) {
+    auto wrap = [](SerializableObject* so) -> py::object {
+        return py::cast(so, py::return_value_policy::take_ownership);
+    };
+
+    std::vector<bool (*)(SerializableObject const*)> tests;
+    bool all_core_types = true;
+    for (auto type: types_to_prune) {
+        auto test = core_instance_test(type);
+        tests.push_back(test);
+        all_core_types = all_core_types && test;
+    }
+
+    PrunePredicate prune;
+    if (types_to_prune.size() > 0 && all_core_types) {
+        prune = [&tests](SerializableObject const* so) {
+            return std::any_of(tests.begin(), tests.end(), [so](auto test) { return test(so); });
+        };
+    }
+    else if (types_to_prune.size() > 0) {
+        prune = [&types_to_prune, &wrap](SerializableObject const* so) {
+            py::gil_scoped_acquire acquire;
+            return bool(py::isinstance(wrap(const_cast<SerializableObject*>(so)), types_to_prune));
+        };
+    }
+
+    // None prunes, a tuple is spliced in, and anything else replaces
+    auto to_filter_result = [](py::object result) {
+        FilterResult out;
+        if (PyTuple_CheckExact(result.ptr())) {
+            for (auto item: result) {
+                out.push_back(item.cast<SerializableObject*>());
+            }
+        }
+        else if (!result.is_none()) {
+            out.push_back(result.cast<SerializableObject*>());
+        }
+        return out;
+    };
+
+    SequenceFilterFunction filter = [&](Composable* previous, SerializableObject* so, Composable* next) {
+        py::gil_scoped_acquire acquire;
+        py::object result = with_sequence_context
+                                ? filter_fn(wrap(previous), wrap(so), wrap(next))
+                                : filter_fn(wrap(so));
+        return to_filter_result(result);
+    };
+
+    FilterResult result;
+    {
+        ErrorStatusHandler error_status;
+        py::gil_scoped_release release;
+        result = with_sequence_context
+                     ? filtered_with_sequence_context(root, filter, prune, error_status)
+                     : filtered_composition(root, [&filter](SerializableObject* so) {
+                           return filter(nullptr, so, nullptr);
+                       }, prune, error_status);
+    }
+
+    if (result.empty()) {
+        return py::none();
+    }
+    if (result.size() == 1) {
+        return wrap(result[0]);
+    }
+    py::tuple out(result.size());
+    for (size_t i = 0; i < result.size(); ++i) {
+        out[i] = wrap(result[i]);
+    }
+    return out;
+}
+
+// Hand the columns of a ClipTable to python as numpy arrays that share its
+// buffers; the table lives on the heap until the last array is released.
+static py::dict clip_table_to_dict(ClipTable&& in_table) {
+    auto table = new ClipTable(std::move(in_table));
+    py::capsule owner(table, [](void* p) { delete static_cast<ClipTable*>(p); });
+
+    auto column = [&owner](auto const& values) {
+        using T = typename std::decay_t<decltype(values)>::value_type;
+        return py::array_t<T>(values.size(), values.data(), owner);
+    };
+
+    py::dict metadata;
+    for (size_t i = 0; i < table->metadata_keys.size(); ++i) {
+        metadata[py::str(table->metadata_keys[i])] = column(table->metadata[i]);
+    }
+
+    py::dict result;
+    result["strings"] = py::cast(table->strings);
+    result["composition_name"] = column(table->composition_name);
+    result["composition_kind"] = column(table->composition_kind);
+    result["composition_parent"] = column(table->composition_parent);
+    result["name"] = column(table->name);
+    result["media_url"] = column(table->media_url);
+    result["trimmed_start"] = column(table->trimmed_start);
+    result["trimmed_duration"] = column(table->trimmed_duration);
+    result["trimmed_rate"] = column(table->trimmed_rate);
+    result["range_in_parent_start"] = column(table->range_in_parent_start);
+    result["range_in_parent_duration"] = column(table->range_in_parent_duration);
+    result["range_in_parent_rate"] = column(table->range_in_parent_rate);
+    result["parent_index"] = column(table->parent_index);
+    result["track_index"] = column(table->track_index);
+    result["metadata"] = metadata;
+    return result;
+}
+
 PYBIND11_MODULE(_otio, m) {
     // Import _opentime before actually creating the bindings
     // for _otio. This allows the import of _otio without
@@ -318,13 +463,285 @@ The CORE_VERSION_MAP maps OTIO release versions to maps of schema name to schema
 :returns: dictionary mapping core version label to schema_version_map
 :rtype: dict[str, dict[str, int]])docstring" 
     );
+    m.def("instrumentation_enabled", &instrumentation_enabled,
+          "Whether the library was built with OTIO_INSTRUMENTATION.");
+    m.def("instrumentation_counters", []() {
+            py::dict counters;
+            for (auto const& counter: instrumentation_counters())
+            {
+                py::dict entry;
+                entry["count"] = counter.count;
+                entry["seconds"] = counter.seconds;
+                counters[py::str(counter.name)] = entry;
+            }
+            return counters;
+        }, R"docstring(
+The counters of the instrumented sites reached so far.
+
+:returns: dictionary mapping each site name to a dictionary with its
+   ``count`` of calls (or amount counted) and the ``seconds`` spent in it
+:rtype: dict[str, dict])docstring");
+    m.def("reset_instrumentation", &reset_instrumentation);
+    m.def("set_instrumentation_tracing", &set_instrumentation_tracing,
+          "enabled"_a);
+    m.def("instrumentation_tracing", &instrumentation_tracing);
+    m.def("instrumentation_trace_json", &instrumentation_trace_json,
+          "The recorded trace events, as Chrome trace event JSON.");
+    m.def("write_instrumentation_trace", [](std::string const& file_name) {
+            write_instrumentation_trace(file_name, ErrorStatusHandler());
+        }, "file_name"_a);
+
+    m.def("memory_footprint", [](SerializableObject* root) {
+            MemoryFootprint const footprint =
+                memory_footprint(root, ErrorStatusHandler());
+            py::dict schemas;
+            for (auto const& e: footprint.schemas)
+            {
+                py::dict schema;
+                schema["objects"] = e.second.objects;
+                schema["bytes"] = e.second.bytes;
+                schemas[py::str(e.first)] = schema;
+            }
+            py::dict result;
+            result["schemas"] = schemas;
+            result["object_count"] = footprint.object_count;
+            result["total_bytes"] = footprint.total_bytes;
+            result["metadata_bytes"] = footprint.metadata_bytes;
+            result["string_bytes"] = footprint.string_bytes;
+            return result;
+        }, "root"_a, R"docstring(
+An estimate of the memory held by ``root`` and everything it holds.
+
+:returns: dictionary with the ``object_count``, ``total_bytes``,
+   ``metadata_bytes`` and ``string_bytes`` of the graph, and under
+   ``schemas`` the ``objects`` and ``bytes`` of each schema
+:rtype: dict)docstring");
+
+    m.def("content_hash", [](SerializableObject* root) {
+            return content_hash(root, ErrorStatusHandler()).to_string();
+        }, "root"_a, R"docstring(
+A 128 bit hash of ``root`` and everything it holds, as 32 hexadecimal digits. Objects that serialize to the same JSON have the same hash.
+
+The hash is kept with each object until the object changes, so hashing again after an edit only revisits what changed.
+)docstring");
+    // the GIL is released while hashing, as for flatten_stack.
+    m.def("content_hashes", [](std::vector<SerializableObject*> roots) {
+            std::vector<ContentHash> hashes;
+            {
+                ErrorStatusHandler error_status;
+                py::gil_scoped_release release;
+                hashes = content_hashes(
+                    std::vector<SerializableObject const*>(roots.begin(), roots.end()),
+                    error_status);
+            }
+            std::vector<std::string> result;
+            for (auto const& hash: hashes)
+            {
+                result.push_back(hash.to_string());
+            }
+            return result;
+        }, "roots"_a, "The :func:`content_hash` of each of ``roots``, computed concurrently.");
+
+    // the GIL is released while flattening so that the worker threads
+    // computing track ranges can run the keepalive monitors; the error
+    // handler is kept outside that scope since raising needs the GIL.
     m.def("flatten_stack", [](Stack* s) {
-            return flatten_stack(s, ErrorStatusHandler());
+            ErrorStatusHandler error_status;
+            py::gil_scoped_release release;
+            return flatten_stack(s, error_status);
         }, "in_stack"_a);
     m.def("flatten_stack", [](std::vector<Track*> tracks) {
-            return flatten_stack(tracks, ErrorStatusHandler());
+            ErrorStatusHandler error_status;
+            py::gil_scoped_release release;
+            return flatten_stack(tracks, error_status);
         }, "tracks"_a);        
+    m.def("flatten_stacks", [](std::vector<Stack*> in_stacks) {
+            ErrorStatusHandler error_status;
+            py::gil_scoped_release release;
+            auto flat_tracks = flatten_stacks(in_stacks, error_status);
+            if (is_error(error_status.error_status)) {
+                for (auto flat_track: flat_tracks) {
+                    if (flat_track) {
+                        flat_track->possibly_delete();
+                    }
+                }
+                flat_tracks.clear();
+            }
+            return flat_tracks;
+        }, "in_stacks"_a, R"docstring(
+Flatten each of ``in_stacks`` concurrently.
+
+Returns a list of flattened tracks, one per stack.
+)docstring");
+
+    m.def("_filtered", &filtered,
+          "root"_a,
+          "filter_fn"_a,
+          "types_to_prune"_a,
+          "with_sequence_context"_a);
+
+    static const char* clip_table_docstring = R"docstring(
+Gather the clips beneath ``root`` into columns in a single traversal.
+
+Returns a dict of numpy arrays that share memory with the table built in
+C++, with one row per clip in the same order as ``find_clips()``:
+
+* ``name``, ``media_url``: indices into ``strings``, or -1 if missing.
+* ``trimmed_start``, ``trimmed_duration``, ``trimmed_rate``: the clip's
+  ``trimmed_range()``, with the start expressed at the duration's rate.
+* ``range_in_parent_start``, ``range_in_parent_duration``,
+  ``range_in_parent_rate``: the clip's ``range_in_parent()``.
+* ``parent_index``, ``track_index``: rows of the composition columns.
+* ``metadata``: a dict mapping each of ``metadata_keys`` to a column of
+  indices into ``strings`` for string values, or -1 otherwise.
+
+The ``composition_name``, ``composition_kind`` and ``composition_parent``
+columns have one row per composition, starting with the root.
+
+The string columns are laid out as Arrow dictionary arrays, so they can be
+wrapped with ``pyarrow.DictionaryArray.from_arrays`` without copying.
+
+Requires numpy.
+)docstring";
+    m.def("clip_table", [](Timeline* timeline, std::vector<std::string> metadata_keys) {
+            ErrorStatusHandler error_status;
+            ClipTable table;
+            {
+                py::gil_scoped_release release;
+                table = clip_table(timeline, metadata_keys, error_status);
+            }
+            return clip_table_to_dict(std::move(table));
+        }, "root"_a, "metadata_keys"_a = std::vector<std::string>(), clip_table_docstring);
+    m.def("clip_table", [](Composition* composition, std::vector<std::string> metadata_keys) {
+            ErrorStatusHandler error_status;
+            ClipTable table;
+            {
+                py::gil_scoped_release release;
+                table = clip_table(composition, metadata_keys, error_status);
+            }
+            return clip_table_to_dict(std::move(table));
+        }, "root"_a, "metadata_keys"_a = std::vector<std::string>());
+
+    // the evaluator holds plain pointers into the composition, which is
+    // kept alive for as long as the evaluator is.
+    py::class_<TimeWarpEvaluator>(m, "TimeWarpEvaluator", R"docstring(
+Maps times in a composition to media times of the clips beneath it.
+
+The parent offsets, trims and :class:`.LinearTimeWarp` /
+:class:`.FreezeFrame` effects between the root and each clip are folded
+into a single :class:`~opentime.TimeTransform` per clip when the evaluator
+is built. Other kinds of :class:`.TimeEffect` cannot be evaluated and
+raise an exception. The evaluator must be rebuilt if the composition
+changes.
+)docstring")
+        .def(py::init([](Timeline* timeline) {
+                    ErrorStatusHandler error_status;
+                    return std::make_unique<TimeWarpEvaluator>(timeline, error_status);
+                }), "root"_a, py::keep_alive<1, 2>())
+        .def(py::init([](Composition* composition) {
+                    ErrorStatusHandler error_status;
+                    return std::make_unique<TimeWarpEvaluator>(composition, error_status);
+                }), "root"_a, py::keep_alive<1, 2>())
+        .def("range_in_root", [](TimeWarpEvaluator const& evaluator, Clip* clip) {
+                auto mapping = evaluator.mapping(clip);
+                return mapping ? std::optional<TimeRange>(mapping->range_in_root) : std::nullopt;
+            }, "clip"_a, "The root times in which ``clip`` is visible, or ``None`` if it is not beneath the root.")
+        .def("transform", [](TimeWarpEvaluator const& evaluator, Clip* clip) {
+                auto mapping = evaluator.mapping(clip);
+                return mapping ? std::optional<TimeTransform>(mapping->transform) : std::nullopt;
+            }, "clip"_a, "The transform from root times to media times of ``clip``, or ``None`` if it is not beneath the root.")
+        .def("source_time", [](TimeWarpEvaluator const& evaluator, Clip* clip, RationalTime root_time) {
+                return evaluator.source_time(clip, root_time);
+            }, "clip"_a, "root_time"_a, "Map ``root_time`` to the media time of ``clip``, or ``None`` if the clip is not visible at that time.")
+        .def("source_frames", [](TimeWarpEvaluator const& evaluator, Clip* clip,
+                                 py::array_t<double, py::array::c_style | py::array::forcecast> root_frames,
+                                 double rate) {
+                size_t count = size_t(root_frames.unchecked<1>().shape(0));
+                py::array_t<double> frames(count);
+                py::array_t<bool> valid(count);
+                double const* root_frames_data = root_frames.data();
+                double* frames_data = frames.mutable_data();
+                uint8_t* valid_data = reinterpret_cast<uint8_t*>(valid.mutable_data());
+                {
+                    py::gil_scoped_release release;
+                    evaluator.source_frames(clip, root_frames_data, count, rate, frames_data, valid_data);
+                }
+                return py::make_tuple(frames, valid);
+            }, "clip"_a, "root_frames"_a, "rate"_a, R"docstring(Array version of :meth:`source_time`, for root frame numbers at ``rate`` given as a numpy array.
+
+Returns a tuple of numpy arrays ``(frames, valid)``, where ``frames`` holds unrounded media frame numbers at the rate of the clip's trimmed range, and ``valid`` is ``False`` where the clip is not visible.
+
+Requires numpy.
+)docstring");
+
+    py::class_<TimelineSnapshotter>(m, "TimelineSnapshotter", R"docstring(
+Hands out read-only copies of a timeline that is being edited.
+
+Asking for a snapshot when the timeline has not changed since the last one returns that snapshot again; otherwise only the tracks that changed are cloned. Snapshots must not be modified.
+)docstring")
+        .def(py::init<Timeline const*>(), "timeline"_a, py::keep_alive<1, 2>())
+        .def("snapshot", [](TimelineSnapshotter& snapshotter) {
+                // the snapshotter keeps the snapshot alive until it is cast.
+                return snapshotter.snapshot(ErrorStatusHandler()).value;
+            }, "A snapshot of the timeline as it is now.");
+
+    py::class_<DeltaSerializer>(m, "DeltaSerializer", R"docstring(
+Saves a document that is being edited as a base followed by patches, each holding only what changed since the save before it.
+
+Use :func:`apply_json_patch` or :func:`compact_json_patches` to put a base and its patches back together.
+)docstring")
+        .def(py::init<SerializableObject const*>(), "root"_a, py::keep_alive<1, 2>())
+        .def("base_json", [](DeltaSerializer& serializer, int indent) {
+                return serializer.base_json(ErrorStatusHandler(), indent);
+            }, "indent"_a = 4, "The whole document, which the patches that follow are relative to.")
+        .def("patch_json", [](DeltaSerializer& serializer, int indent) {
+                return serializer.patch_json(ErrorStatusHandler(), indent);
+            }, "indent"_a = 4, "The changes to the document since the previous base or patch.");
+
+    m.def("apply_json_patch", [](SerializableObject* root, std::string const& patch) {
+            return apply_json_patch(root, patch, ErrorStatusHandler()).take_value();
+        }, "root"_a, "patch"_a, "Apply a patch written by :meth:`DeltaSerializer.patch_json` to ``root``, and return the root of the patched document.");
+    m.def("compact_json_patches", [](std::string const& base, std::vector<std::string> const& patches, int indent) {
+            return compact_json_patches(base, patches, ErrorStatusHandler(), indent);
+        }, "base"_a, "patches"_a, "indent"_a = 4, "The document described by a base and the patches written after it, as a new base.");
+
+    static auto const differences_to_list = [](std::vector<ChildDifference> const& differences) {
+        static char const* const kinds[] = { "inserted", "deleted", "moved", "changed" };
+        py::list result;
+        for (auto const& difference: differences)
+        {
+            py::dict entry;
+            entry["kind"] = kinds[int(difference.kind)];
+            entry["trimmed"] = difference.trimmed;
+            entry["retimed"] = difference.retimed;
+            entry["old_child"] = py::cast(difference.old_child.value, py::return_value_policy::take_ownership);
+            entry["new_child"] = py::cast(difference.new_child.value, py::return_value_policy::take_ownership);
+            entry["old_track"] = difference.old_track;
+            entry["old_index"] = difference.old_index;
+            entry["new_track"] = difference.new_track;
+            entry["new_index"] = difference.new_index;
+            result.append(entry);
+        }
+        return result;
+    };
+    m.def("diff_tracks", [](Composition* old_track, Composition* new_track) {
+            return differences_to_list(diff_tracks(old_track, new_track));
+        }, "old_track"_a, "new_track"_a, R"docstring(
+The differences between the children of two versions of a track, either of which may be ``None``.
+
+Children are aligned by their schema, name and, for clips, media URL. Each difference is a dictionary whose ``kind`` is ``"inserted"``, ``"deleted"``, ``"moved"`` or ``"changed"``, with whether the child was ``trimmed`` or ``retimed``, the ``old_child`` and ``new_child``, and where each sits as ``old_track``, ``old_index``, ``new_track`` and ``new_index`` (``None`` and -1 on the side a child is missing from).
+
+:rtype: list[dict])docstring");
+    // the GIL is released while comparing, as for flatten_stack.
+    m.def("diff_timelines", [](Timeline* old_timeline, Timeline* new_timeline) {
+            std::vector<ChildDifference> differences;
+            {
+                py::gil_scoped_release release;
+                differences = diff_timelines(old_timeline, new_timeline);
+            }
+            return differences_to_list(differences);
+        }, "old_timeline"_a, "new_timeline"_a, R"docstring(
+The differences between the tracks of two versions of a timeline, paired by their index in the stack, as :func:`diff_tracks` describes them. A child moved from one track to another is reported as one move.
 
-    void _build_any_to_py_dispatch_table();
-    _build_any_to_py_dispatch_table();
+:rtype: list[dict])docstring");
 }
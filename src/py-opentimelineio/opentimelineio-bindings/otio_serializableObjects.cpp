@@ -2,6 +2,7 @@
 // Copyright Contributors to the OpenTimelineIO project
 
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/stl.h>
 #include "otio_errorStatusHandler.h"
@@ -99,6 +100,60 @@ namespace {
         }
         return l;
     }
+
+    using ChildPredicate = bool (*)(Composable const*);
+
+    template<typename U>
+    bool is_instance_of(Composable const* child) {
+        return fast_cast<U>(child) != nullptr;
+    }
+
+    // The test for the children of the given type, or null if every child matches.
+    ChildPredicate child_predicate(py::object descended_from_type) {
+        if (descended_from_type.is(py::type::handle_of<Clip>())) return &is_instance_of<Clip>;
+        if (descended_from_type.is(py::type::handle_of<Composition>())) return &is_instance_of<Composition>;
+        if (descended_from_type.is(py::type::handle_of<Gap>())) return &is_instance_of<Gap>;
+        if (descended_from_type.is(py::type::handle_of<Item>())) return &is_instance_of<Item>;
+        if (descended_from_type.is(py::type::handle_of<Stack>())) return &is_instance_of<Stack>;
+        if (descended_from_type.is(py::type::handle_of<Timeline>())) return [](Composable const*) { return false; };
+        if (descended_from_type.is(py::type::handle_of<Track>())) return &is_instance_of<Track>;
+        if (descended_from_type.is(py::type::handle_of<Transition>())) return &is_instance_of<Transition>;
+        return nullptr;
+    }
+
+    // Wrap the matching children of a composition as the search visits them,
+    // rather than collecting retainers to them and converting those afterwards.
+    // (As when returning a pointer, the wrapper retains the child; a child that
+    // already has a wrapper gets that one back.)
+    py::list find_children(Composition const* c, ChildPredicate matches, std::optional<TimeRange> const& search_range, bool shallow_search) {
+        py::list l;
+        c->visit_children([&l, matches](Composable* child) {
+                if (!matches || matches(child)) {
+                    l.append(py::cast(child, py::return_value_policy::take_ownership));
+                }
+                return true;
+            }, ErrorStatusHandler(), search_range, shallow_search);
+        return l;
+    }
+
+    // Wrap the children of a container in [start, stop) with the given step,
+    // as a tuple, in a single call.
+    template<typename CONTAINER, typename ITEM>
+    py::tuple children_slice(CONTAINER* c, int start, int stop, int step) {
+        auto const& children = c->children();
+        std::vector<ITEM> items;
+        for (int i = start; step > 0 ? i < stop : i > stop; i += step) {
+            if (i >= 0 && i < int(children.size())) {
+                items.push_back(children[i].value);
+            }
+        }
+
+        py::tuple result(items.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            result[i] = py::cast(items[i], py::return_value_policy::take_ownership);
+        }
+        return result;
+    }
 }
 
 /*
@@ -129,36 +184,82 @@ static std::string str(AnyDictionary& value) {
 }
 */
 
+// Iterates the children of a container without copying them up front.
+//
+// Children are wrapped a batch at a time, and batches double in size as long
+// as the child list is left alone. If the child about to be returned is no
+// longer the one wrapped for that index, the rest of the batch is dropped and
+// batches start small again, so a loop that edits the child list as it goes
+// sees its changes and costs no more than wrapping one child at a time.
+// Edits to the children themselves (such as reading their metadata) keep the
+// batch.
 template <typename CONTAINER, typename ITEM>
 class ContainerIterator {
 public:
     ContainerIterator(CONTAINER* container)
         : _container(container),
-          _it(0) {
+          _it(0),
+          _batch_index(0),
+          _batch_size(0) {
     }
 
     ContainerIterator* iter() {
         return this;
     }
 
-    ITEM next() {
-        if (_it == _container->children().size()) {
-            throw pybind11::stop_iteration();
+    py::object next() {
+        auto const& children = _container->children();
+        if (_batch_index < _batch.size()
+            && (_it >= children.size()
+                || children[_it].value != _batch[_batch_index].first)) {
+            _batch.clear();
+            _batch_index = 0;
+            _batch_size = 0;
         }
 
-        return _container->children()[_it++];
+        if (_batch_index == _batch.size()) {
+            _fill_batch();
+            if (_batch.empty()) {
+                throw pybind11::stop_iteration();
+            }
+        }
+
+        _it++;
+        return _batch[_batch_index++].second;
     }
 
 private:
+    static constexpr size_t _max_batch_size = 256;
+
+    void _fill_batch() {
+        auto const& children = _container->children();
+        _batch_size = std::min(std::max(_batch_size * 2, size_t(1)), _max_batch_size);
+        size_t end = std::min(_it + _batch_size, children.size());
+
+        _batch.clear();
+        _batch_index = 0;
+        for (size_t i = _it; i < end; ++i) {
+            ITEM child = static_cast<ITEM>(children[i].value);
+            _batch.emplace_back(child,
+                                py::cast(child, py::return_value_policy::take_ownership));
+        }
+    }
+
     CONTAINER* _container;
     size_t _it;
+
+    // Each child wrapped, with its wrapper, which keeps it alive (and so at
+    // the same address) while it is in the batch.
+    std::vector<std::pair<SerializableObject const*, py::object>> _batch;
+    size_t _batch_index;
+    size_t _batch_size;
 };
 
 static void define_bases1(py::module m) {
     py::class_<SerializableObject, managing_ptr<SerializableObject>>(m, "SerializableObject", py::dynamic_attr(), "Superclass for all classes whose instances can be serialized.")
         .def(py::init<>())
         .def_property_readonly("_dynamic_fields", [](SerializableObject* s) {
-                auto ptr = s->dynamic_fields().get_or_create_mutation_stamp();
+                auto ptr = s->lend_dynamic_fields();
                 return (AnyDictionaryProxy*)(ptr); }, py::return_value_policy::take_ownership)
         .def("is_equivalent_to", &SerializableObject::is_equivalent_to, "other"_a.none(false))
         .def("clone", [](SerializableObject* so) {
@@ -179,7 +280,36 @@ static void define_bases1(py::module m) {
             "input"_a)
         .def("schema_name", &SerializableObject::schema_name)
         .def("schema_version", &SerializableObject::schema_version)
-        .def_property_readonly("is_unknown_schema", &SerializableObject::is_unknown_schema);
+        .def_property_readonly("is_unknown_schema", &SerializableObject::is_unknown_schema)
+        .def_property_readonly("generation", &SerializableObject::generation, R"docstring(
+A number that increases whenever this object, or anything it contains, is modified.
+
+Generations are unique across all objects, so a cache can remember the generation it was computed from and compare it later.
+)docstring")
+        .def("add_change_observer", [](SerializableObject* so, py::function observer) {
+                // the observer may be called, copied and destroyed on threads
+                // that don't hold the GIL.
+                std::shared_ptr<py::function> callback(
+                    new py::function(std::move(observer)),
+                    [](py::function* f) {
+                        py::gil_scoped_acquire acquire;
+                        delete f;
+                    });
+                return so->add_change_observer([callback](SerializableObject* changed) {
+                        py::gil_scoped_acquire acquire;
+                        try {
+                            (*callback)(py::cast(changed, py::return_value_policy::take_ownership));
+                        }
+                        catch (py::error_already_set& e) {
+                            e.discard_as_unraisable("change observer");
+                        }
+                    });
+            }, "observer"_a, R"docstring(
+Call ``observer(changed)`` whenever this object, or anything it contains, is modified, where ``changed`` is the object that was modified.
+
+Returns an id for :meth:`remove_change_observer`. Exceptions raised by the observer are reported as unraisable and otherwise ignored.
+)docstring")
+        .def("remove_change_observer", &SerializableObject::remove_change_observer, "observer_id"_a);
 
     py::class_<UnknownSchema, SerializableObject, managing_ptr<UnknownSchema>>(m, "UnknownSchema")
         .def_property_readonly("original_schema_name", &UnknownSchema::original_schema_name)
@@ -193,7 +323,7 @@ static void define_bases1(py::module m) {
             py::arg_v("name"_a = std::string()),
             py::arg_v("metadata"_a = py::none()))
         .def_property_readonly("metadata", [](SOWithMetadata* s) {
-                auto ptr = s->metadata().get_or_create_mutation_stamp();
+                auto ptr = s->lend_metadata();
             return (AnyDictionaryProxy*)(ptr); }, py::return_value_policy::take_ownership)
         .def_property("name", [](SOWithMetadata* so) {
                 return plain_string(so->name());
@@ -276,6 +406,9 @@ A :class:`~SerializableCollection` is useful for serializing multiple timelines,
                 }
                 return c->children()[index].value;
             }, "index"_a)
+        .def("__internal_getslice__", [](SerializableCollection* c, int start, int stop, int step) {
+                return children_slice<SerializableCollection, SerializableObject*>(c, start, stop, step);
+            }, "start"_a, "stop"_a, "step"_a)
         .def("__internal_setitem__", [](SerializableCollection* c, int index, SerializableObject* item) {
                 index = adjusted_vector_index(index, c->children());
                 c->set_child(index, item, ErrorStatusHandler());
@@ -511,7 +644,7 @@ Should be subclassed (for example by :class:`.Track` and :class:`.Stack`), not u
                 return l;
             }, "search_range"_a)
         .def("find_children", [](Composition* c, py::object descended_from_type, std::optional<TimeRange> const& search_range, bool shallow_search) {
-                return find_children(c, descended_from_type, search_range, shallow_search);
+                return find_children(c, child_predicate(descended_from_type), search_range, shallow_search);
             }, "descended_from_type"_a = py::none(), "search_range"_a = std::nullopt, "shallow_search"_a = false)
         .def("handles_of_child", [](Composition* c, Composable* child) {
                 auto result = c->handles_of_child(child, ErrorStatusHandler());
@@ -525,6 +658,9 @@ Should be subclassed (for example by :class:`.Track` and :class:`.Stack`), not u
                 }
                 return c->children()[index].value;
             }, "index"_a)
+        .def("__internal_getslice__", [](Composition* c, int start, int stop, int step) {
+                return children_slice<Composition, Composable*>(c, start, stop, step);
+            }, "start"_a, "stop"_a, "step"_a)
         .def("__internal_setitem__", [](Composition* c, int index, Composable* composable) {
                 index = adjusted_vector_index(index, c->children());
                 c->set_child(index, composable, ErrorStatusHandler());
@@ -588,7 +724,7 @@ Should be subclassed (for example by :class:`.Track` and :class:`.Stack`), not u
                 return py::make_tuple(py::cast(result.first.take_value()), py::cast(result.second.take_value()));
             }, "item"_a, "policy"_a = Track::NeighborGapPolicy::never)
         .def("find_clips", [](Track* t, std::optional<TimeRange> const& search_range, bool shallow_search) {
-                return find_clips(t, search_range, shallow_search);
+                return find_children(t, &is_instance_of<Clip>, search_range, shallow_search);
             }, "search_range"_a = std::nullopt, "shallow_search"_a = false);
 
     py::class_<Track::Kind>(track_class, "Kind")
@@ -623,7 +759,7 @@ Should be subclassed (for example by :class:`.Track` and :class:`.Stack`), not u
              "effects"_a = py::none(),
              py::arg_v("metadata"_a = py::none()))
         .def("find_clips", [](Stack* s, std::optional<TimeRange> const& search_range, bool shallow_search) {
-                return find_clips(s, search_range, shallow_search);
+                return find_children(s, &is_instance_of<Clip>, search_range, shallow_search);
             }, "search_range"_a = std::nullopt, "shallow_search"_a = false);
 
     py::class_<Timeline, SerializableObjectWithMetadata, managing_ptr<Timeline>>(m, "Timeline", py::dynamic_attr())
@@ -653,10 +789,10 @@ Should be subclassed (for example by :class:`.Track` and :class:`.Stack`), not u
         .def("video_tracks", &Timeline::video_tracks)
         .def("audio_tracks", &Timeline::audio_tracks)
         .def("find_clips", [](Timeline* t, std::optional<TimeRange> const& search_range, bool shallow_search) {
-                return find_clips(t, search_range, shallow_search);
+                return find_children(t->tracks(), &is_instance_of<Clip>, search_range, shallow_search);
             }, "search_range"_a = std::nullopt, "shallow_search"_a = false)
         .def("find_children", [](Timeline* t, py::object descended_from_type, std::optional<TimeRange> const& search_range, bool shallow_search) {
-                return find_children(t, descended_from_type, search_range, shallow_search);
+                return find_children(t->tracks(), child_predicate(descended_from_type), search_range, shallow_search);
             }, "descended_from_type"_a = py::none(), "search_range"_a = std::nullopt, "shallow_search"_a = false);
 }
 
@@ -922,13 +1058,92 @@ This is roughly equivalent to:
 
    f"{target_url_prefix}{(start_frame + (image_number * frame_step)):0{value_zero_padding}}{target_url_postfix}"
 
+)docstring")
+        .def("target_urls_for_image_range", [](ImageSequenceReference *seq_ref, int start_image_number, std::optional<int> image_count) {
+                ImageSequenceReference::URLList urls;
+                {
+                    ErrorStatusHandler error_status;
+                    urls = seq_ref->target_urls_for_image_range(
+                            start_image_number,
+                            image_count ? *image_count : seq_ref->number_of_images_in_sequence() - start_image_number,
+                            error_status
+                    );
+                }
+
+                // build the strings straight out of the packed buffer
+                py::list result(urls.size());
+                for (size_t i = 0; i < urls.size(); i++) {
+                    auto url = urls[i];
+                    PyList_SET_ITEM(result.ptr(), i, py::str(url.data(), url.size()).release().ptr());
+                }
+                return result;
+        }, "start_image_number"_a = 0, "image_count"_a = std::nullopt, R"docstring(Returns the ``target_url`` of ``image_count`` images starting at ``start_image_number``, or of every image from ``start_image_number`` on if ``image_count`` is not given.
+
+This is equivalent to calling :meth:`target_url_for_image_number` for each image, but much faster for long sequences.
 )docstring")
         .def("presentation_time_for_image_number", [](ImageSequenceReference *seq_ref, int image_number) {
                 return seq_ref->presentation_time_for_image_number(
                         image_number,
                         ErrorStatusHandler()
                 );
-        }, "image_number"_a, "Given an image number, returns the :class:`.RationalTime` at which that image should be shown in the space of :attr:`.available_range`.");
+        }, "image_number"_a, "Given an image number, returns the :class:`.RationalTime` at which that image should be shown in the space of :attr:`.available_range`.")
+        .def("frames_for_times", [](ImageSequenceReference *seq_ref,
+                                    py::array_t<double, py::array::c_style | py::array::forcecast> time_values,
+                                    double rate) {
+                auto values = time_values.unchecked<1>();
+                size_t count = size_t(values.shape(0));
+                py::array_t<int> frames(count);
+                py::array_t<bool> valid(count);
+                int* frames_data = frames.mutable_data();
+                uint8_t* valid_data = reinterpret_cast<uint8_t*>(valid.mutable_data());
+                {
+                    py::gil_scoped_release release;
+                    std::vector<RationalTime> times;
+                    times.reserve(count);
+                    for (size_t i = 0; i < count; i++) {
+                        times.emplace_back(values(i), rate);
+                    }
+                    seq_ref->frames_for_times(times.data(), count, frames_data, valid_data);
+                }
+                return py::make_tuple(frames, valid);
+        }, "time_values"_a, "rate"_a, R"docstring(Array version of :meth:`frame_for_time`, for times given as a numpy array of values at ``rate``.
+
+Returns a tuple of numpy arrays ``(frames, valid)``. ``valid`` is ``False`` for times that fall outside of :attr:`.available_range`, unless :attr:`missing_frame_policy` is ``hold``, in which case those times are mapped to the first or last frame instead.
+
+Requires numpy.
+)docstring")
+        .def("presentation_times_for_image_numbers", [](ImageSequenceReference *seq_ref,
+                                                        py::array_t<int, py::array::c_style | py::array::forcecast> image_numbers) {
+                size_t count = size_t(image_numbers.unchecked<1>().shape(0));
+                py::array_t<double> time_values(count);
+                py::array_t<bool> valid(count);
+                int const* image_numbers_data = image_numbers.data();
+                double* time_values_data = time_values.mutable_data();
+                uint8_t* valid_data = reinterpret_cast<uint8_t*>(valid.mutable_data());
+                double rate = seq_ref->rate();
+                {
+                    py::gil_scoped_release release;
+                    std::vector<RationalTime> times(count);
+                    if (seq_ref->presentation_times_for_image_numbers(image_numbers_data, count, times.data(), valid_data)) {
+                        // every valid time comes out at the same rate
+                        for (size_t i = 0; i < count; i++) {
+                            if (valid_data[i]) {
+                                rate = times[i].rate();
+                                break;
+                            }
+                        }
+                    }
+                    for (size_t i = 0; i < count; i++) {
+                        time_values_data[i] = times[i].value_rescaled_to(rate);
+                    }
+                }
+                return py::make_tuple(time_values, rate, valid);
+        }, "image_numbers"_a, R"docstring(Array version of :meth:`presentation_time_for_image_number`, for image numbers given as a numpy array.
+
+Returns a tuple ``(time_values, rate, valid)``, where ``time_values`` is a numpy array of time values at ``rate``. ``valid`` is ``False`` for image numbers past the end of the sequence, unless :attr:`missing_frame_policy` is ``hold``, in which case the last image's time is used instead.
+
+Requires numpy.
+)docstring");
 
 }
 
@@ -13,7 +13,6 @@
 
 #include <Imath/ImathBox.h>
 
-#include <map>
 #include <cstring>
 
 namespace py = pybind11;
@@ -22,9 +21,6 @@ bool compare_typeids(std::type_info const& lhs, std::type_info const& rhs) {
     return lhs.name() == rhs.name() || !strcmp(lhs.name(), rhs.name());
 }
 
-static std::map<std::type_info const*, std::function<py::object (std::any const&, bool)>> _py_cast_dispatch_table;
-static std::map<std::string, std::function<py::object (std::any const&, bool)>> _py_cast_dispatch_table_by_name;
-
 py::object plain_string(std::string const& s) {
     #if PY_MAJOR_VERSION >= 3
         PyObject *p = PyUnicode_FromString(s.c_str());
@@ -49,54 +45,6 @@ py::object plain_uint(uint64_t i) {
     return py::reinterpret_steal<py::object>(p);
 }
 
-void _build_any_to_py_dispatch_table() {
-    auto& t = _py_cast_dispatch_table;
-
-    t[&typeid(void)] = [](std::any const& /* a */, bool) { return py::none(); };
-    t[&typeid(bool)] = [](std::any const& a, bool) { return py::cast(safely_cast_bool_any(a)); };
-    t[&typeid(int)] = [](std::any const& a, bool) {  return plain_int(safely_cast_int_any(a)); };
-    t[&typeid(int64_t)] = [](std::any const& a, bool) {  return plain_int(safely_cast_int64_any(a)); };
-    t[&typeid(uint64_t)] = [](std::any const& a, bool) {  return plain_uint(safely_cast_uint64_any(a)); };
-    t[&typeid(double)] = [](std::any const& a, bool) { return py::cast(safely_cast_double_any(a)); };
-    t[&typeid(std::string)] = [](std::any const& a, bool) { return py::cast(safely_cast_string_any(a)); };
-    t[&typeid(RationalTime)] = [](std::any const& a, bool) { return py::cast(safely_cast_rational_time_any(a)); };
-    t[&typeid(TimeRange)] = [](std::any const& a, bool) { return py::cast(safely_cast_time_range_any(a)); };
-    t[&typeid(TimeTransform)] = [](std::any const& a, bool) { return py::cast(safely_cast_time_transform_any(a)); };
-    t[&typeid(IMATH_NAMESPACE::V2d)] = [](std::any const& a, bool) { return py::cast(safely_cast_point_any(a)); };
-    t[&typeid(IMATH_NAMESPACE::Box2d)] = [](std::any const& a, bool) { return py::cast(safely_cast_box_any(a)); };
-    t[&typeid(SerializableObject::Retainer<>)] = [](std::any const& a, bool) {
-        SerializableObject* so = safely_cast_retainer_any(a);
-        return py::cast(managing_ptr<SerializableObject>(so)); };
-    t[&typeid(AnyDictionaryProxy*)] = [](std::any const& a, bool) { return py::cast(std::any_cast<AnyDictionaryProxy*>(a)); };
-    t[&typeid(AnyVectorProxy*)] = [](std::any const& a, bool) { return py::cast(std::any_cast<AnyVectorProxy*>(a)); };
-
-    t[&typeid(AnyDictionary)] = [](std::any const& a, bool top_level) {
-        AnyDictionary& d = temp_safely_cast_any_dictionary_any(a);
-        if (top_level) {
-            auto proxy = new AnyDictionaryProxy;
-            proxy->fetch_any_dictionary().swap(d);
-            return py::cast(proxy);
-        }
-        else {
-            return py::cast((AnyDictionaryProxy*)d.get_or_create_mutation_stamp());
-        }
-    };
-    
-    t[&typeid(AnyVector)] = [](std::any const& a, bool top_level) {
-        AnyVector& v = temp_safely_cast_any_vector_any(a);
-        if (top_level) {
-            auto proxy = new AnyVectorProxy;
-            proxy->fetch_any_vector().swap(v);
-            return py::cast(proxy);
-        }
-        return py::cast((AnyVectorProxy*)v.get_or_create_mutation_stamp());
-    };
-
-    for (auto e: t) {
-        _py_cast_dispatch_table_by_name[e.first->name()] = e.second;
-    }
-}
-
 static py::object _value_to_any = py::none();
 
 static void py_to_any(py::object const& o, std::any* result) {
@@ -124,23 +72,68 @@ AnyDictionary py_to_any_dictionary(py::object const& o) {
 }
 
 py::object any_to_py(std::any const& a, bool top_level) {
-    std::type_info const& tInfo = a.type();
-    auto e = _py_cast_dispatch_table.find(&tInfo);
-
-    if (e == _py_cast_dispatch_table.end()) {
-        auto backup_e = _py_cast_dispatch_table_by_name.find(tInfo.name());
-        if (backup_e != _py_cast_dispatch_table_by_name.end()) {
-            _py_cast_dispatch_table[&tInfo] = backup_e->second;
-            e = _py_cast_dispatch_table.find(&tInfo);
+    switch (any_kind(a)) {
+    case AnyKind::empty:
+        return py::none();
+    case AnyKind::bool_value:
+        return py::cast(safely_cast_bool_any(a));
+    case AnyKind::int_value:
+        return plain_int(safely_cast_int_any(a));
+    case AnyKind::int64_value:
+        return plain_int(safely_cast_int64_any(a));
+    case AnyKind::uint64_value:
+        return plain_uint(safely_cast_uint64_any(a));
+    case AnyKind::double_value:
+        return py::cast(safely_cast_double_any(a));
+    case AnyKind::string:
+        return py::cast(safely_cast_string_any(a));
+    case AnyKind::rational_time:
+        return py::cast(safely_cast_rational_time_any(a));
+    case AnyKind::time_range:
+        return py::cast(safely_cast_time_range_any(a));
+    case AnyKind::time_transform:
+        return py::cast(safely_cast_time_transform_any(a));
+    case AnyKind::point:
+        return py::cast(safely_cast_point_any(a));
+    case AnyKind::box:
+        return py::cast(safely_cast_box_any(a));
+    case AnyKind::retainer: {
+        SerializableObject* so = safely_cast_retainer_any(a);
+        return py::cast(managing_ptr<SerializableObject>(so));
+    }
+    case AnyKind::any_dictionary: {
+        AnyDictionary& d = temp_safely_cast_any_dictionary_any(a);
+        if (top_level) {
+            auto proxy = new AnyDictionaryProxy;
+            proxy->fetch_any_dictionary().swap(d);
+            return py::cast(proxy);
         }
+        return py::cast((AnyDictionaryProxy*)d.get_or_create_mutation_stamp());
+    }
+    case AnyKind::any_vector: {
+        AnyVector& v = temp_safely_cast_any_vector_any(a);
+        if (top_level) {
+            auto proxy = new AnyVectorProxy;
+            proxy->fetch_any_vector().swap(v);
+            return py::cast(proxy);
+        }
+        return py::cast((AnyVectorProxy*)v.get_or_create_mutation_stamp());
+    }
+    default:
+        break;
     }
 
-    if (e == _py_cast_dispatch_table.end()) {
-        throw py::value_error(string_printf("Unable to cast any of type %s to python object",
-                                            type_name_for_error_message(tInfo).c_str()));
+    // the proxies are only ever put in an any by these bindings
+    std::type_info const& tInfo = a.type();
+    if (compare_typeids(tInfo, typeid(AnyDictionaryProxy*))) {
+        return py::cast(std::any_cast<AnyDictionaryProxy*>(a));
+    }
+    if (compare_typeids(tInfo, typeid(AnyVectorProxy*))) {
+        return py::cast(std::any_cast<AnyVectorProxy*>(a));
     }
 
-    return e->second(a, top_level);
+    throw py::value_error(string_printf("Unable to cast any of type %s to python object",
+                                        type_name_for_error_message(tInfo).c_str()));
 }
 
 struct KeepaliveMonitor {
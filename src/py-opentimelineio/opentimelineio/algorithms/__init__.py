@@ -11,6 +11,7 @@ from .track_algo import (
 
 from .stack_algo import (
     flatten_stack,
+    flatten_stacks,
     top_clip_at_time,
 )
 
@@ -19,5 +20,8 @@ from .filter import (
     filtered_with_sequence_context
 )
 from .timeline_algo import (
-    timeline_trimmed_to_range
+    clip_table,
+    timeline_trimmed_to_range,
+    TimelineSnapshotter,
+    TimeWarpEvaluator
 )
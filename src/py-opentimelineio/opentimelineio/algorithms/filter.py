@@ -3,28 +3,18 @@
 
 """Algorithms for filtering OTIO files.  """
 
-import copy
-
 from .. import (
-    schema
+    _otio,
 )
 
 
-def _is_in(thing, container):
-    return any(thing is item for item in container)
-
-
-def _isinstance_in(child, typelist):
-    return any(isinstance(child, t) for t in typelist)
-
-
 def filtered_composition(
     root,
     unary_filter_fn,
     types_to_prune=None,
 ):
     """
-    Filter a deep copy of root (and children) with ``unary_filter_fn``.
+    Filter a copy of root (and children) with ``unary_filter_fn``.
 
     The ``unary_filter_fn`` must have this signature:
 
@@ -32,19 +22,23 @@ def filtered_composition(
         :noindex:
 
 
-    1. Make a deep copy of root
-    2. Starting with root, perform a depth first traversal
-    3. For each item (including root):
+    1. Starting with root, perform a depth first traversal
+    2. For each item (including root):
 
        a. If ``types_to_prune`` is not None and item is an instance of a type in
           ``types_to_prune``, prune it from the copy, continue.
-       b. Otherwise, pass the copy to ``unary_filter_fn``.  If ``unary_filter_fn``:
+       b. Otherwise, pass a copy of the item to ``unary_filter_fn``.  If
+          ``unary_filter_fn``:
 
           I.   Returns an object: add it to the copy, replacing original
           II.  Returns a tuple: insert it into the list, replacing original
           III. Returns None: prune it
-    4. If an item is pruned, do not traverse its children
-    5. Return the new deep copy.
+    3. If an item is pruned, do not traverse its children
+    4. Return the new copy.
+
+    A composition (or the tracks of a timeline) is passed to
+    ``unary_filter_fn`` with copies of its direct children, which are
+    filtered afterwards.
 
     Example 1 (filter)::
 
@@ -92,57 +86,12 @@ def filtered_composition(
     :param tuple(type) types_to_prune: Types to prune. Example: (otio.schema.Gap,...)
     """
 
-    # deep copy everything
-    mutable_object = copy.deepcopy(root)
-
-    prune_list = set()
-
-    header_list = [mutable_object]
-
-    if isinstance(mutable_object, schema.Timeline):
-        header_list.append(mutable_object.tracks)
-
-    iter_list = header_list + list(mutable_object.find_children())
-
-    for child in iter_list:
-        if _safe_parent(child) is not None and _is_in(child.parent(), prune_list):
-            prune_list.add(child)
-            continue
-
-        parent = None
-        child_index = None
-        if _safe_parent(child) is not None:
-            child_index = child.parent().index(child)
-            parent = child.parent()
-            del child.parent()[child_index]
-
-        # first try to prune
-        if (types_to_prune and _isinstance_in(child, types_to_prune)):
-            result = None
-        # finally call the user function
-        else:
-            result = unary_filter_fn(child)
-
-        if child is mutable_object:
-            mutable_object = result
-
-        if result is None:
-            prune_list.add(child)
-            continue
-
-        if type(result) is not tuple:
-            result = [result]
-
-        if parent is not None:
-            parent[child_index:child_index] = result
-
-    return mutable_object
-
-
-def _safe_parent(child):
-    if hasattr(child, 'parent'):
-        return child.parent()
-    return None
+    return _otio._filtered(
+        root,
+        unary_filter_fn,
+        tuple(types_to_prune or ()),
+        False
+    )
 
 
 def filtered_with_sequence_context(
@@ -150,7 +99,7 @@ def filtered_with_sequence_context(
     reduce_fn,
     types_to_prune=None,
 ):
-    """Filter a deep copy of root (and children) with ``reduce_fn``.
+    """Filter a copy of root (and children) with ``reduce_fn``.
 
     The ``reduce_fn`` must have this signature:
 
@@ -159,9 +108,8 @@ def filtered_with_sequence_context(
     .. py:function:: func(previous_item: typing.Any, current: typing.Any, next_item: typing.Any) -> list[typing.Any]  # noqa
         :noindex:
 
-    1. Make a deep copy of root
-    2. Starting with root, perform a depth first traversal
-    3. For each item (including root):
+    1. Starting with root, perform a depth first traversal
+    2. For each item (including root):
 
        a. if types_to_prune is not None and item is an instance of a type
           in types_to_prune, prune it from the copy, continue.
@@ -171,11 +119,11 @@ def filtered_with_sequence_context(
           II.  returns a tuple: insert it into the list, replacing original
           III. returns None: prune it
 
-          .. note:: ``reduce_fn`` is always passed objects from the original
-                    deep copy, not what prior calls return. See below for examples
+          .. note:: ``reduce_fn`` is always passed copies of the original
+                    items, not what prior calls return. See below for examples
 
-    4. If an item is pruned, do not traverse its children
-    5. Return the new deep copy.
+    3. If an item is pruned, do not traverse its children
+    4. Return the new copy.
 
     Example 1 (filter)::
 
@@ -226,60 +174,9 @@ def filtered_with_sequence_context(
     :param tuple(type) types_to_prune: Types to prune. Example: (otio.schema.Gap,...)
     """
 
-    # deep copy everything
-    mutable_object = copy.deepcopy(root)
-
-    prune_list = set()
-
-    header_list = [mutable_object]
-
-    if isinstance(mutable_object, schema.Timeline):
-        header_list.append(mutable_object.tracks)
-
-    iter_list = header_list + list(mutable_object.find_children())
-
-    # expand to include prev, next when appropriate
-    expanded_iter_list = []
-    for child in iter_list:
-        if _safe_parent(child) and isinstance(child.parent(), schema.Track):
-            prev_item, next_item = child.parent().neighbors_of(child)
-            expanded_iter_list.append((prev_item, child, next_item))
-        else:
-            expanded_iter_list.append((None, child, None))
-
-    def _safe_name(x):
-        return x.name if x else "<NONE>"
-
-    for prev_item, child, next_item in expanded_iter_list:
-        if _safe_parent(child) is not None and _is_in(child.parent(), prune_list):
-            prune_list.add(child)
-            continue
-
-        parent = None
-        child_index = None
-        if _safe_parent(child) is not None:
-            child_index = child.parent().index(child)
-            parent = child.parent()
-            del child.parent()[child_index]
-
-        # first try to prune
-        if types_to_prune and _isinstance_in(child, types_to_prune):
-            result = None
-        # finally call the user function
-        else:
-            result = reduce_fn(prev_item, child, next_item)
-
-        if child is mutable_object:
-            mutable_object = result
-
-        if result is None:
-            prune_list.add(child)
-            continue
-
-        if type(result) is not tuple:
-            result = [result]
-
-        if parent is not None:
-            parent[child_index:child_index] = result
-
-    return mutable_object
+    return _otio._filtered(
+        root,
+        reduce_fn,
+        tuple(types_to_prune or ()),
+        True
+    )
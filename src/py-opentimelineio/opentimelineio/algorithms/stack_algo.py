@@ -64,3 +64,4 @@ def top_clip_at_time(in_stack, t):
 
 
 flatten_stack = _otio.flatten_stack
+flatten_stacks = _otio.flatten_stacks
@@ -8,6 +8,7 @@ import copy
 from . import (
     track_algo
 )
+from .. import _otio
 
 
 def timeline_trimmed_to_range(in_timeline, trim_range):
@@ -43,3 +44,8 @@ def timeline_trimmed_to_range(in_timeline, trim_range):
         )
 
     return new_timeline
+
+
+clip_table = _otio.clip_table
+TimeWarpEvaluator = _otio.TimeWarpEvaluator
+TimelineSnapshotter = _otio.TimelineSnapshotter
@@ -221,6 +221,9 @@ def _add_mutable_sequence_methods(
     def __getitem__(self, index):
         if isinstance(index, slice):
             indices = index.indices(len(self))
+            if hasattr(self, "__internal_getslice__"):
+                # wraps the whole slice in one call
+                return list(self.__internal_getslice__(*indices))
             return [self.__internal_getitem__(i) for i in range(*indices)]
         else:
             return self.__internal_getitem__(index)
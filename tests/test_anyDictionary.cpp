@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "utils.h"
+
+#include <opentimelineio/anyDictionary.h>
+#include <opentimelineio/anyVector.h>
+#include <opentimelineio/clip.h>
+#include <opentimelineio/flatMap.h>
+#include <opentimelineio/safely_typed_any.h>
+#include <opentimelineio/sharedAnyDictionary.h>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
+
+namespace {
+
+std::vector<std::string>
+keys_of(otio::AnyDictionary const& dictionary)
+{
+    std::vector<std::string> keys;
+    for (auto const& entry: dictionary)
+    {
+        keys.push_back(entry.first);
+    }
+    return keys;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Tests tests;
+
+    tests.add_test("test_move_construct", [] {
+        otio::AnyDictionary::MutationStamp* stamp = nullptr;
+        {
+            otio::AnyDictionary source;
+            source["a"] = std::string("a");
+            source["b"] = 1.0;
+            stamp         = source.get_or_create_mutation_stamp();
+            int64_t start = stamp->stamp;
+
+            otio::AnyDictionary destination(std::move(source));
+            assertEqual(
+                keys_of(destination),
+                (std::vector<std::string>{ "a", "b" }));
+            assertTrue(source.empty());
+            assertNotEqual(stamp->stamp, start);
+            assertEqual(stamp->any_dictionary, &source);
+        }
+
+        // the stamp outlives the dictionary, as a Python iterator may
+        assertEqual(stamp->stamp, int64_t(-1));
+        delete stamp;
+    });
+
+    tests.add_test("test_move_assign", [] {
+        otio::AnyDictionary source;
+        source["a"] = std::string("a");
+        otio::AnyDictionary destination;
+        destination["b"] = std::string("b");
+
+        auto    source_stamp      = source.get_or_create_mutation_stamp();
+        auto    destination_stamp = destination.get_or_create_mutation_stamp();
+        int64_t source_start      = source_stamp->stamp;
+        int64_t destination_start = destination_stamp->stamp;
+
+        destination = std::move(source);
+        assertEqual(keys_of(destination), (std::vector<std::string>{ "a" }));
+        assertNotEqual(source_stamp->stamp, source_start);
+        assertNotEqual(destination_stamp->stamp, destination_start);
+        delete source_stamp;
+        delete destination_stamp;
+    });
+
+    tests.add_test("test_key_order", [] {
+        otio::AnyDictionary dictionary;
+        dictionary["c"] = 3.0;
+        dictionary.emplace("a", 1.0);
+        dictionary.insert({ "b", 2.0 });
+        dictionary.insert({ "a", 4.0 });
+        assertEqual(
+            keys_of(dictionary),
+            (std::vector<std::string>{ "a", "b", "c" }));
+        assertEqual(std::any_cast<double>(dictionary.at("a")), 1.0);
+        assertEqual(dictionary.lower_bound("bb")->first, std::string("c"));
+
+        dictionary.erase("b");
+        assertEqual(
+            keys_of(dictionary),
+            (std::vector<std::string>{ "a", "c" }));
+        assertFalse(dictionary.has_key("b"));
+    });
+
+    tests.add_test("test_insert_stamp", [] {
+        otio::AnyDictionary dictionary;
+        dictionary["a"] = 1.0;
+        auto    stamp = dictionary.get_or_create_mutation_stamp();
+        int64_t start = stamp->stamp;
+
+        // assigning to an existing key never invalidates iterators
+        dictionary["a"] = 2.0;
+        assertEqual(stamp->stamp, start);
+
+        dictionary.emplace("b", 1.0);
+#ifdef OTIO_FLAT_ANY_DICTIONARY
+        assertNotEqual(stamp->stamp, start);
+#else
+        assertEqual(stamp->stamp, start);
+#endif
+        delete stamp;
+    });
+
+    tests.add_test("test_flat_map", [] {
+        using Map = otio::FlatMap<std::string, int>;
+        Map map{ { "b", 2 }, { "a", 1 }, { "b", 3 } };
+        assertEqual(map.size(), size_t(2));
+        assertEqual(map.at("b"), 2);
+        assertEqual(map.begin()->first, std::string("a"));
+
+        // a right hint and a wrong one both end up in order
+        map.emplace_hint(map.end(), "c", 3);
+        map.emplace_hint(map.begin(), "bb", 4);
+        std::vector<std::string> keys;
+        for (auto const& entry: map)
+        {
+            keys.push_back(entry.first);
+        }
+        assertEqual(keys, (std::vector<std::string>{ "a", "b", "bb", "c" }));
+        assertEqual(map.count("bb"), size_t(1));
+        assertEqual(map.upper_bound("b")->first, std::string("bb"));
+
+        map["d"] = 5;
+        assertEqual(map.rbegin()->second, 5);
+        assertEqual(map.erase("zz"), size_t(0));
+
+        bool thrown = false;
+        try
+        {
+            map.at("zz");
+        }
+        catch (std::out_of_range const&)
+        {
+            thrown = true;
+        }
+        assertTrue(thrown);
+
+        Map moved(std::move(map));
+        assertEqual(moved.size(), size_t(5));
+        assertTrue(map.empty());
+    });
+
+    tests.add_test("test_any_kind", [] {
+        using otio::AnyKind;
+        assertTrue(otio::any_kind(std::any()) == AnyKind::empty);
+        assertTrue(otio::any_kind(std::any(true)) == AnyKind::bool_value);
+        assertTrue(
+            otio::any_kind(std::any(int64_t(1))) == AnyKind::int64_value);
+        assertTrue(otio::any_kind(std::any(1.5)) == AnyKind::double_value);
+        assertTrue(
+            otio::any_kind(std::any(std::string("a"))) == AnyKind::string);
+        assertTrue(
+            otio::any_kind(std::any(otio::RationalTime()))
+            == AnyKind::rational_time);
+        assertTrue(
+            otio::any_kind(std::any(otio::AnyDictionary()))
+            == AnyKind::any_dictionary);
+        assertTrue(
+            otio::any_kind(std::any(otio::AnyVector())) == AnyKind::any_vector);
+        assertTrue(
+            otio::any_kind(otio::create_safely_typed_any(new otio::Clip))
+            == AnyKind::retainer);
+        assertTrue(otio::any_kind(std::any(1.5f)) == AnyKind::other);
+    });
+
+    tests.add_test("test_shared_any_dictionary", [] {
+        otio::AnyDictionary dictionary;
+        dictionary["a"] = 1.0;
+        otio::SharedAnyDictionary original(dictionary);
+        otio::SharedAnyDictionary copy = original;
+        assertTrue(copy.shares_with(original));
+
+        // the first change detaches the copy
+        copy.detach()["b"] = 2.0;
+        assertFalse(copy.shares_with(original));
+        assertEqual(keys_of(original.get()), (std::vector<std::string>{ "a" }));
+        assertEqual(
+            keys_of(copy.get()),
+            (std::vector<std::string>{ "a", "b" }));
+
+        // a dictionary handed out by reference is copied for the next copy
+        // of its holder, and shared again after that
+        otio::AnyDictionary&      handed_out = original.mutable_get(nullptr);
+        otio::SharedAnyDictionary later      = original;
+        assertFalse(later.shares_with(original));
+        handed_out["c"] = 3.0;
+        assertEqual(keys_of(later.get()), (std::vector<std::string>{ "a" }));
+        otio::SharedAnyDictionary latest = original;
+        assertTrue(latest.shares_with(original));
+
+        // as is one handed out by an object, for its next clone
+        otio::SerializableObject::Retainer<otio::Clip> clip =
+            new otio::Clip("clip");
+        clip->metadata()["a"] = 1.0;
+        otio::SerializableObject::Retainer<otio::Clip> first_clone =
+            dynamic_cast<otio::Clip*>(clip->clone());
+        otio::SerializableObject::Retainer<otio::Clip> second_clone =
+            dynamic_cast<otio::Clip*>(clip->clone());
+        assertFalse(&first_clone->metadata_ref() == &clip->metadata_ref());
+        assertTrue(&second_clone->metadata_ref() == &clip->metadata_ref());
+
+        // one lent through a mutation stamp, only while the stamp lives
+        otio::SharedAnyDictionary lent(dictionary);
+        auto                      stamp = lent.lend(nullptr);
+        assertFalse(otio::SharedAnyDictionary(lent).shares_with(lent));
+        delete stamp;
+        assertTrue(otio::SharedAnyDictionary(lent).shares_with(lent));
+
+        // whether it holds only data is worked out again once detached
+        assertTrue(lent.holds_only_data());
+        lent.detach()["clip"] = otio::create_safely_typed_any(new otio::Clip);
+        assertFalse(lent.holds_only_data());
+
+        otio::SharedAnyDictionary empty;
+        assertTrue(empty.get().empty());
+        assertFalse(empty.shares_with(otio::SharedAnyDictionary(empty)));
+    });
+
+    tests.run(argc, argv);
+    return 0;
+}
@@ -9,6 +9,7 @@
 #include <opentimelineio/missingReference.h>
 #include <opentimelineio/serializableCollection.h>
 #include <opentimelineio/timeline.h>
+#include <opentimelineio/track.h>
 #include <opentimelineio/freezeFrame.h>
 #include <opentimelineio/linearTimeWarp.h>
 #include <opentimelineio/marker.h>
@@ -260,6 +261,155 @@ main(int argc, char** argv)
         assertEqual(marker->color().c_str(), red);
     });
 
+    tests.add_test("test_generation", [] {
+        using namespace otio;
+        SerializableObject::Retainer<ExternalReference> media =
+            new ExternalReference("file:///a.mov");
+        SerializableObject::Retainer<Clip> clip = new Clip("a", media);
+        SerializableObject::Retainer<Track> track = new Track();
+        SerializableObject::Retainer<Timeline> timeline = new Timeline();
+        track->append_child(clip);
+        timeline->tracks()->append_child(track);
+
+        std::vector<SerializableObject*> clip_changes;
+        std::vector<SerializableObject*> timeline_changes;
+        int clip_observer = clip->add_change_observer(
+            [&](SerializableObject* changed) { clip_changes.push_back(changed); });
+        timeline->add_change_observer(
+            [&](SerializableObject* changed) { timeline_changes.push_back(changed); });
+
+        // changes to a media reference reach its clip and everything
+        // above it
+        auto clip_generation     = clip->generation();
+        auto track_generation    = track->generation();
+        auto timeline_generation = timeline->generation();
+        media->set_available_range(otime::TimeRange(
+            otime::RationalTime(0, 24),
+            otime::RationalTime(24, 24)));
+        assertTrue(clip->generation() > clip_generation);
+        assertTrue(track->generation() > track_generation);
+        assertTrue(timeline->generation() > timeline_generation);
+        assertEqual(clip_changes.size(), 1);
+        assertEqual(clip_changes[0], (SerializableObject*)media.value);
+        assertEqual(timeline_changes.size(), 1);
+
+        // generations are unique across objects
+        assertNotEqual(clip->generation(), track->generation());
+
+        clip->set_source_range(otime::TimeRange(
+            otime::RationalTime(0, 24),
+            otime::RationalTime(12, 24)));
+        assertEqual(clip_changes.size(), 2);
+        assertEqual(clip_changes[1], (SerializableObject*)clip.value);
+
+        // siblings are unaffected
+        SerializableObject::Retainer<Clip> other = new Clip("b");
+        track->append_child(other);
+        auto other_generation = other->generation();
+        clip->set_name("renamed");
+        assertEqual(other->generation(), other_generation);
+        assertEqual(timeline_changes.size(), 4);
+        assertEqual(timeline_changes.back(), (SerializableObject*)clip.value);
+
+        // a replaced media reference no longer reaches the clip
+        clip->set_media_reference(new ExternalReference("file:///b.mov"));
+        clip_generation = clip->generation();
+        media->set_target_url("file:///c.mov");
+        assertEqual(clip->generation(), clip_generation);
+
+        // removed children and observers are forgotten
+        clip->remove_change_observer(clip_observer);
+        track->remove_child(0);
+        assertEqual(timeline_changes.size(), 6);
+        clip->set_name("removed");
+        assertEqual(clip_changes.size(), 4);
+        assertEqual(timeline_changes.size(), 6);
+    });
+
+    tests.add_test("test_generation_of_held_objects", [] {
+        using namespace otio;
+        SerializableObject::Retainer<Clip>     clip = new Clip("a");
+        SerializableObject::Retainer<Timeline> timeline = new Timeline();
+        SerializableObject::Retainer<Track>    track = new Track();
+        SerializableObject::Retainer<Marker>   marker = new Marker("m");
+        timeline->tracks()->append_child(track);
+        track->append_child(clip);
+
+        // the accessors themselves are not modifications
+        auto generation = timeline->generation();
+        AnyDictionary& metadata = clip->metadata();
+        clip->markers();
+        clip->effects();
+        clip->dynamic_fields();
+        assertEqual(timeline->generation(), generation);
+
+        // writes through the metadata are, however long it is held
+        metadata["k"] = 1;
+        assertTrue(timeline->generation() > generation);
+        generation = timeline->generation();
+        metadata.erase("k");
+        assertTrue(timeline->generation() > generation);
+
+        // markers added are counted once the generation is read, and then
+        // pass their changes on to the clip
+        generation = timeline->generation();
+        clip->markers().push_back(marker);
+        assertTrue(timeline->generation() > generation);
+        generation = timeline->generation();
+        marker->set_marked_range(otime::TimeRange(
+            otime::RationalTime(0, 24),
+            otime::RationalTime(1, 24)));
+        assertTrue(clip->generation() > generation);
+        assertTrue(timeline->generation() > generation);
+        generation = timeline->generation();
+        marker->metadata()["k"] = 1;
+        assertTrue(timeline->generation() > generation);
+
+        // as do effects, including those of clips added since
+        SerializableObject::Retainer<Clip> other = new Clip("b");
+        SerializableObject::Retainer<LinearTimeWarp> warp =
+            new LinearTimeWarp();
+        other->effects().push_back(warp.value);
+        generation = timeline->generation();
+        track->append_child(other);
+        assertTrue(timeline->generation() > generation);
+        generation = timeline->generation();
+        warp->set_time_scalar(2);
+        assertTrue(timeline->generation() > generation);
+
+        // removed markers no longer reach the clip
+        clip->markers().clear();
+        generation = clip->generation();
+        marker->set_name("removed");
+        assertEqual(clip->generation(), generation);
+    });
+
+    tests.add_test("test_change_observers", [] {
+        using namespace otio;
+        SerializableObject::Retainer<Clip> clip = new Clip("a");
+
+        // observers may remove themselves and others, and add new ones,
+        // while being called
+        std::vector<int> calls;
+        int              first  = -1;
+        int              second = -1;
+        first                   = clip->add_change_observer(
+            [&](SerializableObject*) {
+                calls.push_back(1);
+                clip->remove_change_observer(first);
+                clip->remove_change_observer(second);
+                clip->add_change_observer(
+                    [&](SerializableObject*) { calls.push_back(3); });
+            });
+        second = clip->add_change_observer(
+            [&](SerializableObject*) { calls.push_back(2); });
+
+        clip->set_name("b");
+        assertEqual(calls, (std::vector<int>{ 1 }));
+        clip->set_name("c");
+        assertEqual(calls, (std::vector<int>{ 1, 3 }));
+    });
+
     tests.run(argc, argv);
     return 0;
 }
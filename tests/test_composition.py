@@ -36,6 +36,54 @@ class CompositionTests(unittest.TestCase, otio_test_utils.OTIOAssertions):
             []
         )
 
+    def test_iteration_in_batches(self):
+        clips = [otio.schema.Clip(name=str(i)) for i in range(1000)]
+        tr = otio.schema.Track(children=clips)
+
+        # iteration wraps children in growing batches
+        self.assertEqual([c.name for c in tr], [str(i) for i in range(1000)])
+        for c, expected in zip(tr, clips):
+            self.assertIs(c, expected)
+
+        self.assertEqual(tr[10:20], clips[10:20])
+        self.assertEqual(tr[-5:], clips[-5:])
+        self.assertEqual(tr[::100], clips[::100])
+        self.assertEqual(tr[20:10:-3], clips[20:10:-3])
+        self.assertEqual(tr[5:5], [])
+
+        self.assertEqual(tr.find_clips(), clips)
+        self.assertEqual(
+            tr.find_children(descended_from_type=otio.schema.Clip),
+            clips
+        )
+
+    def test_iteration_sees_edits(self):
+        tr = otio.schema.Track(
+            children=[otio.schema.Clip(name=str(i)) for i in range(20)]
+        )
+
+        # edits made while iterating are seen by the rest of the iteration,
+        # as they are for a list
+        seen = []
+        for c in tr:
+            seen.append(c.name)
+            if c.name == "3":
+                del tr[4:10]
+            if c.name == "12":
+                tr.append(otio.schema.Clip(name="new"))
+        self.assertEqual(
+            seen,
+            ["0", "1", "2", "3"] + [str(i) for i in range(10, 20)] + ["new"]
+        )
+
+        # as are edits to the children themselves, which keep the batch
+        names = []
+        for c in tr:
+            c.metadata["seen"] = True
+            names.append(c.name)
+        self.assertEqual(names, [c.name for c in tr])
+        self.assertTrue(all(c.metadata["seen"] for c in tr))
+
     def test_equality(self):
         co0 = otio.core.Composition()
         co00 = otio.core.Composition()
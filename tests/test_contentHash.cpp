@@ -0,0 +1,260 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "utils.h"
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/contentHash.h>
+#include <opentimelineio/deserialization.h>
+#include <opentimelineio/effect.h>
+#include <opentimelineio/externalReference.h>
+#include <opentimelineio/marker.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/threadPool.h>
+#include <opentimelineio/timeline.h>
+#include <opentimelineio/track.h>
+
+#include <iostream>
+#include <set>
+#include <string>
+
+namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
+
+namespace {
+
+otio::TimeRange const range(
+    otio::RationalTime(0, 24),
+    otio::RationalTime(24, 24));
+
+otio::Clip*
+make_clip(std::string const& name)
+{
+    return new otio::Clip(
+        name,
+        new otio::ExternalReference("file:///media/" + name + ".mov"),
+        range);
+}
+
+otio::Timeline*
+make_timeline(int tracks, int clips_per_track)
+{
+    auto timeline = new otio::Timeline("timeline");
+    for (int t = 0; t < tracks; ++t)
+    {
+        auto track = new otio::Track("V" + std::to_string(t + 1));
+        for (int c = 0; c < clips_per_track; ++c)
+        {
+            track->append_child(make_clip(
+                track->name() + "_" + std::to_string(c)));
+        }
+        timeline->tracks()->append_child(track);
+    }
+    return timeline;
+}
+
+otio::Track*
+track_at(otio::Timeline* timeline, int index)
+{
+    return dynamic_cast<otio::Track*>(
+        timeline->tracks()->children()[index].value);
+}
+
+otio::Clip*
+clip_at(otio::Timeline* timeline, int track, int index)
+{
+    return dynamic_cast<otio::Clip*>(
+        track_at(timeline, track)->children()[index].value);
+}
+
+// The hash of object, checking that it matches the one computed from
+// scratch, without anything kept from earlier hashes.
+otio::ContentHash
+checked_hash(otio::SerializableObject* object)
+{
+    otio::ErrorStatus       err;
+    otio::ContentHash const hash = otio::content_hash(object, &err);
+    assertFalse(otio::is_error(err));
+
+    otio::SerializableObject::Retainer<> fresh =
+        otio::SerializableObject::from_json_string(object->to_json_string());
+    assertEqual(otio::content_hash(fresh).to_string(), hash.to_string());
+    return hash;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Tests tests;
+
+    tests.add_test("test_stable", [] {
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_timeline(2, 3);
+        otio::ContentHash const hash = otio::content_hash(timeline);
+        assertTrue(hash != otio::ContentHash());
+        assertEqual(otio::content_hash(timeline), hash);
+        assertEqual(hash.to_string().size(), size_t(32));
+
+        // a clone, or a copy read back from JSON, hashes the same
+        otio::SerializableObject::Retainer<> clone = timeline->clone();
+        assertEqual(otio::content_hash(clone), hash);
+        assertEqual(checked_hash(timeline), hash);
+
+        // as does metadata set in another order
+        otio::SerializableObject::Retainer<otio::Clip> first =
+            make_clip("clip");
+        otio::SerializableObject::Retainer<otio::Clip> second =
+            make_clip("clip");
+        first->metadata()["a"]  = int64_t(1);
+        first->metadata()["b"]  = std::string("two");
+        second->metadata()["b"] = std::string("two");
+        second->metadata()["a"] = int64_t(1);
+        assertEqual(otio::content_hash(first), otio::content_hash(second));
+
+        assertEqual(
+            otio::content_hash(nullptr).to_string(),
+            std::string(32, '0'));
+    });
+
+    tests.add_test("test_distinct", [] {
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_timeline(3, 20);
+        std::set<otio::ContentHash> hashes;
+        for (int t = 0; t < 3; ++t)
+        {
+            hashes.insert(otio::content_hash(track_at(timeline, t)));
+            for (int c = 0; c < 20; ++c)
+            {
+                hashes.insert(otio::content_hash(clip_at(timeline, t, c)));
+            }
+        }
+        assertEqual(hashes.size(), size_t(63));
+
+        // values that serialize differently hash differently
+        otio::SerializableObject::Retainer<otio::Clip> clip = make_clip("a");
+        otio::ContentHash const empty = otio::content_hash(clip);
+        clip->metadata()["x"] = std::string("");
+        otio::ContentHash const with_string = otio::content_hash(clip);
+        clip->metadata()["x"] = otio::AnyDictionary();
+        otio::ContentHash const with_dictionary = otio::content_hash(clip);
+        clip->metadata()["x"] = otio::AnyVector();
+        otio::ContentHash const with_vector = otio::content_hash(clip);
+        assertEqual(
+            std::set<otio::ContentHash>(
+                { empty, with_string, with_dictionary, with_vector })
+                .size(),
+            size_t(4));
+    });
+
+    tests.add_test("test_mutation", [] {
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_timeline(2, 10);
+        otio::ContentHash       hash  = checked_hash(timeline);
+        otio::ContentHash const track =
+            otio::content_hash(track_at(timeline, 1));
+
+        // each edit changes the hash of what holds what was edited, and not
+        // that of anything else
+        clip_at(timeline, 0, 4)->set_name("renamed");
+        assertTrue(checked_hash(timeline) != hash);
+        assertEqual(otio::content_hash(track_at(timeline, 1)), track);
+        hash = checked_hash(timeline);
+
+        auto reference = dynamic_cast<otio::ExternalReference*>(
+            clip_at(timeline, 0, 2)->media_reference());
+        reference->set_target_url("file:///media/other.mov");
+        assertTrue(checked_hash(timeline) != hash);
+        hash = checked_hash(timeline);
+
+        track_at(timeline, 1)->remove_child(3);
+        assertTrue(checked_hash(timeline) != hash);
+        hash = checked_hash(timeline);
+
+        // markers and effects do not pass their changes on to the items
+        // holding them, which are hashed again each time
+        auto clip   = clip_at(timeline, 1, 0);
+        auto marker = new otio::Marker("marker");
+        clip->markers().push_back(marker);
+        clip->effects().push_back(new otio::Effect("effect", "blur"));
+        assertTrue(checked_hash(timeline) != hash);
+        hash = checked_hash(timeline);
+        marker->set_name("renamed marker");
+        assertTrue(checked_hash(timeline) != hash);
+        hash = checked_hash(timeline);
+        clip->effects()[0]->set_effect_name("sharpen");
+        assertTrue(checked_hash(timeline) != hash);
+        hash = checked_hash(timeline);
+
+        // as are objects in metadata
+        auto inner = new otio::Clip("inner");
+        clip_at(timeline, 0, 0)->metadata()["inner"] =
+            otio::SerializableObject::Retainer<>(inner);
+        assertTrue(checked_hash(timeline) != hash);
+        hash = checked_hash(timeline);
+        inner->set_name("renamed inner");
+        assertTrue(checked_hash(timeline) != hash);
+        hash = checked_hash(timeline);
+
+        // as is metadata held on to by reference, written through later
+        otio::AnyDictionary& metadata = clip_at(timeline, 1, 5)->metadata();
+        hash                          = checked_hash(timeline);
+        metadata["k"]                 = int64_t(1);
+        assertTrue(checked_hash(timeline) != hash);
+        hash = checked_hash(timeline);
+        metadata["k"] = int64_t(2);
+        assertTrue(checked_hash(timeline) != hash);
+        hash = checked_hash(timeline);
+
+        // as is the timeline, which does not hold its stack directly
+        timeline->set_name("renamed timeline");
+        assertTrue(checked_hash(timeline) != hash);
+    });
+
+    tests.add_test("test_errors", [] {
+        otio::SerializableObject::Retainer<otio::Track> track =
+            new otio::Track("V1");
+        track->append_child(make_clip("clip"));
+        track->metadata()["unsupported"] = 1.0f;
+
+        // nothing is kept from a walk that failed
+        for (int i = 0; i < 2; ++i)
+        {
+            otio::ErrorStatus err;
+            assertTrue(otio::content_hash(track, &err) == otio::ContentHash());
+            assertTrue(otio::is_error(err));
+        }
+    });
+
+    tests.add_test("test_parallel", [] {
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_timeline(4, 200);
+        std::vector<otio::SerializableObject const*> roots;
+        for (int t = 0; t < 4; ++t)
+        {
+            for (int c = 0; c < 200; c += 10)
+            {
+                roots.push_back(clip_at(timeline, t, c));
+            }
+            roots.push_back(track_at(timeline, t));
+        }
+        roots.push_back(timeline);
+
+        // the same answers as hashing serially, from scratch
+        std::vector<otio::ContentHash> expected;
+        for (auto root: roots)
+        {
+            otio::SerializableObject::Retainer<> clone = root->clone();
+            expected.push_back(otio::content_hash(clone));
+        }
+
+        otio::ThreadPool  pool(4);
+        otio::ErrorStatus err;
+        assertTrue(otio::content_hashes(roots, &err, &pool) == expected);
+        assertFalse(otio::is_error(err));
+        assertTrue(otio::content_hashes(roots, &err, &pool) == expected);
+    });
+
+    tests.run(argc, argv);
+    return 0;
+}
@@ -0,0 +1,257 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "utils.h"
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/deltaSerializer.h>
+#include <opentimelineio/deserialization.h>
+#include <opentimelineio/effect.h>
+#include <opentimelineio/gap.h>
+#include <opentimelineio/marker.h>
+#include <opentimelineio/serialization.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/timeline.h>
+#include <opentimelineio/track.h>
+
+#include <iostream>
+#include <string>
+
+namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
+
+namespace {
+
+otio::TimeRange const range(
+    otio::RationalTime(0, 24),
+    otio::RationalTime(24, 24));
+
+otio::Clip*
+make_clip(std::string const& name)
+{
+    return new otio::Clip(name, nullptr, range);
+}
+
+otio::Timeline*
+make_timeline(int tracks, int clips_per_track)
+{
+    auto timeline = new otio::Timeline("timeline");
+    for (int t = 0; t < tracks; ++t)
+    {
+        auto track = new otio::Track("V" + std::to_string(t + 1));
+        for (int c = 0; c < clips_per_track; ++c)
+        {
+            track->append_child(make_clip(
+                track->name() + "_" + std::to_string(c)));
+        }
+        timeline->tracks()->append_child(track);
+    }
+    return timeline;
+}
+
+otio::Track*
+track_at(otio::Timeline* timeline, int index)
+{
+    return dynamic_cast<otio::Track*>(
+        timeline->tracks()->children()[index].value);
+}
+
+size_t
+operation_count(std::string const& patch)
+{
+    std::any value;
+    assertTrue(otio::deserialize_json_from_string(patch, &value));
+    return std::any_cast<otio::AnyVector const&>(value).size();
+}
+
+// Saves timeline as a base and a patch after each edit, and checks that
+// applying each patch in turn to the base, and compacting the base and
+// all the patches, reproduce the timeline.
+struct Saver
+{
+    explicit Saver(otio::Timeline* timeline)
+        : timeline(timeline)
+        , serializer(timeline)
+        , base(serializer.base_json())
+    {
+        otio::ErrorStatus err;
+        std::any          value;
+        assertTrue(otio::deserialize_json_from_string(base, &value, &err));
+        copy = std::any_cast<otio::SerializableObject::Retainer<>>(value);
+    }
+
+    void save()
+    {
+        otio::ErrorStatus err;
+        std::string const patch = serializer.patch_json(&err);
+        assertFalse(otio::is_error(err));
+        patches.push_back(patch);
+
+        copy = otio::apply_json_patch(copy, patch, &err);
+        assertFalse(otio::is_error(err));
+        assertEqual(copy->to_json_string(), timeline->to_json_string());
+        assertTrue(copy->is_equivalent_to(*timeline));
+
+        assertEqual(
+            otio::compact_json_patches(base, patches, &err),
+            timeline->to_json_string());
+        assertFalse(otio::is_error(err));
+    }
+
+    otio::Timeline*                      timeline;
+    otio::DeltaSerializer                serializer;
+    std::string                          base;
+    std::vector<std::string>             patches;
+    otio::SerializableObject::Retainer<> copy;
+};
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Tests tests;
+
+    tests.add_test("test_nothing_changed", [] {
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_timeline(2, 3);
+        otio::DeltaSerializer serializer(timeline);
+        serializer.base_json();
+        assertEqual(operation_count(serializer.patch_json()), size_t(0));
+
+        // reading the timeline is not a change
+        timeline->find_clips();
+        timeline->duration();
+        assertEqual(operation_count(serializer.patch_json()), size_t(0));
+    });
+
+    tests.add_test("test_edits", [] {
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_timeline(2, 5);
+        Saver saver(timeline);
+
+        // change an item
+        track_at(timeline, 0)->children()[2]->set_name("renamed");
+        saver.save();
+        assertEqual(operation_count(saver.patches.back()), size_t(1));
+
+        // insert, remove and replace items
+        track_at(timeline, 1)->insert_child(1, make_clip("inserted"));
+        track_at(timeline, 0)->remove_child(4);
+        track_at(timeline, 0)->set_child(0, make_clip("replaced"));
+        saver.save();
+
+        // change the fields of a track, of the stack and of the timeline
+        track_at(timeline, 1)->metadata()["checked"] = true;
+        saver.save();
+        timeline->tracks()->set_name("stack");
+        timeline->set_name("edited timeline");
+        saver.save();
+
+        // nest a stack in a track, then edit inside it
+        auto stack = new otio::Stack("nested");
+        stack->append_child(new otio::Track("nested track"));
+        track_at(timeline, 0)->append_child(stack);
+        saver.save();
+        dynamic_cast<otio::Track*>(stack->children()[0].value)
+            ->append_child(new otio::Gap(range));
+        saver.save();
+        assertEqual(operation_count(saver.patches.back()), size_t(1));
+
+        // move a track, add one and replace the tracks altogether
+        otio::SerializableObject::Retainer<otio::Track> track =
+            track_at(timeline, 0);
+        timeline->tracks()->remove_child(0);
+        timeline->tracks()->append_child(track);
+        timeline->tracks()->append_child(new otio::Track("V3"));
+        saver.save();
+        auto tracks = new otio::Stack("new tracks");
+        tracks->append_child(new otio::Track("only"));
+        timeline->set_tracks(tracks);
+        saver.save();
+
+        // nothing since the previous save
+        saver.save();
+        assertEqual(operation_count(saver.patches.back()), size_t(0));
+    });
+
+    tests.add_test("test_held_object_edits", [] {
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_timeline(2, 5);
+        auto clip = dynamic_cast<otio::Clip*>(
+            track_at(timeline, 0)->children()[1].value);
+        auto marker = new otio::Marker("marker");
+        clip->markers().push_back(marker);
+        clip->effects().push_back(new otio::Effect("effect", "blur"));
+        otio::AnyDictionary& metadata =
+            track_at(timeline, 1)->children()[3]->metadata();
+        Saver saver(timeline);
+
+        // edits of markers and effects reach their items, as do writes to
+        // metadata through a reference held since before the base
+        marker->set_name("renamed marker");
+        saver.save();
+        assertEqual(operation_count(saver.patches.back()), size_t(1));
+        clip->effects()[0]->set_effect_name("sharpen");
+        saver.save();
+        assertEqual(operation_count(saver.patches.back()), size_t(1));
+        metadata["k"] = int64_t(1);
+        saver.save();
+        assertEqual(operation_count(saver.patches.back()), size_t(1));
+        metadata["k"] = int64_t(2);
+        saver.save();
+        assertEqual(operation_count(saver.patches.back()), size_t(1));
+
+        saver.save();
+        assertEqual(operation_count(saver.patches.back()), size_t(0));
+    });
+
+    tests.add_test("test_patch_size", [] {
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_timeline(4, 250);
+        otio::DeltaSerializer serializer(timeline);
+        std::string const     base = serializer.base_json();
+
+        track_at(timeline, 2)->children()[100]->set_name("renamed");
+        track_at(timeline, 3)->insert_child(10, make_clip("inserted"));
+        std::string const patch = serializer.patch_json();
+        assertEqual(operation_count(patch), size_t(2));
+        assertTrue(patch.size() * 100 < base.size());
+    });
+
+    tests.add_test("test_patch_without_base", [] {
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_timeline(1, 2);
+        otio::DeltaSerializer serializer(timeline);
+        std::string const     patch = serializer.patch_json();
+        assertEqual(operation_count(patch), size_t(1));
+
+        otio::ErrorStatus                    err;
+        otio::SerializableObject::Retainer<> result =
+            otio::apply_json_patch(nullptr, patch, &err);
+        assertFalse(otio::is_error(err));
+        assertTrue(result->is_equivalent_to(*timeline));
+    });
+
+    tests.add_test("test_malformed_patches", [] {
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_timeline(1, 2);
+        for (std::string const patch:
+             { "{}",
+               "[1]",
+               R"([{"op": "replace", "path": ""}])",
+               R"([{"op": "splice", "path": "/tracks/children", "index": 5,
+                    "remove": 1, "insert": []}])",
+               R"([{"op": "replace", "path": "/tracks/children/7",
+                    "value": {"OTIO_SCHEMA": "Gap.1"}}])",
+               R"([{"op": "replace", "path": "/nothing",
+                    "value": {"OTIO_SCHEMA": "Gap.1"}}])" })
+        {
+            otio::ErrorStatus err;
+            assertFalse(otio::apply_json_patch(timeline, patch, &err));
+            assertTrue(otio::is_error(err));
+        }
+    });
+
+    tests.run(argc, argv);
+    return 0;
+}
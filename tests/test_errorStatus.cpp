@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "utils.h"
+
+#include <opentimelineio/allocationCounter.h>
+#include <opentimelineio/errorStatus.h>
+#include <opentimelineio/imageSequenceReference.h>
+
+#include <iostream>
+
+namespace otime = opentime::OPENTIME_VERSION;
+namespace otio  = opentimelineio::OPENTIMELINEIO_VERSION;
+
+int
+main(int argc, char** argv)
+{
+    Tests tests;
+
+    tests.add_test("test_ok_does_not_allocate", [] {
+        otio::ErrorStatus err(
+            otio::ErrorStatus::CANNOT_COMPUTE_AVAILABLE_RANGE);
+        assertEqual(
+            err.details.str(),
+            std::string("Cannot compute available range"));
+
+        size_t const start = otio::allocation_count();
+        err = otio::ErrorStatus::OK;
+        otio::ErrorStatus copy = err;
+        copy                   = otio::ErrorStatus();
+        assertFalse(otio::is_error(copy));
+        assertTrue(err.details.empty() && err.full_description.empty());
+        assertEqual(otio::allocation_count(), start);
+    });
+
+    tests.add_test("test_outcomes_do_not_allocate", [] {
+        // the static texts are made the first time one is needed
+        otio::ErrorStatus const first(otio::ErrorStatus::OK);
+
+        size_t const      start = otio::allocation_count();
+        otio::ErrorStatus err(otio::ErrorStatus::NOT_A_CHILD);
+        otio::ErrorStatus copy = err;
+        err = otio::ErrorStatus::MEDIA_REFERENCES_DO_NOT_CONTAIN_ACTIVE_KEY;
+
+        otio::ErrorStatus const& reader = err;
+        assertTrue(
+            reader.details == "active key not found in media references");
+        assertTrue(reader.full_description == reader.details);
+        assertTrue(copy.details == "item has no parent");
+        assertEqual(otio::allocation_count(), start);
+    });
+
+    tests.add_test("test_text", [] {
+        otio::ErrorStatus err(otio::ErrorStatus::NOT_A_CHILD);
+        assertEqual(err.details.str(), std::string("item has no parent"));
+        assertEqual(
+            err.full_description.str(),
+            std::string("item has no parent"));
+
+        // editing the text of an outcome copies it first
+        std::string& text = err.details;
+        text += "!";
+        assertTrue(err.details == "item has no parent!");
+        assertTrue(err.full_description == "item has no parent");
+        assertTrue(
+            otio::ErrorStatus(otio::ErrorStatus::NOT_A_CHILD).details
+            == "item has no parent");
+
+        err = otio::ErrorStatus(otio::ErrorStatus::ILLEGAL_INDEX, "no frame");
+        assertEqual(err.details.str(), std::string("no frame"));
+        assertEqual(
+            err.full_description.str(),
+            std::string("illegal index: no frame"));
+
+        // the text reads and edits as a std::string
+        std::string& details = err.details;
+        details += " 12";
+        err.details += ".";
+        std::string const message = "error: " + err.details;
+        assertEqual(message, std::string("error: no frame 12."));
+    });
+
+    tests.add_test("test_success_paths_do_not_allocate", [] {
+        otio::SerializableObject::Retainer<otio::ImageSequenceReference>
+            reference(new otio::ImageSequenceReference(
+                "file:///show/shot/",
+                "frame.",
+                ".exr",
+                1,
+                1,
+                24,
+                4,
+                otio::ImageSequenceReference::MissingFramePolicy::error,
+                otime::TimeRange(
+                    otime::RationalTime(0, 24),
+                    otime::RationalTime(48, 24))));
+        otio::ImageSequenceReference::URLFormatter formatter(*reference);
+        std::string                                url;
+        url.reserve(256);
+        otio::ErrorStatus err;
+
+        size_t const start = otio::allocation_count();
+        for (int i = 0; i < 48; ++i)
+        {
+            url.clear();
+            assertTrue(formatter.append_url(i, url, &err));
+            assertFalse(otio::is_error(err));
+            reference->frame_for_time(otime::RationalTime(i, 24), &err);
+            assertFalse(otio::is_error(err));
+        }
+        assertEqual(otio::allocation_count(), start);
+        assertEqual(url, std::string("file:///show/shot/frame.0048.exr"));
+    });
+
+    tests.run(argc, argv);
+    return 0;
+}
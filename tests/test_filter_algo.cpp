@@ -0,0 +1,372 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "utils.h"
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/filterAlgorithm.h>
+#include <opentimelineio/gap.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/timeline.h>
+#include <opentimelineio/track.h>
+#include <opentimelineio/transition.h>
+
+#include <iostream>
+
+namespace otime = opentime::OPENTIME_VERSION;
+namespace otio  = opentimelineio::OPENTIMELINEIO_VERSION;
+
+namespace {
+
+otio::FilterResult
+keep(otio::SerializableObject* object)
+{
+    return otio::FilterResult{ object };
+}
+
+bool
+is_gap(otio::SerializableObject const* object)
+{
+    return dynamic_cast<otio::Gap const*>(object) != nullptr;
+}
+
+// [cl0, gap, cl1, gap, [cl2 in a nested stack]]
+otio::SerializableObject::Retainer<otio::Timeline>
+make_timeline()
+{
+    otime::TimeRange range(
+        otime::RationalTime(0, 24),
+        otime::RationalTime(24, 24));
+    otio::SerializableObject::Retainer<otio::Timeline> timeline(
+        new otio::Timeline("timeline"));
+    timeline->tracks()->metadata()["tracks"] = std::string("yes");
+
+    otio::Track* track = new otio::Track("track");
+    track->append_child(new otio::Clip("cl0", nullptr, range));
+    track->append_child(new otio::Gap(range));
+    track->append_child(new otio::Clip("cl1", nullptr, range));
+    track->append_child(new otio::Gap(range));
+
+    otio::Stack* nested = new otio::Stack("nested");
+    otio::Track* inner  = new otio::Track("inner");
+    inner->append_child(new otio::Clip("cl2", nullptr, range));
+    nested->append_child(inner);
+    track->append_child(nested);
+
+    timeline->tracks()->append_child(track);
+    return timeline;
+}
+
+std::vector<std::string>
+names_in(otio::Composition const* composition)
+{
+    std::vector<std::string> names;
+    for (auto const& child: composition->children())
+    {
+        names.push_back(child->name());
+    }
+    return names;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Tests tests;
+
+    tests.add_test("test_filter_copies", [] {
+        auto              timeline = make_timeline();
+        otio::ErrorStatus err;
+        auto result = otio::filtered_composition(timeline, keep, nullptr, &err);
+        assertFalse(otio::is_error(err));
+        assertEqual(result.size(), size_t(1));
+        assertTrue(result[0].value != timeline.value);
+        assertTrue(result[0]->is_equivalent_to(*timeline));
+
+        // nothing in the copy belongs to the original
+        auto copy = dynamic_cast<otio::Timeline*>(result[0].value);
+        assertTrue(copy->tracks() != timeline->tracks());
+        auto original_clips = timeline->find_clips();
+        auto copied_clips   = copy->find_clips();
+        assertEqual(copied_clips.size(), original_clips.size());
+        for (size_t i = 0; i < copied_clips.size(); ++i)
+        {
+            assertTrue(copied_clips[i].value != original_clips[i].value);
+        }
+    });
+
+    tests.add_test("test_filter_prunes", [] {
+        auto timeline = make_timeline();
+        auto track    = dynamic_cast<otio::Track*>(
+            timeline->tracks()->children()[0].value);
+
+        // pruned objects are not passed to the filter
+        std::vector<otio::SerializableObject const*> pruned;
+        std::vector<std::string>                     filtered;
+        auto result = otio::filtered_composition(
+            track,
+            [&filtered](otio::SerializableObject* object) {
+                auto composable = dynamic_cast<otio::Composable*>(object);
+                filtered.push_back(composable->name());
+                if (composable->name() == "nested")
+                {
+                    return otio::FilterResult();
+                }
+                return otio::FilterResult{ object };
+            },
+            [&pruned](otio::SerializableObject const* object) {
+                if (is_gap(object))
+                {
+                    pruned.push_back(object);
+                    return true;
+                }
+                return false;
+            });
+        assertEqual(result.size(), size_t(1));
+        assertEqual(pruned.size(), size_t(2));
+
+        // ... and prune is passed the originals
+        assertTrue(pruned[0] == track->children()[1].value);
+        assertTrue(pruned[1] == track->children()[3].value);
+
+        // the children of the pruned stack are not visited
+        assertEqual(
+            filtered,
+            (std::vector<std::string>{ "track", "cl0", "cl1", "nested" }));
+        auto copy = dynamic_cast<otio::Track*>(result[0].value);
+        assertEqual(names_in(copy), (std::vector<std::string>{ "cl0", "cl1" }));
+
+        // the original is untouched
+        assertEqual(track->children().size(), size_t(5));
+    });
+
+    tests.add_test("test_filter_sees_children", [] {
+        auto timeline = make_timeline();
+        timeline->tracks()->append_child(new otio::Track("empty"));
+
+        // compositions are filtered with their children, so that a filter
+        // can prune the empty ones
+        std::vector<size_t> sizes;
+        auto                result = otio::filtered_composition(
+            timeline,
+            [&sizes](otio::SerializableObject* object) {
+                auto composition = dynamic_cast<otio::Composition*>(object);
+                if (composition)
+                {
+                    sizes.push_back(composition->children().size());
+                }
+
+                // only the direct children have been copied so far
+                if (composition && composition->name() == "track")
+                {
+                    auto nested = dynamic_cast<otio::Composition*>(
+                        composition->children()[4].value);
+                    assertTrue(nested->children().empty());
+                }
+                if (dynamic_cast<otio::Track*>(object)
+                    && composition->children().empty())
+                {
+                    return otio::FilterResult();
+                }
+                return otio::FilterResult{ object };
+            });
+        assertEqual(sizes, (std::vector<size_t>{ 2, 5, 1, 1, 0 }));
+        auto copy = dynamic_cast<otio::Timeline*>(result[0].value);
+        assertEqual(
+            names_in(copy->tracks()),
+            (std::vector<std::string>{ "track" }));
+        assertEqual(copy->find_clips().size(), size_t(3));
+    });
+
+    tests.add_test("test_filter_replaces", [] {
+        auto timeline = make_timeline();
+        auto track    = timeline->tracks()->children()[0];
+
+        auto result = otio::filtered_composition(
+            track,
+            [](otio::SerializableObject* object) {
+                auto clip = dynamic_cast<otio::Clip*>(object);
+                if (!clip)
+                {
+                    return otio::FilterResult{ object };
+                }
+
+                // each clip becomes itself and a renamed copy
+                otio::SerializableObject::Retainer<otio::Clip> other(
+                    dynamic_cast<otio::Clip*>(clip->clone()));
+                other->set_name(clip->name() + "_b");
+                return otio::FilterResult{ clip, other.value };
+            },
+            is_gap);
+        assertEqual(result.size(), size_t(1));
+        auto copy = dynamic_cast<otio::Track*>(result[0].value);
+        assertEqual(
+            names_in(copy),
+            (std::vector<std::string>{
+                "cl0", "cl0_b", "cl1", "cl1_b", "nested" }));
+        auto inner = dynamic_cast<otio::Track*>(
+            dynamic_cast<otio::Stack*>(copy->children()[4].value)
+                ->children()[0]
+                .value);
+        assertEqual(
+            names_in(inner),
+            (std::vector<std::string>{ "cl2", "cl2_b" }));
+
+        // replacing the root returns the replacement; the children of the
+        // root are still filtered, but are not part of the result
+        otio::SerializableObject::Retainer<> replacement(
+            new otio::Track("new"));
+        size_t calls = 0;
+        result       = otio::filtered_composition(
+            track,
+            [&replacement, &calls](otio::SerializableObject* object) {
+                ++calls;
+                if (dynamic_cast<otio::Composable*>(object)->name() == "track")
+                {
+                    return otio::FilterResult{ replacement };
+                }
+                return otio::FilterResult{ object };
+            });
+        assertEqual(result.size(), size_t(1));
+        assertTrue(result[0].value == replacement.value);
+        assertEqual(calls, size_t(8));
+        assertTrue(
+            dynamic_cast<otio::Track*>(replacement.value)->children().empty());
+    });
+
+    tests.add_test("test_filter_timeline_tracks", [] {
+        auto timeline = make_timeline();
+
+        // the tracks stack is filtered like any composition
+        auto result = otio::filtered_composition(
+            timeline,
+            [](otio::SerializableObject* object) {
+                if (dynamic_cast<otio::Track*>(object))
+                {
+                    return otio::FilterResult();
+                }
+                return otio::FilterResult{ object };
+            });
+        auto copy = dynamic_cast<otio::Timeline*>(result[0].value);
+        assertEqual(copy->tracks()->children().size(), size_t(0));
+        assertTrue(copy->tracks()->metadata().has_key("tracks"));
+
+        // ... and pruning it leaves the timeline without tracks
+        result = otio::filtered_composition(
+            timeline,
+            [](otio::SerializableObject* object) {
+                if (dynamic_cast<otio::Stack*>(object))
+                {
+                    return otio::FilterResult();
+                }
+                return otio::FilterResult{ object };
+            });
+        copy = dynamic_cast<otio::Timeline*>(result[0].value);
+        assertEqual(copy->tracks()->children().size(), size_t(0));
+        assertFalse(copy->tracks()->metadata().has_key("tracks"));
+    });
+
+    tests.add_test("test_filter_errors", [] {
+        auto timeline = make_timeline();
+        auto track    = timeline->tracks()->children()[0];
+
+        // a filter cannot put an object from the original into the copy
+        auto              original_clip =
+            dynamic_cast<otio::Track*>(track.value)->children()[0];
+        otio::ErrorStatus err;
+        auto              result = otio::filtered_composition(
+            track,
+            [&original_clip](otio::SerializableObject* object) {
+                if (dynamic_cast<otio::Gap*>(object))
+                {
+                    return otio::FilterResult{ original_clip.value };
+                }
+                return otio::FilterResult{ object };
+            },
+            nullptr,
+            &err);
+        assertTrue(otio::is_error(err));
+        assertEqual(err.outcome, otio::ErrorStatus::CHILD_ALREADY_PARENTED);
+        assertTrue(result.empty());
+
+        // ... nor add something that is not a composable to a composition
+        err    = otio::ErrorStatus();
+        result = otio::filtered_composition(
+            track,
+            [](otio::SerializableObject* object) {
+                if (dynamic_cast<otio::Gap*>(object))
+                {
+                    return otio::FilterResult{
+                        new otio::SerializableObjectWithMetadata()
+                    };
+                }
+                return otio::FilterResult{ object };
+            },
+            nullptr,
+            &err);
+        assertEqual(err.outcome, otio::ErrorStatus::TYPE_MISMATCH);
+        assertTrue(result.empty());
+    });
+
+    tests.add_test("test_filter_with_sequence_context", [] {
+        otime::TimeRange range(
+            otime::RationalTime(0, 24),
+            otime::RationalTime(24, 24));
+        otio::SerializableObject::Retainer<otio::Track> track(
+            new otio::Track("track"));
+        for (int i = 0; i < 5; ++i)
+        {
+            if (i == 2 || i == 3)
+            {
+                track->append_child(
+                    new otio::Transition("tr" + std::to_string(i)));
+            }
+            track->append_child(
+                new otio::Clip("cl" + std::to_string(i), nullptr, range));
+        }
+
+        // prune transitions and the clips that follow them
+        std::vector<otio::Composable*> seen;
+        std::vector<otio::Composable*> seen_as_previous;
+        auto result = otio::filtered_with_sequence_context(
+            track,
+            [&](otio::Composable*         previous,
+                otio::SerializableObject* object,
+                otio::Composable*         next) {
+                if (object != track.value && object->schema_name() != "Track")
+                {
+                    seen.push_back(dynamic_cast<otio::Composable*>(object));
+                    seen_as_previous.push_back(previous);
+
+                    // the child and its neighbors are out of the track
+                    assertFalse(seen.back()->parent());
+                    assertTrue(!previous || !previous->parent());
+                    assertTrue(!next || !next->parent());
+                }
+                if (dynamic_cast<otio::Transition*>(previous)
+                    || dynamic_cast<otio::Transition*>(object))
+                {
+                    return otio::FilterResult();
+                }
+                return otio::FilterResult{ object };
+            });
+        auto copy = dynamic_cast<otio::Track*>(result[0].value);
+        assertEqual(
+            names_in(copy),
+            (std::vector<std::string>{ "cl0", "cl1", "cl4" }));
+
+        // the neighbors are the copies that the filter sees in turn, even
+        // when they are pruned
+        assertEqual(seen.size(), size_t(7));
+        assertTrue(seen_as_previous[0] == nullptr);
+        for (size_t i = 1; i < seen.size(); ++i)
+        {
+            assertTrue(seen_as_previous[i] == seen[i - 1]);
+            assertTrue(seen[i] != track->children()[i].value);
+        }
+    });
+
+    tests.run(argc, argv);
+    return 0;
+}
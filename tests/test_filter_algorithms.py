@@ -144,6 +144,68 @@ class FilterTest(unittest.TestCase, otio_test_utils.OTIOAssertions):
         tr.extend([copy.deepcopy(tr[0]), copy.deepcopy(tr[0])])
         self.assertJsonEqual(tr, result)
 
+    def test_pruned_children_are_not_visited(self):
+        """test that the filter never sees what lies below a pruned item"""
+
+        tr = otio.schema.Track(name='tr')
+        tr.append(otio.schema.Clip(name='cl1'))
+        nested = otio.schema.Stack(name='nested')
+        nested.append(otio.schema.Track(name='inner'))
+        nested[0].append(otio.schema.Clip(name='cl2'))
+        tr.append(nested)
+        tr.append(otio.schema.Gap())
+
+        seen = []
+
+        def no_stacks(thing):
+            seen.append(thing.name)
+            if isinstance(thing, otio.schema.Stack):
+                # compositions are filtered with their children
+                self.assertEqual(1, len(thing))
+                return None
+            return thing
+
+        result = otio.algorithms.filtered_composition(
+            tr,
+            no_stacks,
+            types_to_prune=(otio.schema.Gap,)
+        )
+        self.assertEqual(['tr', 'cl1', 'nested'], seen)
+        self.assertEqual(['cl1'], [child.name for child in result])
+
+        # the original is untouched
+        self.assertEqual(3, len(tr))
+
+    def test_prune_empty_tracks(self):
+        """test that compositions are filtered with their children"""
+
+        st = otio.schema.Stack(name='st')
+        st.append(otio.schema.Track(name='full'))
+        st[0].append(otio.schema.Clip(name='cl1'))
+        st.append(otio.schema.Track(name='empty'))
+
+        result = otio.algorithms.filtered_composition(
+            st,
+            lambda t: None if isinstance(t, otio.schema.Track) and len(t) == 0
+            else t
+        )
+        self.assertEqual(['full'], [child.name for child in result])
+        self.assertEqual(['cl1'], [child.name for child in result[0]])
+
+    def test_prune_by_other_types(self):
+        """test types_to_prune with types that are not composables"""
+
+        tr = otio.schema.Track()
+        tr.append(otio.schema.Clip(name='cl1'))
+        tr.append(otio.schema.Gap())
+
+        result = otio.algorithms.filtered_composition(
+            tr,
+            lambda _: _,
+            types_to_prune=(otio.schema.Marker, otio.schema.Gap)
+        )
+        self.assertEqual(['cl1'], [child.name for child in result])
+
 
 class ReduceTest(unittest.TestCase, otio_test_utils.OTIOAssertions):
     maxDiff = None
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "utils.h"
+
+#include <opentimelineio/imageSequenceReference.h>
+
+#include <iostream>
+#include <string>
+
+namespace otime = opentime::OPENTIME_VERSION;
+namespace otio  = opentimelineio::OPENTIMELINEIO_VERSION;
+
+namespace {
+
+using Reference = otio::ImageSequenceReference;
+
+otio::SerializableObject::Retainer<Reference>
+make_reference(
+    std::string const& target_url_base,
+    int                start_frame,
+    int                frame_step,
+    int                frame_zero_padding,
+    double             duration)
+{
+    return new Reference(
+        target_url_base,
+        "frame.",
+        ".exr",
+        start_frame,
+        frame_step,
+        24,
+        frame_zero_padding,
+        Reference::MissingFramePolicy::error,
+        otime::TimeRange(
+            otime::RationalTime(0, 24),
+            otime::RationalTime(duration, 24)));
+}
+
+// Checks that the URLs of a run of images are those made one at a time.
+void
+assert_urls_match(Reference const* reference, int start, int count)
+{
+    otio::ErrorStatus err;
+    auto const urls =
+        reference->target_urls_for_image_range(start, count, &err);
+    assertFalse(otio::is_error(err));
+    assertEqual(urls.size(), size_t(count));
+
+    Reference::URLFormatter formatter(*reference);
+    std::string             appended;
+    for (int i = 0; i < count; ++i)
+    {
+        std::string const url =
+            reference->target_url_for_image_number(start + i, &err);
+        assertFalse(otio::is_error(err));
+        assertEqual(std::string(urls[i]), url);
+        assertEqual(formatter.url(start + i, &err), url);
+        assertTrue(formatter.append_url(start + i, appended, &err));
+    }
+    assertEqual(appended, urls.buffer);
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Tests tests;
+
+    tests.add_test("test_urls_for_image_range", [] {
+        auto reference = make_reference("file:///show/shot/", 1, 1, 4, 48);
+        assertEqual(reference->number_of_images_in_sequence(), 48);
+        assert_urls_match(reference, 0, 48);
+        assert_urls_match(reference, 10, 5);
+        assert_urls_match(reference, 47, 1);
+
+        otio::ErrorStatus err;
+        auto const urls = reference->target_urls_for_image_range(0, 2, &err);
+        assertEqual(
+            std::string(urls[0]),
+            std::string("file:///show/shot/frame.0001.exr"));
+        assertEqual(
+            std::string(urls[1]),
+            std::string("file:///show/shot/frame.0002.exr"));
+
+        // no images is not an error
+        auto const none = reference->target_urls_for_image_range(48, 0, &err);
+        assertFalse(otio::is_error(err));
+        assertEqual(none.size(), size_t(0));
+    });
+
+    tests.add_test("test_urls_for_image_range_formats", [] {
+        // a base without a trailing slash, frames stepping through zero,
+        // digits beyond the padding, and no padding at all; a frame step of
+        // n makes one image of every n frames
+        assert_urls_match(make_reference("file:///show", -4, 2, 3, 12), 0, 6);
+        assert_urls_match(make_reference("", 998, 1, 3, 4), 0, 4);
+        assert_urls_match(make_reference("/show/", 5, 10, 0, 60), 0, 6);
+
+        // image numbers before the first, as target_url_for_image_number()
+        // allows
+        assert_urls_match(make_reference("/show/", 10, 1, 2, 6), -2, 4);
+    });
+
+    tests.add_test("test_urls_for_image_range_errors", [] {
+        auto reference = make_reference("file:///show/shot/", 1, 1, 4, 48);
+
+        // a run past the last image fails as the first URL past it does
+        otio::ErrorStatus err;
+        auto urls = reference->target_urls_for_image_range(40, 9, &err);
+        assertEqual(urls.size(), size_t(0));
+        assertTrue(urls.buffer.empty());
+        assertEqual(err.outcome, otio::ErrorStatus::ILLEGAL_INDEX);
+
+        otio::ErrorStatus single_err;
+        reference->target_url_for_image_number(48, &single_err);
+        assertEqual(err.outcome, single_err.outcome);
+        assertTrue(err.full_description == single_err.full_description);
+
+        err  = otio::ErrorStatus();
+        urls = reference->target_urls_for_image_range(0, -1, &err);
+        assertEqual(urls.size(), size_t(0));
+        assertEqual(err.outcome, otio::ErrorStatus::ILLEGAL_INDEX);
+
+        Reference::URLFormatter formatter(*reference);
+        std::string             url = "unchanged";
+        assertFalse(formatter.append_url(48, url, &err));
+        assertEqual(url, std::string("unchanged"));
+        assertEqual(err.outcome, otio::ErrorStatus::ILLEGAL_INDEX);
+
+        // a sequence with no images fails whatever the range
+        auto empty = make_reference("file:///show/shot/", 1, 1, 4, 0);
+        err        = otio::ErrorStatus();
+        urls       = empty->target_urls_for_image_range(0, 0, &err);
+        assertEqual(urls.size(), size_t(0));
+        assertEqual(err.outcome, otio::ErrorStatus::ILLEGAL_INDEX);
+
+        empty->target_url_for_image_number(0, &single_err);
+        assertTrue(err.full_description == single_err.full_description);
+    });
+
+    tests.run(argc, argv);
+    return 0;
+}
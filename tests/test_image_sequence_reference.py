@@ -4,6 +4,11 @@
 """Test harness for Image Sequence References."""
 import unittest
 
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
 import opentimelineio as otio
 import opentimelineio.test_utils as otio_test_utils
 
@@ -306,6 +311,48 @@ class ImageSequenceReferenceTests(
         ]
         self.assertEqual(all_images_urls_zero_first, generated_urls_zero_first)
 
+    def test_target_urls_for_image_range(self):
+        ref = otio.schema.ImageSequenceReference(
+            "file:///show/seq/shot/rndr",
+            "show_shot.",
+            ".exr",
+            frame_zero_padding=4,
+            available_range=otio.opentime.TimeRange(
+                otio.opentime.RationalTime(0, 24),
+                otio.opentime.RationalTime(48, 24),
+            ),
+            start_frame=-3,
+            frame_step=2,
+            rate=24,
+        )
+
+        all_images_urls = [
+            ref.target_url_for_image_number(i)
+            for i in range(ref.number_of_images_in_sequence())
+        ]
+        self.assertEqual(ref.target_urls_for_image_range(), all_images_urls)
+        self.assertEqual(
+            ref.target_urls_for_image_range(3),
+            all_images_urls[3:]
+        )
+        self.assertEqual(
+            ref.target_urls_for_image_range(3, 5),
+            all_images_urls[3:8]
+        )
+        self.assertEqual(ref.target_urls_for_image_range(3, 0), [])
+
+        with self.assertRaises(IndexError):
+            ref.target_urls_for_image_range(3, len(all_images_urls))
+
+        ref.rate = 0
+        with self.assertRaises(IndexError) as exception_manager:
+            ref.target_urls_for_image_range()
+
+        self.assertEqual(
+            str(exception_manager.exception),
+            "Zero rate sequence has no frames.",
+        )
+
     def test_target_url_for_image_number_with_missing_slash(self):
         ref = otio.schema.ImageSequenceReference(
             "file:///show/seq/shot/rndr",
@@ -498,6 +545,73 @@ class ImageSequenceReferenceTests(
             ref.frame_for_time(otio.opentime.RationalTime(118, 48)), 48
         )
 
+    @unittest.skipIf(numpy is None, "requires numpy")
+    def test_frames_for_times(self):
+        ref = otio.schema.ImageSequenceReference(
+            "file:///show/seq/shot/rndr/",
+            "show_shot.",
+            ".exr",
+            frame_zero_padding=4,
+            available_range=otio.opentime.TimeRange(
+                otio.opentime.RationalTime(12, 24),
+                otio.opentime.RationalTime(48, 24),
+            ),
+            start_frame=1,
+            frame_step=1,
+            rate=24,
+        )
+
+        time_values = numpy.arange(0, 72, 0.5)
+        frames, valid = ref.frames_for_times(time_values, 24)
+        self.assertEqual(len(frames), len(time_values))
+        for value, frame, is_valid in zip(time_values, frames, valid):
+            time = otio.opentime.RationalTime(value, 24)
+            if ref.available_range.contains(time):
+                self.assertTrue(is_valid)
+                self.assertEqual(frame, ref.frame_for_time(time))
+            else:
+                self.assertFalse(is_valid)
+
+        ref.missing_frame_policy = (
+            otio.schema.ImageSequenceReference.MissingFramePolicy.hold
+        )
+        frames, valid = ref.frames_for_times(time_values, 24)
+        self.assertTrue(valid.all())
+        self.assertEqual(frames[0], 1)
+        self.assertEqual(frames[-1], ref.end_frame())
+
+    @unittest.skipIf(numpy is None, "requires numpy")
+    def test_presentation_times_for_image_numbers(self):
+        ref = otio.schema.ImageSequenceReference(
+            "file:///show/seq/shot/rndr/",
+            "show_shot.",
+            ".exr",
+            frame_zero_padding=4,
+            available_range=otio.opentime.TimeRange(
+                otio.opentime.RationalTime(12, 24),
+                otio.opentime.RationalTime(48, 24),
+            ),
+            start_frame=1,
+            frame_step=2,
+            rate=24,
+        )
+
+        image_numbers = numpy.arange(0, 30)
+        time_values, rate, valid = ref.presentation_times_for_image_numbers(
+            image_numbers
+        )
+        for image_number, value, is_valid in zip(
+            image_numbers, time_values, valid
+        ):
+            if image_number < ref.number_of_images_in_sequence():
+                self.assertTrue(is_valid)
+                self.assertEqual(
+                    otio.opentime.RationalTime(value, rate),
+                    ref.presentation_time_for_image_number(int(image_number))
+                )
+            else:
+                self.assertFalse(is_valid)
+
     def test_frame_for_time_out_of_range(self):
         ref = otio.schema.ImageSequenceReference(
             "file:///show/seq/shot/rndr/",
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "utils.h"
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/instrumentation.h>
+#include <opentimelineio/timeline.h>
+#include <opentimelineio/track.h>
+
+#include <iostream>
+#include <string>
+
+namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
+
+namespace {
+
+// The count of the named counter, or zero if no site of that name has
+// been reached.
+uint64_t
+count_of(std::string const& name)
+{
+    for (auto const& counter: otio::instrumentation_counters())
+    {
+        if (counter.name == name)
+        {
+            return counter.count;
+        }
+    }
+    return 0;
+}
+
+otio::Timeline*
+make_timeline()
+{
+    otio::TimeRange const range(
+        otio::RationalTime(0, 24),
+        otio::RationalTime(24, 24));
+    auto track = new otio::Track("V1");
+    track->append_child(new otio::Clip("a", nullptr, range));
+    track->append_child(new otio::Clip("b", nullptr, range));
+    auto timeline = new otio::Timeline("timeline");
+    timeline->tracks()->append_child(track);
+    return timeline;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Tests tests;
+
+    tests.add_test("test_counters", [] {
+        otio::reset_instrumentation();
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_timeline();
+        otio::ErrorStatus err;
+        std::string const json = timeline->to_json_string(&err);
+        otio::SerializableObject::Retainer<> read =
+            otio::SerializableObject::from_json_string(json, &err);
+        assertFalse(otio::is_error(err));
+        otio::SerializableObject::Retainer<> clone = timeline->clone(&err);
+        auto track = dynamic_cast<otio::Track*>(
+            timeline->tracks()->children().front().value);
+        track->range_of_all_children(&err);
+
+        if (!otio::instrumentation_enabled())
+        {
+            assertTrue(otio::instrumentation_counters().empty());
+            return;
+        }
+
+        assertEqual(count_of("serialize_json_to_string"), uint64_t(1));
+        assertEqual(count_of("deserialize_json_from_string"), uint64_t(1));
+        assertEqual(count_of("SerializableObject::clone"), uint64_t(1));
+        assertEqual(count_of("Reader::_Resolver::finalize"), uint64_t(2));
+        assertEqual(count_of("Track::range_of_all_children"), uint64_t(1));
+        assertTrue(count_of("objects decoded") > 0);
+
+        otio::reset_instrumentation();
+        assertEqual(count_of("SerializableObject::clone"), uint64_t(0));
+    });
+
+    tests.add_test("test_schema_versions", [] {
+        otio::reset_instrumentation();
+        otio::ErrorStatus                              err;
+        otio::SerializableObject::Retainer<otio::Clip> clip =
+            new otio::Clip("clip");
+        otio::schema_version_map const downgrade{ { "Clip", 1 } };
+        std::string const json = clip->to_json_string(&err, &downgrade);
+        otio::SerializableObject::Retainer<> read =
+            otio::SerializableObject::from_json_string(json, &err);
+        assertFalse(otio::is_error(err));
+
+        if (otio::instrumentation_enabled())
+        {
+            assertEqual(count_of("Writer::write downgrade"), uint64_t(1));
+            assertEqual(count_of("downgrade functions applied"), uint64_t(1));
+            assertEqual(count_of("TypeRegistry upgrade"), uint64_t(1));
+            assertEqual(count_of("upgrade functions applied"), uint64_t(1));
+        }
+    });
+
+    tests.add_test("test_trace", [] {
+        otio::reset_instrumentation();
+        otio::set_instrumentation_tracing(true);
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_timeline();
+        otio::SerializableObject::Retainer<> clone = timeline->clone();
+        otio::set_instrumentation_tracing(false);
+        timeline->clone()->possibly_delete();
+
+        std::string const trace = otio::instrumentation_trace_json();
+        assertTrue(trace.find("\"traceEvents\":[") != std::string::npos);
+
+        std::string const event = "\"name\":\"SerializableObject::clone\"";
+        size_t const      first = trace.find(event);
+        if (otio::instrumentation_enabled())
+        {
+            assertTrue(first != std::string::npos);
+            assertTrue(trace.find(event, first + 1) == std::string::npos);
+            assertTrue(trace.find("\"ph\":\"X\"") != std::string::npos);
+            assertEqual(count_of("SerializableObject::clone"), uint64_t(2));
+        }
+        else
+        {
+            assertTrue(first == std::string::npos);
+        }
+    });
+
+    tests.run(argc, argv);
+    return 0;
+}
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "utils.h"
+
+#include <opentimelineio/allocationCounter.h>
+#include <opentimelineio/clip.h>
+#include <opentimelineio/memoryFootprint.h>
+#include <opentimelineio/serializableCollection.h>
+#include <opentimelineio/timeline.h>
+#include <opentimelineio/track.h>
+
+#include <iostream>
+#include <string>
+
+namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
+
+namespace {
+
+otio::AnyDictionary
+make_metadata(int index)
+{
+    otio::AnyDictionary nested;
+    nested["scale"] = 1.5;
+    nested["label"] = std::string("a label long enough for the heap");
+
+    otio::AnyDictionary metadata;
+    metadata["vendor"] =
+        std::string("a vendor string long enough for the heap ")
+        + std::to_string(index);
+    metadata["id"]     = int64_t(index);
+    metadata["nested"] = std::move(nested);
+    return metadata;
+}
+
+otio::Clip*
+make_clip(int index)
+{
+    return new otio::Clip(
+        "a clip name long enough for the heap " + std::to_string(index),
+        nullptr,
+        otio::TimeRange(otio::RationalTime(0, 24), otio::RationalTime(24, 24)),
+        make_metadata(index));
+}
+
+otio::Timeline*
+make_timeline(int clips)
+{
+    auto track = new otio::Track("V1");
+    for (int i = 0; i < clips; ++i)
+    {
+        track->append_child(make_clip(i));
+    }
+    auto timeline = new otio::Timeline("timeline");
+    timeline->tracks()->append_child(track);
+    return timeline;
+}
+
+size_t
+bytes_of_schemas(otio::MemoryFootprint const& footprint)
+{
+    size_t bytes = 0;
+    for (auto const& e: footprint.schemas)
+    {
+        bytes += e.second.bytes;
+    }
+    return bytes;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Tests tests;
+
+    tests.add_test("test_counts", [] {
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_timeline(3);
+        otio::ErrorStatus           err;
+        otio::MemoryFootprint const footprint =
+            otio::memory_footprint(timeline, &err);
+        assertFalse(otio::is_error(err));
+
+        assertEqual(footprint.schemas.at("Timeline").objects, size_t(1));
+        assertEqual(footprint.schemas.at("Stack").objects, size_t(1));
+        assertEqual(footprint.schemas.at("Track").objects, size_t(1));
+        assertEqual(footprint.schemas.at("Clip").objects, size_t(3));
+        assertEqual(
+            footprint.schemas.at("MissingReference").objects,
+            size_t(3));
+        assertEqual(footprint.object_count, size_t(9));
+
+        assertEqual(bytes_of_schemas(footprint), footprint.total_bytes);
+        assertTrue(footprint.metadata_bytes > 0);
+        assertTrue(footprint.metadata_bytes < footprint.total_bytes);
+        assertTrue(footprint.string_bytes > 3 * 40);
+        assertTrue(footprint.string_bytes < footprint.total_bytes);
+
+        assertEqual(otio::memory_footprint(nullptr).total_bytes, size_t(0));
+    });
+
+    tests.add_test("test_growth", [] {
+        otio::SerializableObject::Retainer<otio::Clip> clip = make_clip(0);
+        otio::MemoryFootprint const before = otio::memory_footprint(clip);
+
+        clip->metadata()["notes"] = std::string(1000, 'x');
+        otio::MemoryFootprint const after = otio::memory_footprint(clip);
+        assertTrue(after.metadata_bytes >= before.metadata_bytes + 1000);
+        assertTrue(after.string_bytes >= before.string_bytes + 1000);
+        assertTrue(
+            after.schemas.at("Clip").bytes
+            >= before.schemas.at("Clip").bytes + 1000);
+        assertEqual(
+            after.schemas.at("MissingReference").bytes,
+            before.schemas.at("MissingReference").bytes);
+    });
+
+    tests.add_test("test_shared_metadata_counted_once", [] {
+        otio::SerializableObject::Retainer<otio::Clip> clip = make_clip(0);
+        otio::SerializableObject::Retainer<otio::SerializableCollection>
+            clones(new otio::SerializableCollection(
+                "clones",
+                { clip->clone(), clip->clone() }));
+        otio::SerializableObject::Retainer<otio::SerializableCollection>
+            copies(new otio::SerializableCollection(
+                "copies",
+                { make_clip(0), make_clip(0) }));
+
+        otio::MemoryFootprint const shared = otio::memory_footprint(clones);
+        otio::MemoryFootprint const apart  = otio::memory_footprint(copies);
+        assertEqual(shared.object_count, apart.object_count);
+        assertTrue(shared.metadata_bytes < apart.metadata_bytes);
+        assertTrue(shared.total_bytes < apart.total_bytes);
+    });
+
+    tests.add_test("test_close_to_allocations", [] {
+        size_t const start = otio::allocated_bytes();
+        otio::SerializableObject::Retainer<otio::Timeline> timeline =
+            make_timeline(100);
+        size_t const allocated = otio::allocated_bytes() - start;
+
+        size_t const estimated = otio::memory_footprint(timeline).total_bytes;
+        std::cout << "allocated " << allocated << ", estimated " << estimated
+                  << std::endl;
+        // within 10% of what was allocated
+        assertTrue(estimated * 10 > allocated * 9);
+        assertTrue(estimated * 10 < allocated * 11);
+    });
+
+    tests.run(argc, argv);
+    return 0;
+}
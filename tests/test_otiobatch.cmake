@@ -0,0 +1,99 @@
+# SPDX-License-Identifier: Apache-2.0
+# Copyright Contributors to the OpenTimelineIO project
+
+# Run otiobatch over the sample data and check that it prints what otiotool
+# prints for the same operations, run over the inputs one after another.
+#
+#   cmake -DOTIOBATCH=... -DPYTHON=... -DSAMPLE_DATA=... -DWORK_DIR=...
+#         -P test_otiobatch.cmake
+#
+# The comparison is skipped if the opentimelineio Python package, which
+# provides otiotool, cannot be imported with PYTHON.
+
+function(run_otiobatch result_var output_var)
+    execute_process(
+        COMMAND "${OTIOBATCH}" ${ARGN}
+        RESULT_VARIABLE result
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE  error)
+    set(${result_var} "${result}" PARENT_SCOPE)
+    set(${output_var} "${output}${error}" PARENT_SCOPE)
+endfunction()
+
+function(expect_usage_error expected)
+    run_otiobatch(result output ${ARGN})
+    if(NOT result EQUAL 2 OR NOT output MATCHES "${expected}")
+        message(FATAL_ERROR
+            "otiobatch ${ARGN}: expected a usage error matching "
+            "'${expected}', got ${result}:\n${output}")
+    endif()
+endfunction()
+
+# command lines otiotool would reject, or that would lose output
+file(MAKE_DIRECTORY "${WORK_DIR}")
+expect_usage_error("would both be written to"
+    --output-dir "${WORK_DIR}"
+    -i "${SAMPLE_DATA}/simple_cut.otio"
+       "${SAMPLE_DATA}/../sample_data/simple_cut.otio")
+expect_usage_error("invalid int value: 'x'"
+    -j x -i "${SAMPLE_DATA}/simple_cut.otio")
+expect_usage_error("expected a positive number of jobs, not 0"
+    -j 0 -i "${SAMPLE_DATA}/simple_cut.otio")
+expect_usage_error("expected a positive number of jobs, not -2"
+    --jobs -2 -i "${SAMPLE_DATA}/simple_cut.otio")
+
+execute_process(
+    COMMAND "${PYTHON}" -c "import opentimelineio.console.otiotool"
+    RESULT_VARIABLE result
+    OUTPUT_QUIET
+    ERROR_QUIET)
+if(NOT PYTHON OR NOT result EQUAL 0)
+    message(STATUS "otiotool is not available, skipping the comparison")
+    return()
+endif()
+
+# Compare the output of otiobatch over inputs with that of otiotool over
+# each of inputs in turn, given the same operations.
+function(compare inputs)
+    set(expected "")
+    foreach(input ${inputs})
+        execute_process(
+            COMMAND "${PYTHON}" -c
+                "from opentimelineio.console import otiotool; otiotool.main()"
+                -i "${SAMPLE_DATA}/${input}" ${ARGN}
+            RESULT_VARIABLE result
+            OUTPUT_VARIABLE output
+            ERROR_VARIABLE  error)
+        if(NOT result EQUAL 0)
+            message(FATAL_ERROR "otiotool -i ${input} ${ARGN}:\n${error}")
+        endif()
+        string(APPEND expected "${output}")
+    endforeach()
+
+    list(TRANSFORM inputs PREPEND "${SAMPLE_DATA}/")
+    foreach(jobs 1 4)
+        execute_process(
+            COMMAND "${OTIOBATCH}" -j ${jobs} -i ${inputs} ${ARGN}
+            RESULT_VARIABLE result
+            OUTPUT_VARIABLE output
+            ERROR_VARIABLE  error)
+        if(NOT result EQUAL 0)
+            message(FATAL_ERROR "otiobatch ${ARGN}:\n${error}")
+        endif()
+        if(NOT output STREQUAL expected)
+            message(FATAL_ERROR
+                "otiobatch -j ${jobs} ${ARGN} printed:\n${output}\n"
+                "where otiotool printed:\n${expected}")
+        endif()
+    endforeach()
+endfunction()
+
+compare("multiple_track.otio;transition_test.otio;nested_example.otio"
+    --stats)
+compare("multiple_track.otio" --video-only --stats -o -)
+compare("transition_test.otio" --remove-transitions -o -)
+compare("multiple_track.otio" --only-tracks-with-index 1 -o -)
+compare("nested_example.otio" --only-clips-with-name-regex "^Clip" -o -)
+compare("multiple_track.otio" --trim 1 00:00:03:00 -o -)
+compare("multiple_track.otio" --flatten video --keep-flattened-tracks -o -)
+compare("transition_test.otio" --redact -o -)
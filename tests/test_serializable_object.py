@@ -147,6 +147,39 @@ class SerializableObjTest(unittest.TestCase, otio_test_utils.OTIOAssertions):
         self.assertEqual(repr(so.metadata["vectors"]), repr(v))
 
 
+class ChangeTrackingTests(unittest.TestCase):
+    def test_generation(self):
+        clip = otio.schema.Clip(name="a")
+        track = otio.schema.Track()
+        track.append(clip)
+
+        generation = track.generation
+        clip.name = "b"
+        self.assertGreater(track.generation, generation)
+        self.assertNotEqual(clip.generation, track.generation)
+
+    def test_change_observer(self):
+        media = otio.schema.ExternalReference(target_url="file:///a.mov")
+        clip = otio.schema.Clip(name="a", media_reference=media)
+        track = otio.schema.Track()
+        track.append(clip)
+
+        changes = []
+        observer_id = track.add_change_observer(changes.append)
+
+        clip.source_range = otio.opentime.TimeRange(
+            duration=otio.opentime.RationalTime(24, 24)
+        )
+        media.target_url = "file:///b.mov"
+        self.assertEqual(len(changes), 2)
+        self.assertIs(changes[0], clip)
+        self.assertIs(changes[1], media)
+
+        track.remove_change_observer(observer_id)
+        clip.name = "b"
+        self.assertEqual(len(changes), 2)
+
+
 class VersioningTests(unittest.TestCase, otio_test_utils.OTIOAssertions):
     def test_schema_definition(self):
         """define a schema and instantiate it from python"""
@@ -4,7 +4,9 @@
 #include "utils.h"
 
 #include <opentimelineio/clip.h>
+#include <opentimelineio/gap.h>
 #include <opentimelineio/timeline.h>
+#include <opentimelineio/transition.h>
 #include <opentimelineio/track.h>
 #include <opentimelineio/serialization.h>
 #include <opentimelineio/serializableObject.h>
@@ -17,6 +19,14 @@
 namespace otime = opentime::OPENTIME_VERSION;
 namespace otio  = opentimelineio::OPENTIMELINEIO_VERSION;
 
+// A C++ subclass that is not registered with the type registry.
+class UnregisteredClip : public otio::Clip
+{};
+
+// A C++ subclass that is registered once objects of it exist.
+class LateRegisteredClip : public otio::Clip
+{};
+
 int
 main(int argc, char** argv)
 {
@@ -112,6 +122,144 @@ main(int argc, char** argv)
 })CONTENT");
     });
 
+    tests.add_test("fast_cast", [] {
+        otio::SerializableObject::Retainer<otio::Track> track =
+            new otio::Track();
+        track->append_child(new otio::Clip());
+        track->append_child(new otio::Transition());
+        track->append_child(new otio::Gap());
+        track->append_child(new otio::Track());
+
+        for (auto const& child: track->children())
+        {
+            otio::Composable* c = child.value;
+            assertTrue(
+                otio::fast_cast<otio::Item>(c) == dynamic_cast<otio::Item*>(c));
+            assertTrue(
+                otio::fast_cast<otio::Clip>(c) == dynamic_cast<otio::Clip*>(c));
+            assertTrue(
+                otio::fast_cast<otio::Gap>(c) == dynamic_cast<otio::Gap*>(c));
+            assertTrue(
+                otio::fast_cast<otio::Transition>(c)
+                == dynamic_cast<otio::Transition*>(c));
+            assertTrue(
+                otio::fast_cast<otio::Composition>(c)
+                == dynamic_cast<otio::Composition*>(c));
+            assertTrue(
+                otio::fast_cast<otio::Track>(c)
+                == dynamic_cast<otio::Track*>(c));
+        }
+        assertTrue(
+            track->type_tags()
+            == (otio::TypeTag::KNOWN | otio::TypeTag::COMPOSABLE
+                | otio::TypeTag::ITEM | otio::TypeTag::COMPOSITION
+                | otio::TypeTag::TRACK));
+        otio::Composable* null_composable = nullptr;
+        assertTrue(otio::fast_cast<otio::Clip>(null_composable) == nullptr);
+
+        // without registered tags, fast_cast falls back on dynamic_cast
+        otio::SerializableObject::Retainer<UnregisteredClip> unregistered =
+            new UnregisteredClip();
+        assertEqual(unregistered->type_tags(), uint32_t(0));
+        assertTrue(otio::fast_cast<otio::Clip>(unregistered.value) != nullptr);
+        assertTrue(otio::fast_cast<otio::Gap>(unregistered.value) == nullptr);
+
+        // ... and remembers that, even if the type is registered later
+        otio::SerializableObject::Retainer<LateRegisteredClip> early =
+            new LateRegisteredClip();
+        assertEqual(early->type_tags(), uint32_t(0));
+        assertTrue(otio::TypeRegistry::instance().register_type(
+            "LateRegisteredClip",
+            1,
+            &typeid(LateRegisteredClip),
+            [] { return new LateRegisteredClip(); },
+            "LateRegisteredClip",
+            otio::type_tags_of<LateRegisteredClip>()));
+        assertEqual(early->type_tags(), uint32_t(0));
+        assertTrue(otio::fast_cast<otio::Clip>(early.value) != nullptr);
+        assertEqual(early->schema_name(), std::string("LateRegisteredClip"));
+        otio::SerializableObject::Retainer<LateRegisteredClip> late =
+            new LateRegisteredClip();
+        assertEqual(late->type_tags(), otio::type_tags_of<otio::Clip>());
+
+        // as happens for schemas defined in Python
+        otio::TypeRegistry::instance().register_type(
+            "UntaggedClip",
+            1,
+            nullptr,
+            [] { return new UnregisteredClip(); },
+            "UntaggedClip");
+        otio::SerializableObject::Retainer<otio::Clip> untagged =
+            new otio::Clip();
+        assertTrue(otio::TypeRegistry::instance().set_type_record(
+            untagged,
+            "UntaggedClip"));
+        assertEqual(untagged->type_tags(), uint32_t(0));
+        assertTrue(otio::fast_cast<otio::Item>(untagged.value) != nullptr);
+        assertTrue(
+            otio::fast_cast<otio::Composition>(untagged.value) == nullptr);
+    });
+
+    tests.add_test("clones share metadata until it changes", [] {
+        otio::AnyDictionary nested;
+        nested["label"] = std::string("avid clip");
+        otio::AnyDictionary metadata;
+        metadata["vendor"] = nested;
+        metadata["index"]  = int64_t(4);
+        otio::SerializableObject::Retainer<otio::Clip> clip =
+            new otio::Clip("clip", nullptr, std::nullopt, metadata);
+        clip->dynamic_fields()["extra"] = std::string("field");
+
+        otio::ErrorStatus err;
+        otio::SerializableObject::Retainer<otio::Clip> clone =
+            dynamic_cast<otio::Clip*>(clip->clone(&err));
+        assertFalse(otio::is_error(err));
+        assertTrue(clone->is_equivalent_to(*clip));
+        assertEqual(clone->to_json_string(&err), clip->to_json_string(&err));
+
+        otio::SerializableObject::Retainer<otio::Clip> second =
+            dynamic_cast<otio::Clip*>(clone->clone(&err));
+        assertTrue(second->is_equivalent_to(*clip));
+
+        // changing any one of them leaves the others alone
+        clone->metadata()["index"] = int64_t(5);
+        assertFalse(clone->is_equivalent_to(*clip));
+        assertTrue(second->is_equivalent_to(*clip));
+        assertEqual(
+            std::any_cast<int64_t>(second->metadata().at("index")),
+            int64_t(4));
+        second->dynamic_fields().erase("extra");
+        assertTrue(clip->dynamic_fields().has_key("extra"));
+
+        // as does changing a reference taken before cloning
+        otio::AnyDictionary& held = clip->metadata();
+        otio::SerializableObject::Retainer<otio::Clip> third =
+            dynamic_cast<otio::Clip*>(clip->clone(&err));
+        held["index"] = int64_t(6);
+        assertEqual(
+            std::any_cast<int64_t>(third->metadata().at("index")),
+            int64_t(4));
+
+        // objects held in metadata are cloned, not shared
+        otio::SerializableObject::Retainer<otio::Clip> holder = new otio::Clip(
+            "holder",
+            nullptr,
+            std::nullopt,
+            otio::AnyDictionary{
+                { "child",
+                  otio::SerializableObject::Retainer<>(new otio::Clip) } });
+        otio::SerializableObject::Retainer<otio::Clip> holder_clone =
+            dynamic_cast<otio::Clip*>(holder->clone(&err));
+        assertTrue(holder_clone->is_equivalent_to(*holder));
+        assertTrue(
+            std::any_cast<otio::SerializableObject::Retainer<>>(
+                holder_clone->metadata().at("child"))
+                .value
+            != std::any_cast<otio::SerializableObject::Retainer<>>(
+                   holder->metadata().at("child"))
+                   .value);
+    });
+
     tests.run(argc, argv);
     return 0;
 }
@@ -5,9 +5,11 @@
 #include "utils.h"
 
 #include <opentimelineio/clip.h>
+#include <opentimelineio/gap.h>
 #include <opentimelineio/stack.h>
 #include <opentimelineio/track.h>
 #include <opentimelineio/stackAlgorithm.h>
+#include <opentimelineio/threadPool.h>
 
 #include <iostream>
 
@@ -213,6 +215,119 @@ main(int argc, char** argv)
         assertEqual(result->duration().value(), 300);
     });
 
+    tests.add_test(
+        "test_flatten_stacks", [] {
+        using namespace otio;
+
+        otio::RationalTime rt_0_24{0, 24};
+        otio::RationalTime rt_150_24{150, 24};
+        otio::TimeRange tr_0_150_24{rt_0_24, rt_150_24};
+
+        // same layout as test_flatten_stack_01, repeated over many stacks,
+        // with every fourth stack made invalid by holding a clip directly.
+        std::vector<otio::SerializableObject::Retainer<otio::Stack>> stacks;
+        std::vector<Stack*> in_stacks;
+        for (int i = 0; i < 32; ++i)
+        {
+            otio::SerializableObject::Retainer<otio::Track> tr_over =
+                new otio::Track();
+            tr_over->append_child(
+                new otio::Clip("track1_A", nullptr, tr_0_150_24));
+
+            otio::SerializableObject::Retainer<otio::Track> tr_under =
+                new otio::Track();
+            tr_under->append_child(
+                new otio::Clip("track1_B", nullptr, tr_0_150_24));
+            tr_under->append_child(
+                new otio::Clip("track1_C", nullptr, tr_0_150_24));
+
+            otio::SerializableObject::Retainer<otio::Stack> st =
+                new otio::Stack();
+            st->append_child(tr_under);
+            st->append_child(tr_over);
+            if (i % 4 == 3)
+            {
+                st->append_child(
+                    new otio::Clip("not_a_track", nullptr, tr_0_150_24));
+            }
+            stacks.push_back(st);
+            in_stacks.push_back(st);
+        }
+
+        otio::ThreadPool pool(4);
+        otio::ErrorStatus err;
+        auto results = flatten_stacks(in_stacks, &err, &pool);
+
+        assertEqual(results.size(), in_stacks.size());
+        assertTrue(otio::is_error(err));
+        assertEqual(err.outcome, otio::ErrorStatus::TYPE_MISMATCH);
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            if (i % 4 == 3)
+            {
+                assertEqual(results[i], nullptr);
+                continue;
+            }
+
+            otio::SerializableObject::Retainer<otio::Track> result =
+                results[i];
+            assertEqual(
+                result->children()[0]->name(),
+                std::string("track1_A"));
+            assertEqual(result->children().size(), 2);
+            assertEqual(result->duration().value(), 300);
+        }
+    });
+
+    tests.add_test(
+        "test_flatten_stack_parallel_range_maps", [] {
+        using namespace otio;
+
+        otio::RationalTime rt_0_24{0, 24};
+        otio::RationalTime rt_10_24{10, 24};
+        otio::TimeRange tr_0_10_24{rt_0_24, rt_10_24};
+
+        // enough children to precompute the range maps on the pool:
+        // the top track has a gap every hundred clips.
+        otio::SerializableObject::Retainer<otio::Track> tr_over =
+            new otio::Track();
+        otio::SerializableObject::Retainer<otio::Track> tr_under =
+            new otio::Track();
+        for (int i = 0; i < 1000; ++i)
+        {
+            if (i % 100 == 50)
+            {
+                tr_over->append_child(new otio::Gap(tr_0_10_24));
+            }
+            else
+            {
+                tr_over->append_child(
+                    new otio::Clip("over", nullptr, tr_0_10_24));
+            }
+            tr_under->append_child(
+                new otio::Clip("under", nullptr, tr_0_10_24));
+        }
+
+        otio::SerializableObject::Retainer<otio::Stack> st =
+            new otio::Stack();
+        st->append_child(tr_under);
+        st->append_child(tr_over);
+
+        otio::ErrorStatus err;
+        otio::SerializableObject::Retainer<otio::Track> result =
+            flatten_stack(st, &err);
+
+        assertFalse(otio::is_error(err));
+        assertEqual(result->children().size(), 1000);
+        assertEqual(result->duration().value(), 10000);
+        for (int i = 0; i < 1000; ++i)
+        {
+            assertEqual(
+                result->children()[i]->name(),
+                std::string(i % 100 == 50 ? "under" : "over"));
+        }
+    });
+
     tests.run(argc, argv);
     return 0;
 }
\ No newline at end of file
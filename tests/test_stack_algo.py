@@ -556,6 +556,26 @@ class StackAlgoTests(unittest.TestCase, otio_test_utils.OTIOAssertions):
             flattened_track
         )
 
+    def test_flatten_stacks(self):
+        timelines = [
+            otio.adapters.read_from_file(MULTITRACK_EXAMPLE_PATH)
+            for _ in range(8)
+        ]
+        flat_tracks = otio.algorithms.flatten_stacks(
+            [timeline.tracks for timeline in timelines]
+        )
+        self.assertEqual(len(flat_tracks), len(timelines))
+
+        for timeline, flat_track in zip(timelines, flat_tracks):
+            self.assertIsOTIOEquivalentTo(
+                flat_track,
+                otio.algorithms.flatten_stack(timeline.tracks)
+            )
+
+        bad_stack = otio.schema.Stack(children=[otio.schema.Clip()])
+        with self.assertRaises(ValueError):
+            otio.algorithms.flatten_stacks([timelines[0].tracks, bad_stack])
+
     def assertOTIOEqual(self, a, b):
         self.maxDiff = None
         self.assertMultiLineEqual(
@@ -0,0 +1,305 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "utils.h"
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/externalReference.h>
+#include <opentimelineio/gap.h>
+#include <opentimelineio/parallelFind.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/threadPool.h>
+#include <opentimelineio/timeline.h>
+#include <opentimelineio/track.h>
+
+#include <thread>
+
+namespace otime = opentime::OPENTIME_VERSION;
+namespace otio  = opentimelineio::OPENTIMELINEIO_VERSION;
+
+namespace {
+
+// Run read on thread_count threads at once, iterations times each.
+void
+run_concurrently(
+    std::function<void()> const& read,
+    int                          thread_count = 8,
+    int                          iterations   = 50)
+{
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&read, iterations] {
+            for (int i = 0; i < iterations; ++i)
+            {
+                read();
+            }
+        });
+    }
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+}
+
+// A timeline of three tracks of clips and gaps, the last of which holds a
+// nested stack.
+otio::SerializableObject::Retainer<otio::Timeline>
+make_timeline()
+{
+    otio::SerializableObject::Retainer<otio::Timeline> timeline(
+        new otio::Timeline("timeline"));
+    for (int t = 0; t < 3; ++t)
+    {
+        otio::Track* track = new otio::Track("track" + std::to_string(t));
+        for (int c = 0; c < 20; ++c)
+        {
+            otime::TimeRange range(
+                otime::RationalTime(c, 24),
+                otime::RationalTime(12 + c % 5, 24));
+            if (c % 7 == 3)
+            {
+                track->append_child(new otio::Gap(range));
+                continue;
+            }
+
+            otio::AnyDictionary metadata;
+            metadata["index"] = int64_t(c);
+            track->append_child(new otio::Clip(
+                "clip" + std::to_string(c),
+                new otio::ExternalReference(
+                    "file:///clip" + std::to_string(c) + ".mov"),
+                range,
+                metadata));
+        }
+        timeline->tracks()->append_child(track);
+    }
+
+    otio::Stack* nested = new otio::Stack("nested");
+    otio::Track* inner  = new otio::Track("inner");
+    inner->append_child(new otio::Clip(
+        "inner_clip",
+        nullptr,
+        otime::TimeRange(
+            otime::RationalTime(0, 24),
+            otime::RationalTime(48, 24))));
+    nested->append_child(inner);
+    otio::Track* last = dynamic_cast<otio::Track*>(
+        timeline->tracks()->children().back().value);
+    last->append_child(nested);
+    return timeline;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Tests tests;
+
+    tests.add_test("test_concurrent_range_of_all_children", [] {
+        auto timeline = make_timeline();
+        std::vector<std::map<otio::Composable*, otio::TimeRange>> expected;
+        for (auto const& child: timeline->tracks()->children())
+        {
+            auto track = dynamic_cast<otio::Track*>(child.value);
+            expected.push_back(track->range_of_all_children());
+        }
+        expected.push_back(timeline->tracks()->range_of_all_children());
+
+        run_concurrently([&] {
+            otio::ErrorStatus err;
+            auto const&       children = timeline->tracks()->children();
+            for (size_t i = 0; i < children.size(); ++i)
+            {
+                auto track = dynamic_cast<otio::Track*>(children[i].value);
+                assertTrue(track->range_of_all_children(&err) == expected[i]);
+            }
+            assertTrue(
+                timeline->tracks()->range_of_all_children(&err)
+                == expected.back());
+            assertFalse(otio::is_error(err));
+        });
+    });
+
+    tests.add_test("test_concurrent_find_children", [] {
+        auto   timeline         = make_timeline();
+        size_t clip_count       = timeline->find_clips().size();
+        size_t composable_count = timeline->find_children().size();
+        otime::TimeRange search_range(
+            otime::RationalTime(24, 24),
+            otime::RationalTime(48, 24));
+        size_t in_range_count =
+            timeline->find_clips(nullptr, search_range).size();
+
+        run_concurrently([&] {
+            otio::ErrorStatus err;
+            auto              clips = timeline->find_clips(&err);
+            assertEqual(clips.size(), clip_count);
+            assertEqual(timeline->find_children(&err).size(), composable_count);
+            assertEqual(
+                timeline->find_clips(&err, search_range).size(),
+                in_range_count);
+            assertFalse(otio::is_error(err));
+        });
+
+        // every retainer handed out on the reader threads has been released
+        for (auto const& clip: timeline->find_clips())
+        {
+            assertEqual(clip->current_ref_count(), 2);
+        }
+    });
+
+    tests.add_test("test_concurrent_child_at_time", [] {
+        auto timeline = make_timeline();
+        auto track    = dynamic_cast<otio::Track*>(
+            timeline->tracks()->children().front().value);
+        std::vector<otio::Composable*> expected;
+        for (int frame = 0; frame < 300; ++frame)
+        {
+            expected.push_back(
+                track->child_at_time(otime::RationalTime(frame, 24)).value);
+        }
+
+        run_concurrently([&] {
+            otio::ErrorStatus err;
+            for (int frame = 0; frame < 300; ++frame)
+            {
+                auto child =
+                    track->child_at_time(otime::RationalTime(frame, 24), &err);
+                assertTrue(child.value == expected[frame]);
+            }
+            assertFalse(otio::is_error(err));
+        });
+    });
+
+    tests.add_test("test_concurrent_transformed_time", [] {
+        auto timeline = make_timeline();
+        auto clips    = timeline->find_clips();
+        auto root     = timeline->tracks();
+        std::vector<otime::RationalTime> expected;
+        for (auto const& clip: clips)
+        {
+            expected.push_back(
+                root->transformed_time(otime::RationalTime(10, 24), clip));
+        }
+
+        run_concurrently([&] {
+            otio::ErrorStatus err;
+            for (size_t i = 0; i < clips.size(); ++i)
+            {
+                auto time = root->transformed_time(
+                    otime::RationalTime(10, 24),
+                    clips[i],
+                    &err);
+                assertTrue(time == expected[i]);
+            }
+            assertFalse(otio::is_error(err));
+        });
+    });
+
+    tests.add_test("test_concurrent_serialization", [] {
+        auto        timeline = make_timeline();
+        std::string expected = timeline->to_json_string();
+        otio::SerializableObject::Retainer<otio::SerializableObject> copy(
+            timeline->clone());
+
+        run_concurrently(
+            [&] {
+                otio::ErrorStatus err;
+                assertTrue(timeline->to_json_string(&err) == expected);
+                assertTrue(timeline->is_equivalent_to(*copy));
+                assertTrue(copy->is_equivalent_to(*timeline));
+                assertFalse(otio::is_error(err));
+            },
+            8,
+            10);
+    });
+
+    tests.add_test("test_concurrent_type_record_lookup", [] {
+        // objects built in C++ look up their type record the first time it
+        // is needed, which here happens on all the threads at once.
+        for (int i = 0; i < 20; ++i)
+        {
+            auto timeline = make_timeline();
+            run_concurrently(
+                [&] {
+                    for (auto const& clip: timeline->find_clips())
+                    {
+                        assertEqual(clip->schema_name(), std::string("Clip"));
+                    }
+                },
+                4,
+                1);
+        }
+    });
+
+    tests.add_test("test_visit_children", [] {
+        auto timeline = make_timeline();
+        auto children = timeline->tracks()->find_children();
+
+        std::vector<otio::Composable*> visited;
+        assertTrue(timeline->tracks()->visit_children([&](otio::Composable* c) {
+            visited.push_back(c);
+            return true;
+        }));
+        assertEqual(visited.size(), children.size());
+        for (size_t i = 0; i < visited.size(); ++i)
+        {
+            assertTrue(visited[i] == children[i].value);
+        }
+
+        // returning false stops the search
+        size_t count = 0;
+        assertFalse(timeline->tracks()->visit_children([&](otio::Composable*) {
+            return ++count < 5;
+        }));
+        assertEqual(count, size_t(5));
+    });
+
+    tests.add_test("test_parallel_find_children", [] {
+        auto             timeline = make_timeline();
+        auto             root     = timeline->tracks();
+        otio::ThreadPool pool(4);
+
+        auto expected = root->find_children<otio::Clip>();
+        auto found    = otio::parallel_find_children<otio::Clip>(
+            root,
+            nullptr,
+            std::nullopt,
+            &pool);
+        assertEqual(found.size(), expected.size());
+        for (size_t i = 0; i < found.size(); ++i)
+        {
+            assertTrue(found[i].value == expected[i].value);
+        }
+
+        otime::TimeRange search_range(
+            otime::RationalTime(30, 24),
+            otime::RationalTime(100, 24));
+        auto expected_in_range = root->find_children(nullptr, search_range);
+        otio::ErrorStatus err;
+        auto found_in_range =
+            otio::parallel_find_children(root, &err, search_range, &pool);
+        assertFalse(otio::is_error(err));
+        assertEqual(found_in_range.size(), expected_in_range.size());
+        for (size_t i = 0; i < found_in_range.size(); ++i)
+        {
+            assertTrue(found_in_range[i].value == expected_in_range[i].value);
+        }
+
+        // a single track is split into slices
+        auto track = dynamic_cast<otio::Track*>(root->children()[0].value);
+        auto expected_in_track = track->find_children();
+        auto found_in_track =
+            otio::parallel_find_children(track, nullptr, std::nullopt, &pool);
+        assertEqual(found_in_track.size(), expected_in_track.size());
+        for (size_t i = 0; i < found_in_track.size(); ++i)
+        {
+            assertTrue(found_in_track[i].value == expected_in_track[i].value);
+        }
+    });
+
+    tests.run(argc, argv);
+    return 0;
+}
@@ -4,7 +4,15 @@
 #include "utils.h"
 
 #include <opentimelineio/clip.h>
+#include <opentimelineio/clipTable.h>
+#include <opentimelineio/externalReference.h>
+#include <opentimelineio/freezeFrame.h>
+#include <opentimelineio/gap.h>
+#include <opentimelineio/playbackSchedule.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/timeWarpEvaluator.h>
 #include <opentimelineio/timeline.h>
+#include <opentimelineio/timelineSnapshotter.h>
 #include <opentimelineio/track.h>
 
 #include <iostream>
@@ -78,6 +86,318 @@ main(int argc, char** argv)
         assertEqual(result[0].value, cl.value);
     });
 
+    tests.add_test(
+        "test_clip_table", [] {
+        using namespace otio;
+        const TimeRange range(RationalTime(10.0, 24.0), RationalTime(24.0, 24.0));
+
+        SerializableObject::Retainer<Clip> a =
+            new Clip("a", new ExternalReference("file:///a.mov"), range);
+        a->metadata()["shot"] = std::string("010");
+        a->metadata()["take"] = int64_t(3);
+        SerializableObject::Retainer<Clip> b = new Clip("b", nullptr, range);
+        SerializableObject::Retainer<Clip> c =
+            new Clip("c", new ExternalReference("file:///a.mov"), range);
+        SerializableObject::Retainer<Clip> d = new Clip("a", nullptr, range);
+
+        SerializableObject::Retainer<Stack> nested = new Stack("nested");
+        nested->append_child(c);
+        SerializableObject::Retainer<Track> v1 = new Track("V1");
+        v1->append_child(a);
+        v1->append_child(new Gap(range));
+        v1->append_child(b);
+        v1->append_child(nested);
+        SerializableObject::Retainer<Track> v2 = new Track("V2");
+        v2->append_child(d);
+        SerializableObject::Retainer<Timeline> tl = new Timeline();
+        tl->tracks()->append_child(v1);
+        tl->tracks()->append_child(v2);
+
+        otio::ErrorStatus err;
+        auto table = clip_table(tl, { "shot", "take" }, &err);
+        assertFalse(is_error(err));
+
+        // one row per clip, in find_clips() order
+        auto clips = tl->find_clips(&err);
+        assertEqual(table.size(), clips.size());
+        for (size_t i = 0; i < clips.size(); ++i)
+        {
+            assertEqual(table.clips[i], clips[i].value);
+            assertEqual(
+                table.strings[table.name[i]],
+                clips[i]->name());
+        }
+
+        // the root, both tracks and the nested stack
+        assertEqual(table.compositions.size(), 4);
+        assertEqual(table.composition_parent[0], -1);
+        assertEqual(table.strings[table.composition_kind[2]], std::string("Stack"));
+        assertEqual(table.composition_parent[2], 1);
+
+        // names and URLs are interned
+        assertEqual(table.name[0], table.name[3]);
+        assertEqual(table.media_url[0], table.media_url[2]);
+        assertEqual(table.strings[table.media_url[0]], std::string("file:///a.mov"));
+        assertEqual(table.media_url[1], -1);
+
+        assertEqual(table.parent_index[2], 2);
+        assertEqual(table.track_index[2], 1);
+        assertEqual(table.track_index[3], 3);
+
+        assertEqual(table.trimmed_start[1], 10.0);
+        assertEqual(table.trimmed_duration[1], 24.0);
+        assertEqual(table.trimmed_rate[1], 24.0);
+        assertEqual(table.range_in_parent_start[1], 48.0);
+        assertEqual(table.range_in_parent_duration[1], 24.0);
+        assertEqual(table.range_in_parent_start[2], 0.0);
+
+        assertEqual(table.metadata.size(), 2);
+        assertEqual(table.strings[table.metadata[0][0]], std::string("010"));
+        assertEqual(table.metadata[0][1], -1);
+        assertEqual(table.metadata[1][0], -1);
+    });
+
+    tests.add_test(
+        "test_time_warp_evaluator", [] {
+        using namespace otio;
+        auto range = [](double start, double duration) {
+            return TimeRange(
+                RationalTime(start, 24.0),
+                RationalTime(duration, 24.0));
+        };
+
+        SerializableObject::Retainer<Clip> a = new Clip("a", nullptr, range(0, 24));
+        SerializableObject::Retainer<Clip> b =
+            new Clip("b", nullptr, range(100, 24), AnyDictionary(),
+                     { new LinearTimeWarp("fast", "", 2.0) });
+        SerializableObject::Retainer<Clip> c =
+            new Clip("c", nullptr, range(50, 24), AnyDictionary(),
+                     { new FreezeFrame() });
+        SerializableObject::Retainer<Clip> d =
+            new Clip("d", nullptr, range(1000, 48));
+
+        // plays d at half speed starting 10 frames in
+        SerializableObject::Retainer<Stack> nested = new Stack(
+            "nested", range(10, 24), AnyDictionary(),
+            { new LinearTimeWarp("slow", "", 0.5) });
+        nested->append_child(d);
+
+        SerializableObject::Retainer<Track> tr = new Track();
+        tr->append_child(a);
+        tr->append_child(b);
+        tr->append_child(c);
+        tr->append_child(nested);
+        SerializableObject::Retainer<Timeline> tl = new Timeline();
+        tl->tracks()->append_child(tr);
+
+        otio::ErrorStatus err;
+        TimeWarpEvaluator evaluator(tl, &err);
+        assertFalse(is_error(err));
+        assertEqual(evaluator.mappings().size(), 4);
+        assertEqual(evaluator.mappings()[3].clip, (Clip const*)d.value);
+
+        auto t = [&](Clip* clip, double frame) {
+            auto result = evaluator.source_time(clip, RationalTime(frame, 24.0));
+            return result ? result->value() : -1.0;
+        };
+        assertEqual(t(a, 5), 5.0);
+        assertEqual(t(b, 30), 112.0);
+        assertEqual(t(b, 50), -1.0);
+        assertEqual(t(c, 48), 50.0);
+        assertEqual(t(c, 70), 50.0);
+        assertEqual(t(d, 80), 1014.0);
+        assertEqual(
+            evaluator.mapping(d)->range_in_root,
+            range(72, 24));
+
+        // must match the untransformed path when there are no effects
+        assertEqual(
+            t(a, 5),
+            tl->tracks()->transformed_time(RationalTime(5, 24), a, &err).value());
+
+        double const root_frames[] = { 24, 30, 47, 48 };
+        double       frames[4];
+        uint8_t      valid[4];
+        assertEqual(evaluator.source_frames(b, root_frames, 4, 24, frames, valid), 3);
+        assertEqual(frames[0], 100.0);
+        assertEqual(frames[1], 112.0);
+        assertEqual(frames[2], 146.0);
+        assertEqual(int(valid[2]), 1);
+        assertEqual(int(valid[3]), 0);
+
+        // the same times at a different rate
+        double const root_seconds[] = { 1.25 };
+        evaluator.source_frames(b, root_seconds, 1, 1, frames);
+        assertEqual(frames[0], 112.0);
+
+        // unknown time effects cannot be evaluated
+        a->effects().push_back(new TimeEffect());
+        TimeWarpEvaluator failed(tl, &err);
+        assertEqual(err.outcome, otio::ErrorStatus::NOT_IMPLEMENTED);
+        assertEqual(failed.mappings().size(), 0);
+    });
+
+    tests.add_test(
+        "test_playback_schedule", [] {
+        using namespace otio;
+        auto range = [](double start, double duration) {
+            return TimeRange(
+                RationalTime(start, 24.0),
+                RationalTime(duration, 24.0));
+        };
+
+        SerializableObject::Retainer<Clip> a =
+            new Clip("a", new ExternalReference("file:///a.mov"), range(100, 24));
+        SerializableObject::Retainer<Clip> b = new Clip("b", nullptr, range(0, 24));
+        SerializableObject::Retainer<Clip> c = new Clip("c", nullptr, range(0, 24));
+        SerializableObject::Retainer<Transition> dissolve = new Transition(
+            "dissolve", "SMPTE_Dissolve", RationalTime(6, 24), RationalTime(6, 24));
+        SerializableObject::Retainer<Track> v1 = new Track("V1");
+        v1->append_child(a);
+        v1->append_child(dissolve);
+        v1->append_child(b);
+        v1->append_child(new Gap(range(0, 24)));
+        v1->append_child(c);
+        SerializableObject::Retainer<Track> a1 = new Track("A1", std::nullopt, Track::Kind::audio);
+        SerializableObject::Retainer<Timeline> tl = new Timeline();
+        tl->tracks()->append_child(v1);
+        tl->tracks()->append_child(a1);
+
+        otio::ErrorStatus err;
+        PlaybackSchedule schedule(tl, &err);
+        assertFalse(is_error(err));
+        assertEqual(schedule.track_count(), 2);
+        assertEqual(schedule.track(0).segments.size(), 3);
+        assertEqual(schedule.track(1).segments.size(), 0);
+
+        auto segment = schedule.segment_at(0, RationalTime(10, 24));
+        assertTrue(segment != nullptr);
+        assertEqual(segment->item, (Item const*)a.value);
+        assertEqual(segment->media_reference, (MediaReference const*)a->media_reference());
+        assertEqual(segment->out_transition, (Transition const*)dissolve.value);
+        assertEqual((RationalTime(10, 24) + segment->source_offset).value(), 110.0);
+
+        segment = schedule.segment_at(0, RationalTime(30, 24));
+        assertEqual(segment->clip, (Clip const*)b.value);
+        assertEqual(segment->in_transition, (Transition const*)dissolve.value);
+        assertTrue(schedule.segment_at(0, RationalTime(50, 24)) == nullptr);
+        assertTrue(schedule.segment_at(0, RationalTime(96, 24)) == nullptr);
+        assertTrue(schedule.segment_at(0, RationalTime(-1, 24)) == nullptr);
+        assertTrue(schedule.segment_at(1, RationalTime(0, 24)) == nullptr);
+
+        // stepping a cursor through every frame finds the same segments
+        PlaybackSchedule::Cursor cursor(schedule, 0);
+        for (int frame = -2; frame < 100; ++frame)
+        {
+            assertTrue(
+                cursor.segment_at(RationalTime(frame, 24))
+                == schedule.segment_at(0, RationalTime(frame, 24)));
+        }
+        assertEqual(cursor.segment_at(RationalTime(1, 24))->clip, (Clip const*)a.value);
+
+        // rebuilding picks up changes to the track
+        v1->remove_child(3);
+        assertTrue(schedule.rebuild_track(0, &err));
+        assertEqual(schedule.segment_at(0, RationalTime(50, 24))->clip, (Clip const*)c.value);
+        assertEqual(cursor.segment_at(RationalTime(50, 24))->clip, (Clip const*)c.value);
+
+        // updating rebuilds only the tracks that changed
+        auto const* v1_segments = schedule.track(0).segments.data();
+        a1->append_child(new Clip("music", nullptr, range(0, 48)));
+        assertTrue(schedule.update(&err));
+        assertEqual(schedule.track(0).segments.data(), v1_segments);
+        assertEqual(schedule.track(1).segments.size(), 1);
+
+        c->set_source_range(range(0, 12));
+        assertTrue(schedule.update(&err));
+        assertTrue(schedule.segment_at(0, RationalTime(62, 24)) == nullptr);
+
+        SerializableObject::Retainer<Track> v2 = new Track("V2");
+        v2->append_child(new Clip("title", nullptr, range(0, 24)));
+        tl->tracks()->insert_child(1, v2);
+        assertTrue(schedule.update(&err));
+        assertEqual(schedule.track_count(), 3);
+        assertEqual(schedule.track(1).track, (Track const*)v2.value);
+        assertEqual(schedule.track(2).segments.size(), 1);
+    });
+
+    tests.add_test(
+        "test_timeline_snapshotter", [] {
+        using namespace otio;
+        const TimeRange range(RationalTime(0.0, 24.0), RationalTime(24.0, 24.0));
+        SerializableObject::Retainer<Track> v1 = new Track("V1");
+        v1->append_child(new Clip("a", nullptr, range));
+        SerializableObject::Retainer<Track> v2 = new Track("V2");
+        v2->append_child(new Clip("b", nullptr, range));
+        SerializableObject::Retainer<Timeline> tl = new Timeline("edit");
+        tl->tracks()->append_child(v1);
+        tl->tracks()->append_child(v2);
+
+        otio::ErrorStatus err;
+        TimelineSnapshotter snapshotter(tl);
+        auto first = snapshotter.snapshot(&err);
+        assertFalse(is_error(err));
+        assertTrue(first->is_equivalent_to(*tl));
+        assertTrue(first.value != tl.value);
+
+        // nothing changed: the same snapshot comes back
+        assertEqual(snapshotter.snapshot(&err).value, first.value);
+
+        // while a reader holds the first snapshot, editing and taking
+        // another snapshot leaves it alone, and shares the tracks that did
+        // not change with it rather than cloning them
+        v2->append_child(new Clip("c", nullptr, range));
+        auto second = snapshotter.snapshot(&err);
+        assertTrue(second.value != first.value);
+        assertTrue(second->is_equivalent_to(*tl));
+        assertFalse(first->is_equivalent_to(*tl));
+        assertEqual(first->tracks()->children().size(), 2);
+        Composable* first_v1 = first->tracks()->children()[0];
+        assertEqual(second->tracks()->children()[0].value, first_v1);
+        assertTrue(
+            second->tracks()->children()[1].value
+            != first->tracks()->children()[1].value);
+
+        // shared tracks keep their parent, and are children of both stacks
+        assertEqual(
+            first_v1->parent(),
+            static_cast<Composition*>(first->tracks()));
+        assertEqual(second->tracks()->index_of_child(first_v1, &err), 0);
+        assertEqual(second->tracks()->range_of_child(first_v1, &err), range);
+        assertFalse(is_error(err));
+
+        // the first snapshot's stack outlives it while its tracks are
+        // shared
+        first = nullptr;
+        v2->set_name("V2 renamed");
+        auto third = snapshotter.snapshot(&err);
+        assertTrue(third->is_equivalent_to(*tl));
+        assertEqual(third->tracks()->children()[0].value, first_v1);
+        assertTrue(first_v1->parent() != nullptr);
+        auto clip_a =
+            dynamic_cast<Item*>(
+                static_cast<Track*>(first_v1)->children()[0].value);
+        assertEqual(clip_a->range_in_parent(&err), range);
+        assertFalse(is_error(err));
+
+        // a change to the stack's own fields clones every track again
+        tl->tracks()->set_name("stack renamed");
+        auto fourth_tracks = snapshotter.snapshot(&err);
+        assertTrue(fourth_tracks->is_equivalent_to(*tl));
+        assertTrue(fourth_tracks->tracks()->children()[0].value != first_v1);
+        assertEqual(
+            fourth_tracks->tracks()->children()[0]->parent(),
+            static_cast<Composition*>(fourth_tracks->tracks()));
+
+        tl->set_name("renamed");
+        tl->dynamic_fields()["extra"] = std::string("kept");
+        tl->tracks()->dynamic_fields()["stack extra"] = int64_t(1);
+        auto fourth = snapshotter.snapshot(&err);
+        assertEqual(fourth->name(), std::string("renamed"));
+        assertTrue(fourth->is_equivalent_to(*tl));
+        assertEqual(fourth->to_json_string(), tl->to_json_string());
+    });
+
     tests.run(argc, argv);
     return 0;
 }
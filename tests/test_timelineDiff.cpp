@@ -0,0 +1,258 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "utils.h"
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/externalReference.h>
+#include <opentimelineio/linearTimeWarp.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/threadPool.h>
+#include <opentimelineio/timeline.h>
+#include <opentimelineio/timelineDiff.h>
+#include <opentimelineio/track.h>
+#include <opentimelineio/transition.h>
+
+#include <iostream>
+#include <string>
+
+namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
+
+namespace {
+
+using Kind = otio::ChildDifference::Kind;
+
+otio::TimeRange const range(
+    otio::RationalTime(0, 24),
+    otio::RationalTime(24, 24));
+
+otio::Clip*
+make_clip(std::string const& name)
+{
+    return new otio::Clip(
+        name,
+        new otio::ExternalReference("file:///media/" + name + ".mov"),
+        range);
+}
+
+otio::Track*
+make_track(std::string const& name, int clips)
+{
+    auto track = new otio::Track(name);
+    for (int c = 0; c < clips; ++c)
+    {
+        track->append_child(make_clip(name + "_" + std::to_string(c)));
+    }
+    return track;
+}
+
+otio::Track*
+track_at(otio::Timeline* timeline, int index)
+{
+    return dynamic_cast<otio::Track*>(
+        timeline->tracks()->children()[index].value);
+}
+
+otio::Timeline*
+copy_of(otio::Timeline* timeline)
+{
+    return dynamic_cast<otio::Timeline*>(timeline->clone());
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Tests tests;
+
+    tests.add_test("test_no_differences", [] {
+        otio::SerializableObject::Retainer<otio::Track> track =
+            make_track("V1", 10);
+        otio::SerializableObject::Retainer<otio::Track> copy =
+            dynamic_cast<otio::Track*>(track->clone());
+        assertTrue(otio::diff_tracks(track, copy).empty());
+        assertTrue(otio::diff_tracks(nullptr, nullptr).empty());
+    });
+
+    tests.add_test("test_insert_delete", [] {
+        otio::SerializableObject::Retainer<otio::Track> old_track =
+            make_track("V1", 5);
+        otio::SerializableObject::Retainer<otio::Track> new_track =
+            dynamic_cast<otio::Track*>(old_track->clone());
+        new_track->remove_child(1);
+        new_track->insert_child(3, make_clip("inserted"));
+
+        auto differences = otio::diff_tracks(old_track, new_track);
+        assertEqual(differences.size(), size_t(2));
+        assertEqual(differences[0].kind, Kind::deleted);
+        assertEqual(differences[0].old_index, 1);
+        assertEqual(differences[0].old_child->name(), std::string("V1_1"));
+        assertFalse(differences[0].new_child);
+        assertEqual(differences[1].kind, Kind::inserted);
+        assertEqual(differences[1].new_index, 3);
+        assertEqual(differences[1].new_child->name(), std::string("inserted"));
+        assertFalse(differences[1].old_child);
+
+        // the same name with other media is another clip
+        new_track = dynamic_cast<otio::Track*>(old_track->clone());
+        dynamic_cast<otio::Clip*>(new_track->children()[2].value)
+            ->set_media_reference(new otio::ExternalReference("other.mov"));
+        differences = otio::diff_tracks(old_track, new_track);
+        assertEqual(differences.size(), size_t(2));
+        assertEqual(differences[0].kind, Kind::deleted);
+        assertEqual(differences[1].kind, Kind::inserted);
+
+        // a whole track added or removed
+        differences = otio::diff_tracks(nullptr, new_track);
+        assertEqual(differences.size(), size_t(5));
+        assertEqual(differences[4].kind, Kind::inserted);
+        differences = otio::diff_tracks(old_track, nullptr);
+        assertEqual(differences.size(), size_t(5));
+        assertEqual(differences[4].kind, Kind::deleted);
+    });
+
+    tests.add_test("test_trim_retime", [] {
+        otio::SerializableObject::Retainer<otio::Track> old_track =
+            make_track("V1", 4);
+        old_track->insert_child(
+            2,
+            new otio::Transition(
+                "dissolve",
+                otio::Transition::Type::SMPTE_Dissolve,
+                otio::RationalTime(6, 24),
+                otio::RationalTime(6, 24)));
+        otio::SerializableObject::Retainer<otio::Track> new_track =
+            dynamic_cast<otio::Track*>(old_track->clone());
+
+        auto first = dynamic_cast<otio::Clip*>(new_track->children()[0].value);
+        first->set_source_range(otio::TimeRange(
+            otio::RationalTime(0, 24),
+            otio::RationalTime(12, 24)));
+        auto last = dynamic_cast<otio::Clip*>(new_track->children()[4].value);
+        last->effects().push_back(new otio::LinearTimeWarp("", "", 2.0));
+        dynamic_cast<otio::Transition*>(new_track->children()[2].value)
+            ->set_in_offset(otio::RationalTime(12, 24));
+
+        auto differences = otio::diff_tracks(old_track, new_track);
+        assertEqual(differences.size(), size_t(3));
+        assertEqual(differences[0].kind, Kind::changed);
+        assertEqual(differences[0].new_index, 0);
+        assertTrue(differences[0].trimmed);
+        assertFalse(differences[0].retimed);
+        assertEqual(differences[1].kind, Kind::changed);
+        assertEqual(differences[1].new_index, 2);
+        assertTrue(differences[1].trimmed);
+        assertEqual(differences[2].kind, Kind::changed);
+        assertEqual(differences[2].new_index, 4);
+        assertFalse(differences[2].trimmed);
+        assertTrue(differences[2].retimed);
+
+        // a change of speed is a retime too
+        old_track = dynamic_cast<otio::Track*>(new_track->clone());
+        dynamic_cast<otio::LinearTimeWarp*>(last->effects()[0].value)
+            ->set_time_scalar(0.5);
+        differences = otio::diff_tracks(old_track, new_track);
+        assertEqual(differences.size(), size_t(1));
+        assertTrue(differences[0].retimed);
+    });
+
+    tests.add_test("test_moves", [] {
+        otio::SerializableObject::Retainer<otio::Track> old_track =
+            make_track("V1", 6);
+        otio::SerializableObject::Retainer<otio::Track> new_track =
+            dynamic_cast<otio::Track*>(old_track->clone());
+        otio::SerializableObject::Retainer<otio::Composable> child =
+            new_track->children()[1];
+        new_track->remove_child(1);
+        new_track->insert_child(4, child);
+        dynamic_cast<otio::Clip*>(child.value)
+            ->set_source_range(otio::TimeRange(
+                otio::RationalTime(6, 24),
+                otio::RationalTime(12, 24)));
+
+        auto differences = otio::diff_tracks(old_track, new_track);
+        assertEqual(differences.size(), size_t(1));
+        assertEqual(differences[0].kind, Kind::moved);
+        assertEqual(differences[0].old_index, 1);
+        assertEqual(differences[0].new_index, 4);
+        assertTrue(differences[0].trimmed);
+        assertTrue(differences[0].new_child.value == child.value);
+    });
+
+    tests.add_test("test_timelines", [] {
+        otio::SerializableObject::Retainer<otio::Timeline> old_timeline =
+            new otio::Timeline("timeline");
+        for (int t = 0; t < 3; ++t)
+        {
+            old_timeline->tracks()->append_child(
+                make_track("V" + std::to_string(t + 1), 8));
+        }
+        otio::SerializableObject::Retainer<otio::Timeline> new_timeline =
+            copy_of(old_timeline);
+
+        // move a clip from the first track to the third, edit the second
+        // and add a fourth track
+        otio::SerializableObject::Retainer<otio::Composable> child =
+            track_at(new_timeline, 0)->children()[5];
+        track_at(new_timeline, 0)->remove_child(5);
+        track_at(new_timeline, 2)->insert_child(0, child);
+        track_at(new_timeline, 1)->remove_child(7);
+        new_timeline->tracks()->append_child(make_track("V4", 2));
+
+        otio::ThreadPool pool(4);
+        auto differences =
+            otio::diff_timelines(old_timeline, new_timeline, &pool);
+        assertEqual(differences.size(), size_t(4));
+        assertEqual(differences[0].kind, Kind::deleted);
+        assertEqual(differences[0].old_track, 1);
+        assertEqual(differences[0].old_index, 7);
+        assertEqual(differences[1].kind, Kind::moved);
+        assertEqual(differences[1].old_track, 0);
+        assertEqual(differences[1].old_index, 5);
+        assertEqual(differences[1].new_track, 2);
+        assertEqual(differences[1].new_index, 0);
+        assertFalse(differences[1].trimmed || differences[1].retimed);
+        assertEqual(differences[2].kind, Kind::inserted);
+        assertEqual(differences[2].new_track, 3);
+        assertEqual(differences[3].kind, Kind::inserted);
+        assertEqual(differences[3].new_index, 1);
+
+        assertEqual(
+            otio::diff_timelines(new_timeline, new_timeline).size(),
+            size_t(0));
+    });
+
+    tests.add_test("test_long_track", [] {
+        otio::SerializableObject::Retainer<otio::Track> old_track =
+            make_track("V1", 20000);
+        otio::SerializableObject::Retainer<otio::Track> new_track =
+            dynamic_cast<otio::Track*>(old_track->clone());
+        for (int i = 0; i < 20; ++i)
+        {
+            new_track->remove_child(i * 900);
+            new_track->insert_child(
+                i * 900 + 450,
+                make_clip("inserted_" + std::to_string(i)));
+        }
+
+        auto differences = otio::diff_tracks(old_track, new_track);
+        assertEqual(differences.size(), size_t(40));
+        int inserted = 0;
+        int previous = -1;
+        for (auto const& difference: differences)
+        {
+            assertTrue(difference.kind != Kind::moved);
+            if (difference.kind == Kind::inserted)
+            {
+                ++inserted;
+                assertTrue(difference.new_index > previous);
+                previous = difference.new_index;
+            }
+        }
+        assertEqual(inserted, 20);
+    });
+
+    tests.run(argc, argv);
+    return 0;
+}
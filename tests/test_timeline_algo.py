@@ -7,6 +7,11 @@
 
 import unittest
 
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
 import opentimelineio as otio
 import opentimelineio.test_utils as otio_test_utils
 
@@ -354,5 +359,133 @@ class TimelineTrimmingTests(unittest.TestCase, otio_test_utils.OTIOAssertions):
         self.assertJsonEqual(expected, trimmed)
 
 
+class ClipTableTests(unittest.TestCase):
+    """ test harness for the clip_table function """
+
+    @unittest.skipIf(numpy is None, "requires numpy")
+    def test_clip_table(self):
+        rng = otio.opentime.TimeRange(
+            otio.opentime.RationalTime(10, 24),
+            otio.opentime.RationalTime(24, 24)
+        )
+        a = otio.schema.Clip(
+            name="a",
+            media_reference=otio.schema.ExternalReference("file:///a.mov"),
+            source_range=rng,
+            metadata={"shot": "010"}
+        )
+        b = otio.schema.Clip(name="b", source_range=rng)
+        tr = otio.schema.Track(name="V1")
+        tr.extend([a, otio.schema.Gap(source_range=rng), b])
+        tl = otio.schema.Timeline(tracks=[tr])
+
+        table = otio.algorithms.clip_table(tl, metadata_keys=["shot"])
+        strings = table["strings"]
+
+        self.assertEqual(
+            [strings[i] for i in table["name"]],
+            [cl.name for cl in tl.find_clips()]
+        )
+        self.assertEqual(strings[table["media_url"][0]], "file:///a.mov")
+        self.assertEqual(table["media_url"][1], -1)
+        self.assertEqual(list(table["trimmed_start"]), [10, 10])
+        self.assertEqual(list(table["range_in_parent_start"]), [0, 48])
+        self.assertEqual(list(table["track_index"]), [1, 1])
+        self.assertEqual(strings[table["metadata"]["shot"][0]], "010")
+        self.assertEqual(table["metadata"]["shot"][1], -1)
+
+        # the stack can be given directly, too
+        table = otio.algorithms.clip_table(tl.tracks)
+        self.assertEqual(len(table["name"]), 2)
+
+
+class TimeWarpEvaluatorTests(unittest.TestCase):
+    """ test harness for TimeWarpEvaluator """
+
+    def make_timeline(self):
+        def rng(start, duration):
+            return otio.opentime.TimeRange(
+                otio.opentime.RationalTime(start, 24),
+                otio.opentime.RationalTime(duration, 24)
+            )
+
+        self.a = otio.schema.Clip(name="a", source_range=rng(0, 24))
+        self.b = otio.schema.Clip(
+            name="b",
+            source_range=rng(100, 24),
+            effects=[otio.schema.LinearTimeWarp(time_scalar=2)]
+        )
+        self.c = otio.schema.Clip(
+            name="c",
+            source_range=rng(50, 24),
+            effects=[otio.schema.FreezeFrame()]
+        )
+        tr = otio.schema.Track()
+        tr.extend([self.a, self.b, self.c])
+        return otio.schema.Timeline(tracks=[tr])
+
+    def test_source_time(self):
+        tl = self.make_timeline()
+        evaluator = otio.algorithms.TimeWarpEvaluator(tl)
+
+        def source_time(clip, frame):
+            return evaluator.source_time(
+                clip,
+                otio.opentime.RationalTime(frame, 24)
+            )
+
+        self.assertEqual(source_time(self.a, 5).value, 5)
+        self.assertEqual(source_time(self.b, 30).value, 112)
+        self.assertIsNone(source_time(self.b, 50))
+        self.assertEqual(source_time(self.c, 70).value, 50)
+        self.assertEqual(
+            evaluator.range_in_root(self.c).start_time.value,
+            48
+        )
+
+        self.assertIsNone(
+            evaluator.transform(otio.schema.Clip(name="elsewhere"))
+        )
+
+    def test_unsupported_time_effect(self):
+        tl = self.make_timeline()
+        self.a.effects.append(otio.schema.TimeEffect())
+        with self.assertRaises(NotImplementedError):
+            otio.algorithms.TimeWarpEvaluator(tl)
+
+    @unittest.skipIf(numpy is None, "requires numpy")
+    def test_source_frames(self):
+        tl = self.make_timeline()
+        evaluator = otio.algorithms.TimeWarpEvaluator(tl)
+
+        frames, valid = evaluator.source_frames(
+            self.b,
+            numpy.array([24, 30, 47, 48]),
+            24
+        )
+        self.assertEqual(list(frames[:3]), [100, 112, 146])
+        self.assertEqual(list(valid), [True, True, True, False])
+
+
+class TimelineSnapshotterTests(unittest.TestCase):
+    """ test harness for TimelineSnapshotter """
+
+    def test_snapshot(self):
+        tr = otio.schema.Track(name="V1")
+        tr.append(otio.schema.Clip(name="a"))
+        tl = otio.schema.Timeline(tracks=[tr])
+
+        snapshotter = otio.algorithms.TimelineSnapshotter(tl)
+        first = snapshotter.snapshot()
+        self.assertTrue(first.is_equivalent_to(tl))
+        self.assertIsNot(first, tl)
+        self.assertIs(snapshotter.snapshot(), first)
+
+        tr.append(otio.schema.Clip(name="b"))
+        second = snapshotter.snapshot()
+        self.assertTrue(second.is_equivalent_to(tl))
+        self.assertEqual(len(first.tracks[0]), 1)
+
+
 if __name__ == '__main__':
     unittest.main()
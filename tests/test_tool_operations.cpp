@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include "utils.h"
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/externalReference.h>
+#include <opentimelineio/gap.h>
+#include <opentimelineio/marker.h>
+#include <opentimelineio/toolOperations.h>
+#include <opentimelineio/transition.h>
+
+#include <iostream>
+
+namespace otime = opentime::OPENTIME_VERSION;
+namespace otio  = opentimelineio::OPENTIMELINEIO_VERSION;
+
+namespace {
+
+otime::TimeRange
+frames(int start, int duration)
+{
+    return otime::TimeRange(
+        otime::RationalTime(start, 24),
+        otime::RationalTime(duration, 24));
+}
+
+// V1: [A, transition, B, gap], V2: [C], A1: [D]
+otio::SerializableObject::Retainer<otio::Timeline>
+make_timeline()
+{
+    otio::SerializableObject::Retainer<otio::Timeline> timeline(
+        new otio::Timeline("timeline"));
+    timeline->metadata()["key"] = std::string("timeline");
+
+    otio::AnyDictionary metadata;
+    metadata["key"]   = std::string("value");
+    metadata["other"] = std::string("value");
+
+    auto v1 = new otio::Track("V1");
+    auto a  = new otio::Clip(
+        "A",
+        new otio::ExternalReference("file:///a.mov"),
+        frames(0, 24),
+        metadata);
+    a->markers().push_back(
+        new otio::Marker("marker", frames(0, 1), "RED", metadata));
+    v1->append_child(a);
+    v1->append_child(new otio::Transition(
+        "dissolve",
+        otio::Transition::Type::SMPTE_Dissolve,
+        otime::RationalTime(6, 24),
+        otime::RationalTime(6, 24)));
+    v1->append_child(new otio::Clip("B", nullptr, frames(0, 24), metadata));
+    v1->append_child(new otio::Gap(frames(0, 24)));
+
+    auto v2 = new otio::Track("V2");
+    v2->append_child(new otio::Clip("C", nullptr, frames(0, 72)));
+
+    auto a1 = new otio::Track("A1", std::nullopt, otio::Track::Kind::audio);
+    a1->append_child(new otio::Clip("D", nullptr, frames(0, 48)));
+
+    timeline->tracks()->append_child(v1);
+    timeline->tracks()->append_child(v2);
+    timeline->tracks()->append_child(a1);
+    return timeline;
+}
+
+std::vector<std::string>
+names_in(otio::Composition const* composition)
+{
+    std::vector<std::string> names;
+    for (auto const& child: composition->children())
+    {
+        names.push_back(child->name());
+    }
+    return names;
+}
+
+otio::Track*
+track_at(otio::Timeline const* timeline, size_t index)
+{
+    return dynamic_cast<otio::Track*>(
+        timeline->tracks()->children()[index].value);
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Tests tests;
+
+    tests.add_test("test_keep_only_tracks", [] {
+        auto timeline = make_timeline();
+        otio::keep_only_audio_tracks(timeline);
+        assertEqual(
+            names_in(timeline->tracks()),
+            (std::vector<std::string>{ "A1" }));
+
+        timeline = make_timeline();
+        otio::keep_only_video_tracks(timeline);
+        assertEqual(
+            names_in(timeline->tracks()),
+            (std::vector<std::string>{ "V1", "V2" }));
+    });
+
+    tests.add_test("test_filter_transitions", [] {
+        auto              timeline = make_timeline();
+        otio::ErrorStatus err;
+        otio::SerializableObject::Retainer<otio::Timeline> filtered(
+            otio::filter_transitions(timeline, &err));
+        assertFalse(otio::is_error(err));
+        assertEqual(
+            names_in(track_at(filtered, 0)),
+            (std::vector<std::string>{ "A", "B", "" }));
+
+        // the input is unchanged
+        assertEqual(track_at(timeline, 0)->children().size(), size_t(4));
+    });
+
+    tests.add_test("test_filter_tracks", [] {
+        auto timeline = make_timeline();
+        otio::SerializableObject::Retainer<otio::Timeline> filtered(
+            otio::filter_tracks(timeline, {}, { 1, 3 }));
+        assertEqual(
+            names_in(filtered->tracks()),
+            (std::vector<std::string>{ "V1", "A1" }));
+
+        filtered = otio::filter_tracks(timeline, { "V2", "A1" }, { 1, 2 });
+        assertEqual(
+            names_in(filtered->tracks()),
+            (std::vector<std::string>{ "V2" }));
+    });
+
+    tests.add_test("test_filter_clips", [] {
+        auto timeline = make_timeline();
+        otio::SerializableObject::Retainer<otio::Timeline> filtered(
+            otio::filter_clips(timeline, { "C" }, { std::regex("^[AD]") }));
+        assertEqual(
+            names_in(track_at(filtered, 0)),
+            (std::vector<std::string>{ "A", "dissolve", "" }));
+        assertEqual(
+            names_in(track_at(filtered, 1)),
+            (std::vector<std::string>{ "C" }));
+        assertEqual(
+            names_in(track_at(filtered, 2)),
+            (std::vector<std::string>{ "D" }));
+    });
+
+    tests.add_test("test_trim_timeline", [] {
+        auto              timeline = make_timeline();
+        otio::ErrorStatus err;
+        assertEqual(otio::trim_rate(timeline, &err), 24.0);
+        assertTrue(otio::trim_timeline(timeline, frames(12, 24), &err));
+        assertFalse(otio::is_error(err));
+        assertEqual(timeline->tracks()->children().size(), size_t(3));
+        assertEqual(
+            track_at(timeline, 1)->trimmed_range().duration(),
+            otime::RationalTime(24, 24));
+    });
+
+    tests.add_test("test_flatten_timeline", [] {
+        auto              timeline = make_timeline();
+        otio::ErrorStatus err;
+        assertTrue(otio::flatten_timeline(
+            timeline,
+            otio::FlattenTracks::video,
+            false,
+            &err));
+        assertFalse(otio::is_error(err));
+
+        // the other tracks come first, then the flat track
+        assertEqual(timeline->tracks()->children().size(), size_t(2));
+        assertEqual(track_at(timeline, 0)->name(), std::string("A1"));
+        assertEqual(
+            track_at(timeline, 1)->kind(),
+            std::string(otio::Track::Kind::video));
+
+        timeline = make_timeline();
+        assertTrue(otio::flatten_timeline(
+            timeline,
+            otio::FlattenTracks::audio,
+            true,
+            &err));
+        assertEqual(timeline->tracks()->children().size(), size_t(4));
+        assertEqual(
+            track_at(timeline, 3)->kind(),
+            std::string(otio::Track::Kind::audio));
+    });
+
+    tests.add_test("test_remove_metadata_key", [] {
+        auto timeline = make_timeline();
+        otio::remove_metadata_key(timeline, "key");
+        assertFalse(timeline->metadata().has_key("key"));
+
+        auto clip = dynamic_cast<otio::Clip*>(
+            track_at(timeline, 0)->children()[0].value);
+        assertFalse(clip->metadata().has_key("key"));
+        assertTrue(clip->metadata().has_key("other"));
+        assertFalse(clip->markers()[0]->metadata().has_key("key"));
+    });
+
+    tests.add_test("test_redact_timeline", [] {
+        auto                    timeline = make_timeline();
+        otio::RedactionCounters counters;
+        otio::redact_timeline(timeline, counters);
+
+        assertEqual(timeline->name(), std::string("Timeline #1"));
+        assertEqual(timeline->tracks()->name(), std::string("Stack #1"));
+        assertEqual(
+            names_in(timeline->tracks()),
+            (std::vector<std::string>{ "Track #1", "Track #2", "Track #3" }));
+        assertEqual(
+            names_in(track_at(timeline, 0)),
+            (std::vector<std::string>{
+                "Clip #1", "Transition #1", "Clip #2", "Gap #1" }));
+
+        auto clip = dynamic_cast<otio::Clip*>(
+            track_at(timeline, 0)->children()[0].value);
+        assertEqual(clip->metadata().size(), size_t(0));
+        assertEqual(clip->markers()[0]->name(), std::string("Marker #1"));
+        auto reference =
+            dynamic_cast<otio::ExternalReference*>(clip->media_reference());
+        assertEqual(reference->name(), std::string("ExternalReference #1"));
+        assertEqual(reference->target_url(), std::string("URL #1"));
+
+        // counters carry on across timelines
+        auto other = make_timeline();
+        otio::redact_timeline(other, counters);
+        assertEqual(other->name(), std::string("Timeline #2"));
+    });
+
+    tests.add_test("test_timeline_stats", [] {
+        auto              timeline = make_timeline();
+        otio::ErrorStatus err;
+        std::string       stats = otio::timeline_stats(timeline, &err);
+        assertFalse(otio::is_error(err));
+        assertEqual(
+            stats,
+            std::string("Name: timeline\n"
+                        "Start:    00:00:00:00\n"
+                        "End:      00:00:03:00\n"
+                        "Duration: 00:00:03:00"));
+    });
+
+    tests.run(argc, argv);
+    return 0;
+}
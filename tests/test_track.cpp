@@ -6,6 +6,8 @@
 #include <opentimelineio/clip.h>
 #include <opentimelineio/stack.h>
 #include <opentimelineio/track.h>
+#include <opentimelineio/trackAlgorithm.h>
+#include <opentimelineio/transition.h>
 
 #include <iostream>
 
@@ -166,6 +168,85 @@ main(int argc, char** argv)
             std::find(items.begin(), items.end(), clip.value) != items.end());
     });
 
+    tests.add_test(
+        "test_clone_without_children", [] {
+        using namespace otio;
+        otio::SerializableObject::Retainer<otio::Track> track =
+            new otio::Track("track");
+        track->metadata()["key"] = std::string("value");
+        track->append_child(new otio::Clip("clip"));
+
+        otio::ErrorStatus err;
+        otio::SerializableObject::Retainer<otio::Composition> clone =
+            track->clone_without_children(&err);
+        assertFalse(is_error(err));
+        assertTrue(dynamic_cast<otio::Track*>(clone.value) != nullptr);
+        assertEqual(clone->name(), std::string("track"));
+        assertEqual(clone->children().size(), 0);
+        assertEqual(
+            std::any_cast<std::string>(clone->metadata()["key"]),
+            std::string("value"));
+        assertEqual(track->children().size(), 1);
+    });
+    tests.add_test(
+        "test_track_trimmed_to_range", [] {
+        using namespace otio;
+        otio::SerializableObject::Retainer<otio::Track> track =
+            new otio::Track();
+        for (int i = 0; i < 10; ++i)
+        {
+            track->append_child(new otio::Clip(
+                "clip" + std::to_string(i),
+                nullptr,
+                TimeRange(RationalTime(0, 24), RationalTime(10, 24))));
+        }
+
+        // cuts clip2 and clip5, keeps clip3 and clip4 whole
+        const TimeRange trim_range(RationalTime(25, 24), RationalTime(30, 24));
+
+        otio::ErrorStatus err;
+        auto view = track_trimmed_view(track, trim_range, &err);
+        assertFalse(is_error(err));
+        assertEqual(view.children.size(), 4);
+        assertEqual(view.children[0].index, 2);
+        assertEqual(view.children[3].index, 5);
+        assertTrue(bool(view.children[0].trimmed_source_range));
+        assertFalse(bool(view.children[1].trimmed_source_range));
+        assertFalse(bool(view.children[2].trimmed_source_range));
+        assertTrue(bool(view.children[3].trimmed_source_range));
+        assertEqual(
+            *view.children[0].trimmed_source_range,
+            TimeRange(RationalTime(5, 24), RationalTime(5, 24)));
+        assertEqual(
+            *view.children[3].trimmed_source_range,
+            TimeRange(RationalTime(0, 24), RationalTime(5, 24)));
+
+        otio::SerializableObject::Retainer<otio::Track> trimmed =
+            track_trimmed_to_range(track, trim_range, &err);
+        assertFalse(is_error(err));
+        assertEqual(trimmed->children().size(), 4);
+        assertEqual(trimmed->children()[0]->name(), std::string("clip2"));
+        assertEqual(trimmed->children()[3]->name(), std::string("clip5"));
+        assertEqual(trimmed->duration().value(), 30);
+        assertEqual(track->children().size(), 10);
+
+        // trimming through the middle of a transition is an error
+        track->insert_child(
+            3,
+            new otio::Transition(
+                "transition",
+                Transition::Type::SMPTE_Dissolve,
+                RationalTime(2, 24),
+                RationalTime(2, 24)));
+        view = track_trimmed_view(
+            track,
+            TimeRange(RationalTime(29, 24), RationalTime(10, 24)),
+            &err);
+        assertTrue(is_error(err));
+        assertEqual(err.outcome, otio::ErrorStatus::CANNOT_TRIM_TRANSITION);
+        assertEqual(view.children.size(), 0);
+    });
+
     tests.run(argc, argv);
     return 0;
 }